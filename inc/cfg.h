@@ -4,8 +4,34 @@
 #include <vector>
 #include <unordered_map>
 
+//On/off settings. Key, name in JKSV.cfg and default. The enum, load, save and reset are all built from this
+#define CFG_BOOL_LIST(X) \
+    X(INC_DEV, "includeDeviceSaves", false) \
+    X(AUTO_BACK, "autoBackup", true) \
+    X(AUTO_NAME, "autoName", false) \
+    X(OVR_CLK, "overclock", false) \
+    X(HOLD_DEL, "holdToDelete", true) \
+    X(HOLD_REST, "holdToRestore", true) \
+    X(HOLD_OVER, "holdToOverwrite", true) \
+    X(FORCE_MOUNT, "forceMount", true) \
+    X(ACC_SYS_SAVE, "accountSystemSaves", false) \
+    X(SYS_SAVE_WRITE, "allowSystemSaveWrite", false) \
+    X(DIRECT_FS_CMD, "directFSCommands", false) \
+    X(ZIP, "exportToZIP", false) \
+    X(LANG_OVERRIDE, "languageOverride", false) \
+    X(TRASH_BIN, "enableTrashBin", true) \
+    X(AUTO_UPLOAD, "autoUpload", false)
+
 namespace cfg
 {
+#define CFG_BOOL_ENUM(key, name, def) key,
+    typedef enum
+    {
+        CFG_BOOL_LIST(CFG_BOOL_ENUM)
+        CONFIG_COUNT
+    } configKey;
+#undef CFG_BOOL_ENUM
+
     typedef enum
     {
         ALPHA,
@@ -30,10 +56,17 @@ namespace cfg
 
     void addPathToFilter(const uint64_t& tid, const std::string& _p);
 
-    extern std::unordered_map<std::string, bool> config;
+    extern bool config[CONFIG_COUNT];
     extern std::vector<uint64_t> blacklist;
     extern std::vector<uint64_t> favorites;
     extern uint8_t sortType;
     extern std::string driveClientID, driveClientSecret, driveRefreshToken;
+    //From the client secret JSON. Empty uses Google's
+    extern std::string driveTokenURI, driveAPIOrigin;
     extern std::string webdavOrigin, webdavBasePath, webdavUser, webdavPassword;
+    extern std::string s3Endpoint, s3Region, s3Bucket, s3AccessKey, s3SecretKey, s3BasePath;
+    extern uint64_t s3PartSize;
+    extern unsigned s3Concurrency;
+    extern bool s3PathStyle;
+    extern std::string localRemotePath;
 }
@@ -1,35 +1,177 @@
 #pragma once
 
+#include <switch.h>
+#include <stdio.h>
+#include <curl/curl.h>
+#include <zlib.h>
+#include <minizip/zip.h>
 #include <string>
 #include <vector>
 
 #define HEADER_ERROR "ERROR"
+#define STREAM_INFLATE_CHUNK 0x8000
 
 namespace curlFuncs
 {
+    class streamStage;
+
     typedef struct
     {
         FILE *f;
         uint64_t *o;
+        //Transfer is aborted once this is set
+        bool *cancel = NULL;
+        //Optional. Sees everything read, in order. The caller finishes it
+        streamStage *tap = NULL;
     } curlUpArgs;
 
     typedef struct
     {
         std::string path;
-        unsigned int size;
+        //0 if unknown
+        uint64_t size = 0;
         uint64_t *o;
+        bool *cancel = NULL;
+        //Optional. Sees everything downloaded, in order, before it's written. The caller finishes it
+        streamStage *tap = NULL;
     } curlDlArgs;
 
+    //Legacy callbacks. They run through the stages below
     size_t writeDataString(const char *buff, size_t sz, size_t cnt, void *u);
     size_t writeHeaders(const char *buff, size_t sz, size_t cnt, void *u);
     size_t readDataFile(char *buff, size_t sz, size_t cnt, void *u);
-    size_t readDataBuffer(char *buff, size_t sz, size_t cnt, void *u);
-    size_t writeDataFile(const char *buff, size_t sz, size_t cnt, void *u);
-    size_t writeDataBuffer(const char *buff, size_t sz, size_t cnt, void *u);
+
+    //Streams. Stages are chained by passing the next one to the constructor, the last one has none.
+    //Data goes through the whole chain as it arrives so nothing is held in memory or read twice.
+    //e.g. progressStage -> sha256Stage -> inflateStage -> fileSink
+    class streamStage
+    {
+        public:
+            streamStage(streamStage *_next) : next(_next) {}
+            virtual ~streamStage() {}
+
+            //Returns false to abort the transfer
+            virtual bool write(const uint8_t *_data, size_t _size) { return next ? next->write(_data, _size) : true; }
+            //Called once after the last write. Flushes anything held back
+            virtual bool finish() { return next ? next->finish() : true; }
+
+        protected:
+            streamStage *next;
+    };
+
+    class fileSink : public streamStage
+    {
+        public:
+            //Opens _path for writing
+            fileSink(const std::string& _path);
+            ~fileSink();
+            bool isOpen() const { return f != NULL; }
+            bool write(const uint8_t *_data, size_t _size);
+            bool finish();
+
+        private:
+            FILE *f = NULL;
+    };
+
+    class memorySink : public streamStage
+    {
+        public:
+            memorySink(std::vector<uint8_t> *_out) : streamStage(NULL), out(_out) {}
+            bool write(const uint8_t *_data, size_t _size);
+
+        private:
+            std::vector<uint8_t> *out;
+    };
+
+    class stringSink : public streamStage
+    {
+        public:
+            stringSink(std::string *_out) : streamStage(NULL), out(_out) {}
+            bool write(const uint8_t *_data, size_t _size);
+
+        private:
+            std::string *out;
+    };
+
+    //Writes into the entry currently open in _z. The caller opens and closes the entry
+    class zipEntrySink : public streamStage
+    {
+        public:
+            zipEntrySink(zipFile _z) : streamStage(NULL), z(_z) {}
+            bool write(const uint8_t *_data, size_t _size);
+
+        private:
+            zipFile z;
+    };
+
+    class sha256Stage : public streamStage
+    {
+        public:
+            sha256Stage(streamStage *_next);
+            bool write(const uint8_t *_data, size_t _size);
+            //Only valid after finish()
+            bool finish();
+            const uint8_t *getHash() const { return hash; }
+            bool hashMatches(const std::string& _hex) const;
+
+        private:
+            Sha256Context ctx;
+            uint8_t hash[SHA256_HASH_SIZE];
+    };
+
+    //Handles both zlib and gzip data
+    class inflateStage : public streamStage
+    {
+        public:
+            inflateStage(streamStage *_next);
+            ~inflateStage();
+            bool write(const uint8_t *_data, size_t _size);
+            bool finish();
+
+        private:
+            z_stream strm;
+            bool ended = false;
+            std::vector<uint8_t> outBuff;
+    };
+
+    //Counts bytes into *_o, same as curlUpArgs/curlDlArgs so the progress bars can use it
+    class progressStage : public streamStage
+    {
+        public:
+            progressStage(uint64_t *_o, streamStage *_next) : streamStage(_next), o(_o) {}
+            bool write(const uint8_t *_data, size_t _size);
+
+        private:
+            uint64_t *o;
+    };
+
+    //Reading side for uploads. Everything read is also passed through tap if there is one
+    class fileSource
+    {
+        public:
+            fileSource(FILE *_f, streamStage *_tap) : f(_f), tap(_tap) {}
+            //Returns 0 at the end, -1 on error
+            ssize_t read(uint8_t *_buff, size_t _size);
+
+        private:
+            FILE *f;
+            streamStage *tap;
+    };
+
+    //curl callbacks. WRITEDATA is a streamStage *, READDATA a fileSource *
+    size_t writeStream(const char *buff, size_t sz, size_t cnt, void *u);
+    size_t readStream(char *buff, size_t sz, size_t cnt, void *u);
+
+    //All requests go through here so they can be counted. Same as curl_easy_perform otherwise
+    CURLcode perform(CURL *handle);
+    //Requests made since start, across every backend and thread
+    uint64_t getRequestCount();
 
     std::string getHeader(const std::string& _name, std::vector<std::string> *h);
 
     //Shortcuts/legacy
     std::string getJSONURL(std::vector<std::string> *headers, const std::string& url);
     bool getBinURL(std::vector<uint8_t> *out, const std::string& url);
+    //GETs url through _out. finish() is only called on success
+    bool getStreamURL(streamStage *_out, const std::string& url);
 }
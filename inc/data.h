@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 #include "gfx.h"
 
@@ -11,6 +12,9 @@
 #define BLD_DAY 10
 #define BLD_YEAR 2023
 
+//Title icons are decoded to this size for the title tiles
+#define TITLE_ICON_SIZE 128
+
 namespace data
 {
     //Loads user + title info
@@ -22,24 +26,64 @@ namespace data
     //Draws some stats to the upper left corner
     void dispStats();
 
+    //The parts of NacpStruct JKSV uses. Same names so they read the same. The full one is 0x4000 bytes per title
+    typedef struct
+    {
+        uint64_t save_data_owner_id;
+        int64_t user_account_save_data_size, user_account_save_data_journal_size, user_account_save_data_journal_size_max;
+        int64_t device_save_data_size, device_save_data_journal_size, device_save_data_journal_size_max;
+        int64_t bcat_delivery_cache_storage_size;
+        int64_t cache_storage_size, cache_storage_journal_size, cache_storage_data_and_journal_size_max;
+    } titleNacp;
+
     //Global stuff for all titles/saves
     typedef struct
     {
-        NacpStruct nacp;
+        titleNacp nacp;
         std::string title, safeTitle, author;//Shortcuts sorta.
+        //Title folded for sorting: lowercase, fullwidth as ASCII, katakana as hiragana. Compares bytewise
+        std::string sortKey;
         SDL_Texture *icon = NULL;
-        bool fav;
+        bool fav = false;
     } titleInfo;
 
+    //Same goes for PdmPlayStatistics
+    typedef struct
+    {
+        uint64_t playtime;
+        uint32_t last_timestamp_user, total_launches;
+    } titlePlayStats;
+
     //Holds stuff specific to user's titles/saves
     typedef struct
     {
         //Makes it easier to grab id
         uint64_t tid;
+        //Entry in titles. Those never move or go away so sorting can skip the lookups
+        const titleInfo *title;
         FsSaveDataInfo saveInfo;
-        PdmPlayStatistics playStats;
+        titlePlayStats playStats;
     } userTitleInfo;
 
+    //One tile added to or removed from a user's list. Replaying them in order keeps a view in step
+    typedef struct
+    {
+        unsigned user, pos;
+        uint64_t tid;
+        bool added;
+    } titleListChange;
+
+    //Changes to users' title lists without reloading everything. Sort order is kept
+    //Finds the save matching _attr and adds it. Returns false if that needs a full loadUsersTitles, ie. a new user
+    bool addUserSave(const FsSaveDataAttribute& _attr, std::vector<titleListChange>& _changes);
+    void removeUserSave(uint64_t _saveID, std::vector<titleListChange>& _changes);
+    void removeUserTitle(const uint64_t& tid, std::vector<titleListChange>& _changes);
+    //Moves tid's entries to where they belong now. For favorites
+    void resortTitle(const uint64_t& tid, std::vector<titleListChange>& _changes);
+
+    //Copies what's kept out of a full nacp
+    void setTitleNacp(titleNacp& _out, const NacpStruct& _nacp);
+
     //Class to store user info + titles
     class user
     {
@@ -65,7 +109,8 @@ namespace data
             SDL_Texture *getUserIcon(){ return userIcon; }
             void delIcon(){ SDL_DestroyTexture(userIcon); }
 
-            std::vector<data::userTitleInfo> titleInfo;
+            //Device saves are shared with every account when incDev is on instead of copied
+            std::vector<std::shared_ptr<data::userTitleInfo>> titleInfo;
             void addUserTitleInfo(const uint64_t& _tid, const FsSaveDataInfo *_saveInfo, const PdmPlayStatistics *_stats);
 
         private:
@@ -9,6 +9,7 @@
 #include "fs/zip.h"
 #include "fs/fsfile.h"
 #include "fs/remote.h"
+#include "fs/transfer.h"
 #include "ui/miscui.h"
 
 #define BUFF_SIZE 0x4000
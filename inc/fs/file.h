@@ -20,6 +20,8 @@ namespace fs
     void copyFileCommit(const std::string& src, const std::string& dst, const std::string& dev, threadInfo *t);
     void copyFileCommitThreaded(const std::string& src, const std::string& dst, const std::string& dev);
     void fileDrawFunc(void *a);
+    //Same as above plus the transfer queue for backups that are uploaded as they go
+    void backupDrawFunc(void *a);
 
     //deletes file
     void delfile(const std::string& _p);
@@ -51,6 +53,7 @@ namespace fs
             //Reads until ';', ',', or '\n' is hit and returns as string.
             std::string getNextValueStr();
             int getNextValueInt();
+            bool hasNextValue() const { return lPos < line.size() && line.find_first_not_of(", ", lPos) != line.npos; }
 
         private:
             FILE *f;
@@ -59,6 +62,35 @@ namespace fs
             bool opened = false;
     };
 
+    //Reads the same files as dataFile. The parsed lines are kept in a binary copy under config and loaded from that
+    //instead of parsing it until the text file changes. _cache = false only parses the text
+    class dataBlob
+    {
+        public:
+            dataBlob(const std::string& _path, bool _cache = true);
+
+            bool isOpen() const { return opened; }
+
+            bool readNextLine();
+            std::string getName() const { return lines[cur - 1].name; }
+            std::string getNextValueStr();
+            int getNextValueInt();
+
+        private:
+            typedef struct
+            {
+                std::string name;
+                std::vector<std::string> values;
+            } dataLine;
+
+            bool readBlob(const std::string& _blobPath, uint64_t _srcSize, uint64_t _srcStamp);
+            void writeBlob(const std::string& _blobPath, uint64_t _srcSize, uint64_t _srcStamp);
+
+            std::vector<dataLine> lines;
+            size_t cur = 0, val = 0;
+            bool opened = false;
+    };
+
     void logOpen();
     void logWrite(const char *fmt, ...);
     void logClose();
@@ -8,14 +8,28 @@ namespace fs
 {
     extern rfs::IRemoteFS *rfs;
     extern std::string rfsRootID;
+    // Backend and where its root is, e.g. "webdav:<origin>/<root>". Saved with queued transfers so they only resume on the same remote
+    extern std::string rfsIdentity;
 
     void remoteInit();
     void remoteExit();
 
+    //Remote copy of the local _TRASH_ folder for _title. Empty on failure
+    std::string remoteGetTrashDir(const std::string& _title);
+
     // Google Drive
     void driveInit();
     std::string driveSignInGetAuthCode();
 
     // Webdav
     void webDavInit();
+
+    // S3
+    void s3Init();
+
+    // Local path
+    void localInit();
+
+    // Runs list/upload/download/delete workloads against rfs and logs the results
+    void remoteBenchmark_t(void *a);
 }
\ No newline at end of file
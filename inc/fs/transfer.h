@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+
+//Transfers run in the background and survive restarts. Unfinished jobs are kept here and restarted on the next launch
+//if the same remote is active
+#define TRANSFER_QUEUE_PATH "sdmc:/config/JKSV/transfers.json"
+//How many transfers run at once
+#define TRANSFER_WORKER_COUNT 2
+//Failed jobs are retried this many times before they're dropped
+#define TRANSFER_MAX_ATTEMPTS 3
+#define TRANSFER_RETRY_DELAY 2e+9
+//Downloads go here next to the target until they finish
+#define TRANSFER_TEMP_EXT ".part"
+//Batch backups stop and wait for uploads once this much is waiting to be sent
+#define TRANSFER_BACKLOG_LIMIT 0x20000000
+//Zips made only for uploading are made here in the working directory, away from the title folders
+#define TRANSFER_SCRATCH_DIR "_UPLOAD_/"
+
+namespace fs
+{
+    typedef enum
+    {
+        TRANSFER_UPLOAD,
+        TRANSFER_DOWNLOAD
+    } transferType;
+
+    //Lower runs first. Downloads are usually restores someone is waiting on
+    typedef enum
+    {
+        TRANSFER_PRIORITY_DOWNLOAD,
+        TRANSFER_PRIORITY_UPLOAD,
+        TRANSFER_PRIORITY_BULK
+    } transferPriority;
+
+    typedef struct
+    {
+        unsigned id;
+        transferType type;
+        transferPriority priority;
+        //Path on SD, the title folder name on the remote and the file name there
+        std::string local, title, name;
+        //fs::rfsIdentity when the job was added
+        std::string remote;
+        //Local file is removed once the job is over, sent or not. Used for zips made only for uploading
+        bool deleteLocal = false;
+        uint64_t size = 0, offset = 0;
+        unsigned attempts = 0;
+        bool running = false, cancel = false;
+        //Stopped by a pause. Goes back in the queue without using up an attempt
+        bool paused = false;
+        //Cancelled for good. Removed instead of going back in the queue
+        bool dropped = false;
+    } transferJob;
+
+    //Loads the saved queue and starts the workers. Needs rfs
+    void transferInit();
+    //Stops running transfers and saves what's left
+    void transferExit();
+
+    //Returns the job's id
+    unsigned transferAdd(transferType _type, transferPriority _priority, const std::string& _local, const std::string& _title, const std::string& _name, uint64_t _size, bool _deleteLocal);
+
+    //Drops every job. Running ones are stopped. Zips made only for uploading go with them
+    void transferCancelAll();
+
+    //Pausing also stops transfers that are running. They go back in the queue and restart from the beginning on resume
+    void transferSetPaused(bool _paused);
+    bool transferIsPaused();
+
+    //Blocks while more than _maxBytes of _priority jobs are left or transfers are paused. Returns right away if
+    //nothing is working on them. Returns false if *_cancel was set or transfers are shutting down
+    bool transferWaitBacklog(transferPriority _priority, uint64_t _maxBytes, const bool *_cancel);
+
+    //Where to make a zip that's only for uploading. Batch dumps give every title the same name, so the title ID is in it
+    std::string transferGetScratchPath(uint64_t _tid, const std::string& _name);
+
+    //Jobs queued or running and the combined progress of all of them
+    unsigned transferGetCount();
+    void transferGetProgress(uint64_t& _done, uint64_t& _total);
+}
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include "curlfuncs.h"
 #include "rfs.h"
@@ -13,8 +14,15 @@
 #define HEADER_CONTENT_TYPE_APP_JSON "Content-Type: application/json; charset=UTF-8"
 #define HEADER_AUTHORIZATION "Authorization: Bearer "
 
+//Defaults. Both can be pointed elsewhere, ie. tools/mockremote.py
+#define DRIVE_TOKEN_URL "https://oauth2.googleapis.com/token"
+#define DRIVE_API_ORIGIN "https://www.googleapis.com"
+
 #define MIMETYPE_FOLDER "application/vnd.google-apps.folder"
 
+//Drive won't take more than this many calls in one batch request
+#define DRIVE_BATCH_MAX 100
+
 namespace drive
 {
     class gd : public rfs::IRemoteFS
@@ -23,13 +31,17 @@ namespace drive
             void setClientID(const std::string& _clientID) { clientID = _clientID; }
             void setClientSecret(const std::string& _clientSecret) { secretID = _clientSecret; }
             void setRefreshToken(const std::string& _refreshToken) { rToken = _refreshToken; }
+            //tokeninfo is expected next to the token endpoint
+            void setTokenURL(const std::string& _tokenURL);
+            //Scheme and host the files, upload and batch endpoints hang off of
+            void setAPIOrigin(const std::string& _origin);
 
             bool exhangeAuthCode(const std::string& _authCode);
             bool hasToken() { return token.empty() == false; }
             bool refreshToken();
             bool tokenIsValid();
             
-            void clearDriveList() { driveList.clear(); }
+            void clearDriveList() { std::lock_guard<std::mutex> lock(listLock); driveList.clear(); }
             // TODO: This also gets files that do not belong to JKSV
             void driveListInit(const std::string& _q);
             void driveListAppend(const std::string& _q);
@@ -46,6 +58,14 @@ namespace drive
             void updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *_upload);
             void downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *_download);
             void deleteFile(const std::string& _fileID);
+            bool copyFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent);
+            bool moveFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent);
+
+            //Metadata requests queued here are sent as multipart batches by batchExecute
+            void batchDeleteFile(const std::string& _fileID);
+            bool batchExecute();
+
+            void deleteFiles(const std::vector<std::string>& _fileIDs);
 
             std::string getClientID() const { return clientID; }
             std::string getClientSecret() const { return secretID; }
@@ -60,7 +80,31 @@ namespace drive
             rfs::RfsItem *getItemAt(unsigned int _ind) { return &driveList[_ind]; }
 
         private:
+            typedef enum
+            {
+                BATCH_DELETE
+            } batchType;
+
+            typedef struct
+            {
+                batchType type;
+                std::string id;
+            } batchItem;
+
+            bool batchSend(const std::vector<batchItem>& _items);
+            //Refreshes the token if it's expired
+            void checkToken();
+
+            //Transfers run on their own threads while the UI reads the list
+            std::mutex listLock, tokenLock;
             std::vector<rfs::RfsItem> driveList;
+            //deleteFiles can be called from more than one thread
+            std::mutex batchLock;
+            std::vector<batchItem> batchQueue;
             std::string clientID, secretID, token, rToken;
+            std::string tokenURL = DRIVE_TOKEN_URL, tokenCheckURL = "https://oauth2.googleapis.com/tokeninfo";
+            std::string driveURL = DRIVE_API_ORIGIN "/drive/v3/files";
+            std::string driveUploadURL = DRIVE_API_ORIGIN "/upload/drive/v3/files";
+            std::string driveBatchURL = DRIVE_API_ORIGIN "/batch/drive/v3";
     };
 }
\ No newline at end of file
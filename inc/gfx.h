@@ -12,6 +12,16 @@ namespace gfx
     void exit();
     void present();
 
+    //Between frameBegin and frameEnd, drawing to NULL goes to a frame texture so it can be shown again without redrawing
+    void frameBegin();
+    void frameEnd();
+    //Copies the last composed frame to the screen
+    void frameDraw();
+    //NULL is the screen, or the frame while one is being composed
+    void setTarget(SDL_Texture *target);
+    //Everything drawn is clipped to clip until it's set back to NULL. In whatever target is drawn to's coordinates
+    void setClip(const SDL_Rect *clip);
+
     void drawTextf(SDL_Texture *target, int fontSize, int x, int y, const SDL_Color *c, const char *fmt, ...);
     void drawTextfWrap(SDL_Texture *target, int fontSize, int x, int y, int maxWidth, const SDL_Color* c, const char *fmt, ...);
     size_t getTextWidth(const char *str, int fontSize);
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <vector>
+#include <list>
+#include <unordered_map>
 #include <SDL2/SDL.h>
 
 /*Texture manager class
 Keeps pointers to ALL textures so it is not possible to forget to free them. Also keeps code a little easier to read. A little.*/
 
+//Memory textures can use before ones that can be made again are freed. Applets get a lot less heap
+#define TEXTURE_BUDGET 0x4000000
+#define TEXTURE_BUDGET_APPLET 0x2000000
+
 typedef enum
 {
     IMG_FMT_PNG,
@@ -15,6 +20,9 @@ typedef enum
 
 namespace gfx
 {
+    //Called with the key a texture was given when it's freed to stay under budget
+    typedef void (*textureEvictFunc)(uint64_t _key);
+
     class textureMgr
     {
         public:
@@ -25,9 +33,45 @@ namespace gfx
             SDL_Texture *textureCreate(int _w, int _h);
             SDL_Texture *textureLoadFromFile(const char *_path);
             SDL_Texture *textureLoadFromMem(imgTypes _type, const void *_dat, size_t _datSize);
+            //_pixels are RGBA8888, _w * _h of them
+            SDL_Texture *textureLoadFromPixels(const void *_pixels, int _w, int _h);
             void textureResize(SDL_Texture **_tex, int _w, int _h);
-        
+            void textureDestroy(SDL_Texture *_tex);
+
+            //Lets _tex be freed once it's gone unused long enough and memory is needed. _func is told so the owner can make it again
+            void textureSetEvictable(SDL_Texture *_tex, uint64_t _key, textureEvictFunc _func);
+            //Marks an evictable texture as used. Anything drawn every frame should be
+            void textureTouch(SDL_Texture *_tex);
+            //Once a frame. Textures used this frame or the last are never evicted
+            void nextFrame() { ++frame; }
+
+            void setBudget(size_t _budget) { budget = _budget; }
+            size_t getUsed() { return used; }
+            size_t getBudget() { return budget; }
+            size_t getCount() { return textures.size(); }
+            unsigned getEvictCount() { return evictCount; }
+
         private:
-            std::vector<SDL_Texture *> textures;
+            typedef struct
+            {
+                size_t size;
+                bool evictable;
+                uint64_t key, lastUse;
+                textureEvictFunc evictFunc;
+                //Position in lru if evictable
+                std::list<SDL_Texture *>::iterator lruPos;
+            } textureEntry;
+
+            void track(SDL_Texture *_tex);
+            void untrack(SDL_Texture *_tex);
+            //Frees least recently used evictable textures until _need more fits
+            void makeRoom(size_t _need);
+
+            std::unordered_map<SDL_Texture *, textureEntry> textures;
+            //Most recently used first
+            std::list<SDL_Texture *> lru;
+            size_t used = 0, budget = TEXTURE_BUDGET;
+            uint64_t frame = 0;
+            unsigned evictCount = 0;
     };   
 }
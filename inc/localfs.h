@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "rfs.h"
+
+// Chunk size for file to file copies
+#define LOCAL_COPY_BUFFER_SIZE 0x100000
+// Copies and moves land under this name next to the target first, so the target is only replaced once the data is there
+#define LOCAL_TEMP_EXT ".part"
+
+namespace rfs {
+
+    // Note: Everything declared an "id" is a full path usable with stdio, e.g. usb:/JKSV/<title>/<file>
+    // Note: Directories ALWAYS have a trailing / while files NEVER have a trailing /
+    class LocalFS : public IRemoteFS {
+    private:
+        std::string appendResourceToParentId(const std::string& resourceName, const std::string& parentId, bool isDir);
+
+    public:
+        bool createDir(const std::string& dirName, const std::string& parentId);
+        bool dirExists(const std::string& dirName, const std::string& parentId);
+
+        bool fileExists(const std::string& filename, const std::string& parentId);
+        void uploadFile(const std::string& filename, const std::string& parentId, curlFuncs::curlUpArgs *_upload);
+        void updateFile(const std::string& fileID, curlFuncs::curlUpArgs *_upload);
+        void downloadFile(const std::string& fileID, curlFuncs::curlDlArgs *_download);
+        void deleteFile(const std::string& fileID);
+        bool copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
+        bool moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
+
+        std::string getFileID(const std::string& name, const std::string& parentId);
+        std::string getDirID(const std::string& dirName, const std::string& parentId);
+
+        std::vector<RfsItem> getListWithParent(const std::string& _parent);
+    };
+}
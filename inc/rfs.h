@@ -3,9 +3,12 @@
 #include <string>
 #include "curlfuncs.h"
 #include <mutex>
+#include <condition_variable>
+#include <switch.h>
 
 #define UPLOAD_BUFFER_SIZE 0x8000
-#define DOWNLOAD_BUFFER_SIZE 0xC00000
+//Each download holds two of these, one filling while the other is written
+#define DOWNLOAD_BUFFER_SIZE 0x400000
 #define USER_AGENT "JKSV"
 
 namespace rfs {
@@ -14,7 +17,7 @@ namespace rfs {
     {
         std::string name, id, parent;
         bool isDir = false;
-        unsigned int size;
+        uint64_t size = 0;
     } RfsItem;
 
     class IRemoteFS
@@ -30,24 +33,56 @@ namespace rfs {
         virtual void downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *_download) = 0;
         virtual void deleteFile(const std::string& _fileID) = 0;
 
+        // Server side copy/move. No file data is transferred.
+        virtual bool copyFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent) = 0;
+        virtual bool moveFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent) = 0;
+
+        // Bulk operations. These just loop by default, backends that can batch requests override them.
+        virtual void deleteFiles(const std::vector<std::string>& _fileIDs);
+
         virtual std::string getFileID(const std::string& _name, const std::string& _parent) = 0;
         virtual std::string getDirID(const std::string& _name, const std::string& _parent) = 0;
 
         virtual std::vector<RfsItem> getListWithParent(const std::string& _parent) = 0;
     };
 
-    // Shared multi-threading definitions
-    typedef struct
+    // Writes a download to _dl->path on its own thread while curl keeps receiving. Every download gets its own,
+    // so any number can run at once. _dl->size is not needed, responses of unknown length work the same.
+    // Usage: open(), pass writeCallback + this to curl, close()
+    // Last stage of a download. _dl->tap, if set, runs in front of it
+    class DownloadWriter : public curlFuncs::streamStage
     {
-        curlFuncs::curlDlArgs *cfa;
+    public:
+        DownloadWriter(curlFuncs::curlDlArgs *_dl);
+        ~DownloadWriter();
+
+        // Opens the file and starts the writer thread
+        bool open();
+        // Writes what's left and waits for the thread. Returns false if anything couldn't be written
+        bool close();
+
+        bool write(const uint8_t *_data, size_t _size);
+
+        uint64_t getDownloaded() const { return downloaded; }
+
+        // CURLOPT_WRITEFUNCTION, CURLOPT_WRITEDATA is the writer
+        static size_t writeCallback(const char *buff, size_t sz, size_t cnt, void *u);
+
+    private:
+        curlFuncs::curlDlArgs *dl;
+        FILE *out = NULL;
+        Thread writeThread;
+        bool threadRunning = false;
+
         std::mutex dataLock;
         std::condition_variable cond;
-        std::vector<uint8_t> sharedBuffer;
-        bool bufferFull = false;
-        unsigned int downloaded = 0;
-    } dlWriteThreadStruct;
-
-    extern std::vector<uint8_t> downloadBuffer;
-    void writeThread_t(void *a);
-    size_t writeDataBufferThreaded(uint8_t *buff, size_t sz, size_t cnt, void *u);
+        // curl appends to fillBuffer. Once full it's swapped with writeBuffer so neither is ever reallocated
+        std::vector<uint8_t> fillBuffer, writeBuffer;
+        bool writePending = false, finished = false, writeFailed = false;
+        uint64_t downloaded = 0;
+
+        // Hands fillBuffer to the writer thread. Blocks while it's still busy with the last one
+        bool submit();
+        static void writeThread_t(void *a);
+    };
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "rfs.h"
+
+//Defaults when s3.json doesn't set them. S3 won't take parts smaller than 5MB except the last, or bigger than 5GB
+#define S3_DEFAULT_PART_SIZE 0x800000
+#define S3_MIN_PART_SIZE 0x500000
+#define S3_MAX_PART_SIZE 0x140000000
+#define S3_DEFAULT_CONCURRENCY 3
+#define S3_MAX_CONCURRENCY 8
+
+namespace rfs {
+
+    typedef std::vector<std::pair<std::string, std::string>> S3Query;
+
+    // Note: ids are object keys relative to the bucket, never starting with a "/".
+    // Note: S3 has no real directories. Directories are key prefixes ending with "/" and are created as empty marker objects
+    // e.g. <basePath>/JKSV/
+    // e.g. <basePath>/JKSV/<title>/
+    // e.g. <basePath>/JKSV/<title>/<file>
+    class S3 : public IRemoteFS {
+    private:
+        std::string scheme;
+        std::string host;
+        std::string region;
+        std::string bucket;
+        std::string accessKey;
+        std::string secretKey;
+        bool pathStyle;
+        uint64_t partSize;
+        unsigned concurrency;
+
+        std::string appendResourceToParentId(const std::string& resourceName, const std::string& parentId, bool isDir);
+
+        // Creates a handle with url and SigV4 headers set. _headers must be freed by the caller.
+        CURL* createRequest(const char* method, const std::string& key, const S3Query& query, const std::vector<std::string>& amzHeaders, curl_slist** _headers);
+        bool performRequest(CURL* handle, const char* what, long* responseCode);
+        uint64_t getObjectSize(const std::string& key);
+
+        bool multipartUpload(const std::string& key, uint64_t size, curlFuncs::curlUpArgs *_upload);
+        bool rangedDownload(const std::string& key, uint64_t size, curlFuncs::curlDlArgs *_download);
+
+        // Worker threads for the above
+        static void uploadPart_t(void *a);
+        static void downloadRange_t(void *a);
+
+    public:
+        S3(const std::string& endpoint,
+           const std::string& region,
+           const std::string& bucket,
+           const std::string& accessKey,
+           const std::string& secretKey,
+           bool pathStyle,
+           uint64_t partSize,
+           unsigned concurrency);
+
+        bool createDir(const std::string& dirName, const std::string& parentId);
+        bool dirExists(const std::string& dirName, const std::string& parentId);
+
+        bool fileExists(const std::string& filename, const std::string& parentId);
+        void uploadFile(const std::string& filename, const std::string& parentId, curlFuncs::curlUpArgs *_upload);
+        void updateFile(const std::string& fileID, curlFuncs::curlUpArgs *_upload);
+        void downloadFile(const std::string& fileID, curlFuncs::curlDlArgs *_download);
+        void deleteFile(const std::string& fileID);
+        bool copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
+        bool moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
+
+        std::string getFileID(const std::string& name, const std::string& parentId);
+        std::string getDirID(const std::string& dirName, const std::string& parentId);
+
+        std::vector<RfsItem> getListWithParent(const std::string& _parent);
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <switch.h>
+#include <stdint.h>
+
+//Control data and tile sized icons are cached here so startup doesn't need ns and a JPEG decode for every title
+#define TITLE_CACHE_PATH "sdmc:/config/JKSV/titles.cache"
+#define TITLE_CACHE_TEMP "sdmc:/config/JKSV/titles.cache.tmp"
+//Nothing installed. Saves stay behind after a game is deleted
+#define TITLE_VERSION_NONE 0xFFFFFFFF
+//Icons handed to the renderer each frame. Keeps scrolling smooth while a lot of them finish at once
+#define TITLE_ICON_UPLOADS_PER_FRAME 8
+
+namespace data
+{
+    //Cache stays open from data::init to data::exit
+    void titleCacheOpen();
+    //Writes the index so the cache survives if JKSV doesn't exit cleanly
+    void titleCacheFlush();
+    //Drops titles that are gone and compacts if needed
+    void titleCacheClose();
+
+    //Highest version of anything installed for tid. Updates and DLC both change it
+    uint32_t getTitleVersion(const uint64_t& tid);
+
+    //Returns false if tid isn't cached at version. _hasCtrl is false for titles ns had nothing for
+    bool titleCacheGetCtrl(const uint64_t& tid, uint32_t version, NacpStruct *nacp, bool& _hasCtrl);
+    //nacp is NULL for titles ns had nothing for
+    void titleCacheStoreCtrl(const uint64_t& tid, uint32_t version, const NacpStruct *nacp);
+
+    //Icons are decoded on their own thread and start out NULL
+    void titleIconInit();
+    void titleIconExit();
+    //jpeg can be NULL and the icon comes from the cache or ns instead
+    void titleIconQueue(const uint64_t& tid, uint32_t version, const void *jpeg, size_t jpegSize);
+    //For titles without an icon at all
+    void titleIconGeneric(const uint64_t& tid);
+    //Called for icons on screen so they're decoded before the rest
+    void titleIconRequest(const uint64_t& tid);
+    //Creates textures for up to _max decoded icons and returns how many. Render thread only
+    unsigned titleIconUpload(unsigned _max);
+}
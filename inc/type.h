@@ -20,6 +20,8 @@ class threadStatus
 typedef struct
 {
     bool running = false, finished = false;
+    //Set when [B] is pressed while it runs. Only threads that can stop partway check it
+    bool cancel = false;
     Thread thrd;
     ThreadFunc thrdFunc;
     void *argPtr = NULL;
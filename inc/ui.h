@@ -20,6 +20,9 @@
 #include "ui/ext.h"
 #include "ui/fm.h"
 
+//Full redraws happen at least this often, in case something changed without asking for one
+#define UI_FULL_REDRAW_FRAMES 30
+
 enum menuState
 {
     USR_SEL,
@@ -38,6 +41,14 @@ namespace ui
     //Slide/animation scaling
     extern float animScale;
 
+    //Color shift of the pulsing select box. Advanced once a frame
+    extern uint8_t pulseShift;
+
+    //Asks for a full redraw next frame. Anything animating calls this while it moves. Safe from any thread
+    void markDirty();
+    //Select boxes drawn in the last full redraw. Only their outlines are drawn again until the next one
+    void addBoundBox(SDL_Texture *target, int x, int y, int w, int h);
+
     //Loading glyph
     extern const std::string loadGlyphArray[];
 
@@ -16,4 +16,6 @@ namespace ui
     //Populate to open menu, refresh for updating after actions
     void fldPopulateMenu();
     void fldRefreshMenu();
+    //Safe from any thread. The menu is refreshed on the next fldUpdate if it's open
+    void fldMarkChanged();
 }
\ No newline at end of file
@@ -44,7 +44,8 @@ namespace ui
     {
         SDL_Texture *icn = NULL;
         std::string txt;
-        int txtWidth;
+        //Measured the first time it's needed. Most options in long lists never are
+        int txtWidth = -1;
         std::vector<menuOptEvent> events;
     } menuOpt;
 
@@ -103,11 +104,8 @@ namespace ui
             std::vector<ui::menuOpt> opt;
             //Selected + frame counting for auto-scroll. Hover count is to not break autoscroll
             int selected = 0, fc = 0, hoverCount = 0, spcWidth = 0;
-            //How much we shift the color of the rectangle
-            uint8_t clrSh = 0;
-            bool clrAdd = true, isActive = true, hover = false;
-            //Option buffer. Basically, text is draw to this so it can't overlap. Also allows scrolling
-            SDL_Texture *optTex;
+            bool isActive = true, hover = false;
+            int getOptWidth(int ind);
             funcPtr onChange = NULL, callback = NULL;
             void *callbackArgs, *funcArgs;
     };
@@ -148,6 +146,7 @@ namespace ui
 
             void popMessageAdd(const std::string& mess, int frameTime);
             void draw();
+            bool empty() { return message.empty(); }
 
         private:
             std::vector<popMessage> popQueue;//All graphics need to be on main thread. Directly adding will cause text issues
@@ -160,6 +159,8 @@ namespace ui
     void showMessage(const char *fmt, ...);
     bool confirmTransfer(const std::string& f, const std::string& t);
     bool confirmDelete(const std::string& p);
-    void drawBoundBox(SDL_Texture *target, int x, int y, int w, int h, uint8_t clrSh);
+    void drawBoundBox(SDL_Texture *target, int x, int y, int w, int h);
+    //Just the pulsing border, for redrawing over a box that's already there
+    void drawBoundBoxOutline(SDL_Texture *target, int x, int y, int w, int h);
     void drawTextbox(SDL_Texture *target, int x, int y, int w, int h);
 }
@@ -22,6 +22,10 @@ namespace ui
             void closePanel() { open = false; }
             void setX(int _nX){ x = _nX; };
             bool isOpen() { return open; }
+            //Whether any of it is on screen and where
+            bool isVisible() { return (sldSide == ui::SLD_LEFT && x > -w) || (sldSide == ui::SLD_RIGHT && x < 1280); }
+            SDL_Rect getRect() { return {x, y, w, h}; }
+            SDL_Texture *getTexture() { return panel; }
             void draw(const SDL_Color *backCol);
 
         private:
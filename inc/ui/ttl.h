@@ -6,6 +6,8 @@ namespace ui
     void ttlExit();
     void ttlSetActive(int usr, bool _set, bool _showSel);
     void ttlRefresh();
+    //Only touches the tiles that changed
+    void ttlApplyChanges(const std::vector<data::titleListChange>& _changes);
 
     //JIC for func ptr
     void ttlReset();
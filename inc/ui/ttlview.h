@@ -10,22 +10,17 @@ namespace ui
     class titleTile
     {
         public:
-            titleTile(unsigned _w, unsigned _h, bool _fav, SDL_Texture *_icon)
-            {
-                w = _w;
-                h = _h;
-                wS = _w;
-                hS = _h;
-                fav = _fav;
-                icon = _icon;
-            }
+            titleTile() = default;
+            titleTile(unsigned _w, unsigned _h, bool _fav, uint64_t _tid) { assign(_w, _h, _fav, _tid); }
 
+            //Tiles are reused. Zoom is kept if it's still the same title
+            void assign(unsigned _w, unsigned _h, bool _fav, uint64_t _tid);
             void draw(SDL_Texture *target, int x, int y, bool sel);
 
         private:
-            unsigned w, h, wS, hS;
+            unsigned w = 0, h = 0, wS = 0, hS = 0;
             bool fav = false;
-            SDL_Texture *icon;
+            uint64_t tid = 0;
     };
 
     //Todo less hardcode etc
@@ -33,10 +28,11 @@ namespace ui
     {
         public:
             titleview(const data::user& _u, int _iconW, int _iconH, int _horGap, int _vertGap, int _rowCount, funcPtr _callback);
-            ~titleview();
 
             void update();
             void refresh();
+            void insertTile(unsigned _pos, uint64_t _tid);
+            void eraseTile(unsigned _pos);
 
             void setActive(bool _set, bool _showSel) { active = _set; showSel = _showSel; }
             bool getActive() { return active; }
@@ -46,11 +42,11 @@ namespace ui
 
         private:
             const data::user *u;//Might not be safe. Users *shouldn't* be touched after initial load
-            bool active = false, showSel = false, clrAdd = true;
-            uint8_t clrShft = 0;
+            bool active = false, showSel = false;
             funcPtr callback = NULL;
             int x = 200, y = 62, selected = 0, selRectX = 10, selRectY = 45;
             int iconW, iconH, horGap, vertGap, rowCount;
-            std::vector<ui::titleTile *> tiles;
+            //Held by value and resized in place on refresh
+            std::vector<ui::titleTile> tiles;
     };
 }
@@ -1,15 +1,163 @@
 #pragma once
 
-#include <map>
+#include <string>
+
+//Every UI string and how many entries it has. Translation files are matched to these by name when they're loaded
+#define UI_STRING_LIST(X) \
+    X(author, 1) \
+    X(helpUser, 1) \
+    X(helpTitle, 1) \
+    X(helpFolder, 1) \
+    X(helpSettings, 1) \
+    X(dialogYes, 1) \
+    X(dialogNo, 1) \
+    X(dialogOK, 1) \
+    X(settingsOn, 1) \
+    X(settingsOff, 1) \
+    X(holdingText, 3) \
+    X(confirmBlacklist, 1) \
+    X(confirmOverwrite, 1) \
+    X(confirmRestore, 1) \
+    X(confirmDelete, 1) \
+    X(confirmCancelTransfers, 1) \
+    X(confirmCopy, 1) \
+    X(confirmDeleteSaveData, 1) \
+    X(confirmResetSaveData, 1) \
+    X(confirmCreateAllSaveData, 1) \
+    X(confirmDeleteBackupsTitle, 1) \
+    X(confirmDeleteBackupsAll, 1) \
+    X(confirmDeleteBackupsRemote, 1) \
+    X(confirmDriveOverwrite, 1) \
+    X(saveDataNoneFound, 1) \
+    X(saveDataCreatedForUser, 1) \
+    X(saveDataCreationFailed, 1) \
+    X(saveDataResetSuccess, 1) \
+    X(saveDataDeleteSuccess, 1) \
+    X(saveDataExtendSuccess, 1) \
+    X(saveDataExtendFailed, 1) \
+    X(saveDataDeleteAllUser, 1) \
+    X(saveDataBackupDeleted, 1) \
+    X(saveDataBackupMovedToTrash, 1) \
+    X(saveTypeMainMenu, 6) \
+    X(saveDataTypeText, 7) \
+    X(onlineErrorConnecting, 1) \
+    X(onlineNoUpdates, 1) \
+    X(fileModeMenu, 7) \
+    X(fileModeMenuMkDir, 1) \
+    X(folderMenuNew, 1) \
+    X(fileModeFileProperties, 1) \
+    X(fileModeFolderProperties, 1) \
+    X(settingsMenu, 22) \
+    X(mainMenuSettings, 1) \
+    X(mainMenuExtras, 1) \
+    X(translationMainPage, 1) \
+    X(loadingStartPage, 1) \
+    X(sortType, 3) \
+    X(extrasMenu, 13) \
+    X(userOptions, 4) \
+    X(titleOptions, 10) \
+    X(threadStatusCreatingSaveData, 1) \
+    X(threadStatusCopyingFile, 1) \
+    X(threadStatusDeletingFile, 1) \
+    X(threadStatusOpeningFolder, 1) \
+    X(threadStatusAddingFileToZip, 1) \
+    X(threadStatusDecompressingFile, 1) \
+    X(threadStatusDeletingSaveData, 1) \
+    X(threadStatusExtendingSaveData, 1) \
+    X(threadStatusResettingSaveData, 1) \
+    X(threadStatusDeletingUpdate, 1) \
+    X(threadStatusCheckingForUpdate, 1) \
+    X(threadStatusDownloadingUpdate, 1) \
+    X(threadStatusGetDirProps, 1) \
+    X(threadStatusPackingJKSV, 1) \
+    X(threadStatusSavingTranslations, 1) \
+    X(threadStatusCalculatingSaveSize, 1) \
+    X(threadStatusUploadingFile, 1) \
+    X(threadStatusDownloadingFile, 1) \
+    X(threadStatusCompressingSaveForUpload, 1) \
+    X(threadStatusBenchmarking, 1) \
+    X(threadStatusWaitingForUploads, 1) \
+    X(popCPUBoostEnabled, 1) \
+    X(popErrorCommittingFile, 1) \
+    X(popZipIsEmpty, 1) \
+    X(popFolderIsEmpty, 1) \
+    X(popSaveIsEmpty, 1) \
+    X(popProcessShutdown, 1) \
+    X(popAddedToPathFilter, 1) \
+    X(popChangeOutputFolder, 1) \
+    X(popChangeOutputError, 1) \
+    X(popTrashEmptied, 1) \
+    X(popSVIExported, 1) \
+    X(popDriveStarted, 1) \
+    X(popDriveFailed, 1) \
+    X(popRemoteNotActive, 1) \
+    X(popWebdavStarted, 1) \
+    X(popWebdavFailed, 1) \
+    X(popS3Started, 1) \
+    X(popS3Failed, 1) \
+    X(popLocalRemoteStarted, 1) \
+    X(popLocalRemoteFailed, 1) \
+    X(popBenchmarkFinished, 1) \
+    X(popBenchmarkFailed, 1) \
+    X(popTransferQueued, 1) \
+    X(popTransferFinished, 1) \
+    X(popTransferFailed, 1) \
+    X(popTransfersPaused, 1) \
+    X(popTransfersResumed, 1) \
+    X(popTransfersCancelled, 1) \
+    X(transferStatus, 1) \
+    X(transferStatusPaused, 1) \
+    X(swkbdEnterName, 1) \
+    X(swkbdSaveIndex, 1) \
+    X(swkbdSetWorkDir, 1) \
+    X(swkbdProcessID, 1) \
+    X(swkbdSysSavID, 1) \
+    X(swkbdRename, 1) \
+    X(swkbdMkDir, 1) \
+    X(swkbdNewSafeTitle, 1) \
+    X(swkbdExpandSize, 1) \
+    X(infoStatus, 8) \
+    X(debugStatus, 7) \
+    X(appletModeWarning, 1)
 
 //Strings since translation support
 namespace ui
 {
+    namespace str
+    {
+#define UI_STRING_ENUM(name, count) name,
+        typedef enum
+        {
+            UI_STRING_LIST(UI_STRING_ENUM)
+            UI_STRING_COUNT
+        } id;
+#undef UI_STRING_ENUM
+    }
+
+    //Where each string's entries start in strings. base[UI_STRING_COUNT] is the total
+    typedef struct
+    {
+        unsigned base[str::UI_STRING_COUNT + 1];
+    } strTable;
+
+    constexpr strTable makeStrTable()
+    {
+#define UI_STRING_SIZE(name, count) count,
+        const unsigned sizes[] = { UI_STRING_LIST(UI_STRING_SIZE) };
+#undef UI_STRING_SIZE
+        strTable ret = {};
+        for(unsigned i = 0; i < str::UI_STRING_COUNT; i++)
+            ret.base[i + 1] = ret.base[i] + sizes[i];
+
+        return ret;
+    }
+    inline constexpr strTable strLayout = makeStrTable();
+
     void initStrings();
     void loadTrans();
     void saveTranslationFiles(void *a);
-    extern std::map<std::pair<std::string, int>, std::string> strings;
+    extern std::string strings[strLayout.base[str::UI_STRING_COUNT]];
 
-    inline std::string getUIString(const std::string& _name, int ind){ return strings[std::make_pair(_name, ind)]; }
-    inline const char *getUICString(const std::string& _name, int ind){ return strings[std::make_pair(_name, ind)].c_str(); }
+    inline const std::string& getUIString(str::id _id, int ind){ return strings[strLayout.base[_id] + ind]; }
+    inline const char *getUICString(str::id _id, int ind){ return strings[strLayout.base[_id] + ind].c_str(); }
 }
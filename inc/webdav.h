@@ -28,6 +28,7 @@ namespace rfs {
         bool resourceExists(const std::string& id);
         std::string appendResourceToParentId(const std::string& resourceName, const std::string& parentId, bool isDir);
         std::string getNamespacePrefix(tinyxml2::XMLElement* root, const std::string& nsURI);
+        bool copyOrMove(const char* method, const std::string& fileID, const std::string& newName, const std::string& parentId);
 
     public:
         WebDav(const std::string& origin,
@@ -43,6 +44,8 @@ namespace rfs {
         void updateFile(const std::string& fileID, curlFuncs::curlUpArgs *_upload);
         void downloadFile(const std::string& fileID, curlFuncs::curlDlArgs *_download);
         void deleteFile(const std::string& fileID);
+        bool copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
+        bool moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId);
 
         std::string getFileID(const std::string& name, const std::string& parentId);
         std::string getDirID(const std::string& dirName, const std::string& parentId);
@@ -9,25 +9,66 @@
 #include "ui.h"
 #include "util.h"
 #include "type.h"
+#include "s3.h"
 
-std::unordered_map<std::string, bool> cfg::config;
+bool cfg::config[cfg::CONFIG_COUNT];
 std::vector<uint64_t> cfg::blacklist;
 std::vector<uint64_t> cfg::favorites;
 static std::unordered_map<uint64_t, std::string> pathDefs;
 uint8_t cfg::sortType;
 std::string cfg::driveClientID, cfg::driveClientSecret, cfg::driveRefreshToken;
+std::string cfg::driveTokenURI, cfg::driveAPIOrigin;
 std::string cfg::webdavOrigin, cfg::webdavBasePath, cfg::webdavUser, cfg::webdavPassword;
+std::string cfg::s3Endpoint, cfg::s3Region, cfg::s3Bucket, cfg::s3AccessKey, cfg::s3SecretKey, cfg::s3BasePath;
+uint64_t cfg::s3PartSize = S3_DEFAULT_PART_SIZE;
+unsigned cfg::s3Concurrency = S3_DEFAULT_CONCURRENCY;
+bool cfg::s3PathStyle = true;
+std::string cfg::localRemotePath;
 
 
 const char *cfgPath = "sdmc:/config/JKSV/JKSV.cfg", *titleDefPath = "sdmc:/config/JKSV/titleDefs.txt", *workDirLegacy = "sdmc:/switch/jksv_dir.txt";
-static std::unordered_map<std::string, unsigned> cfgStrings =
+
+typedef struct
+{
+    const char *name;
+    bool def;
+} cfgBoolDef;
+
+#define CFG_BOOL_DEF(key, name, def) { name, def },
+static const cfgBoolDef cfgBools[cfg::CONFIG_COUNT] =
+{
+    CFG_BOOL_LIST(CFG_BOOL_DEF)
+};
+#undef CFG_BOOL_DEF
+
+//Everything that isn't a plain on/off setting
+typedef enum
+{
+    CFG_WORK_DIR,
+    CFG_SORT_TYPE,
+    CFG_ANIM_SCALE,
+    CFG_FAVORITE,
+    CFG_BLACKLIST,
+    CFG_DRIVE_TOKEN
+} cfgOther;
+
+static const std::unordered_map<std::string, unsigned> cfgStrings =
 {
-    {"workDir", 0}, {"includeDeviceSaves", 1}, {"autoBackup", 2}, {"overclock", 3}, {"holdToDelete", 4}, {"holdToRestore", 5},
-    {"holdToOverwrite", 6}, {"forceMount", 7}, {"accountSystemSaves", 8}, {"allowSystemSaveWrite", 9}, {"directFSCommands", 10},
-    {"exportToZIP", 11}, {"languageOverride", 12}, {"enableTrashBin", 13}, {"titleSortType", 14}, {"animationScale", 15},
-    {"favorite", 16}, {"blacklist", 17}, {"autoName", 18}, {"driveRefreshToken", 19},
+    {"workDir", CFG_WORK_DIR}, {"titleSortType", CFG_SORT_TYPE}, {"animationScale", CFG_ANIM_SCALE},
+    {"favorite", CFG_FAVORITE}, {"blacklist", CFG_BLACKLIST}, {"driveRefreshToken", CFG_DRIVE_TOKEN}
 };
 
+//Returns CONFIG_COUNT if _name isn't one
+static cfg::configKey getBoolKey(const std::string& _name)
+{
+    for(unsigned i = 0; i < cfg::CONFIG_COUNT; i++)
+    {
+        if(_name == cfgBools[i].name)
+            return (cfg::configKey)i;
+    }
+    return cfg::CONFIG_COUNT;
+}
+
 const std::string _true_ = "true", _false_ = "false";
 
 bool cfg::isBlacklisted(const uint64_t& tid)
@@ -45,12 +86,9 @@ void cfg::addTitleToBlacklist(void *a)
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
     uint64_t tid = d->tid;
     cfg::blacklist.push_back(tid);
-    for(data::user& u : data::users)
-    {
-        for(unsigned i = 0; i < u.titleInfo.size(); i++)
-            if(u.titleInfo[i].tid == tid) u.titleInfo.erase(u.titleInfo.begin() + i);
-    }
-    ui::ttlRefresh();
+    std::vector<data::titleListChange> changes;
+    data::removeUserTitle(tid, changes);
+    ui::ttlApplyChanges(changes);
     t->finished = true;
 }
 
@@ -93,8 +131,9 @@ void cfg::addTitleToFavorites(const uint64_t& tid)
     else
         cfg::favorites.push_back(tid);
 
-    data::sortUserTitles();
-    ui::ttlRefresh();
+    std::vector<data::titleListChange> changes;
+    data::resortTitle(tid, changes);
+    ui::ttlApplyChanges(changes);
 }
 
 bool cfg::isDefined(const uint64_t& tid)
@@ -119,10 +158,10 @@ void cfg::pathDefAdd(const uint64_t& tid, const std::string& newPath)
         std::string newOutput = fs::getWorkDir() + tmp;
         rename(oldOutput.c_str(), newOutput.c_str());
 
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popChangeOutputFolder", 0), oldSafe.c_str(), tmp.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popChangeOutputFolder, 0), oldSafe.c_str(), tmp.c_str());
     }
     else
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popChangeOutputError", 0), newPath.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popChangeOutputError, 0), newPath.c_str());
 }
 
 std::string cfg::getPathDefinition(const uint64_t& tid)
@@ -141,23 +180,11 @@ void cfg::addPathToFilter(const uint64_t& tid, const std::string& _p)
 
 void cfg::resetConfig()
 {
-    cfg::config["incDev"] = false;
-    cfg::config["autoBack"] = true;
-    cfg::config["ovrClk"] = false;
-    cfg::config["holdDel"] = true;
-    cfg::config["holdRest"] = true;
-    cfg::config["holdOver"] = true;
-    cfg::config["forceMount"] = true;
-    cfg::config["accSysSave"] = false;
-    cfg::config["sysSaveWrite"] = false;
-    cfg::config["directFsCmd"] = false;
-    cfg::config["zip"] = false;
-    cfg::config["langOverride"] = false;
-    cfg::config["trashBin"] = true;
-    cfg::config["autoName"] = false;
+    for(unsigned i = 0; i < cfg::CONFIG_COUNT; i++)
+        cfg::config[i] = cfgBools[i].def;
+
     cfg::sortType = cfg::ALPHA;
     ui::animScale = 3.0f;
-    cfg::config["autoUpload"] = false;
 }
 
 static inline bool textToBool(const std::string& _txt)
@@ -221,19 +248,19 @@ static void loadConfigLegacy()
             ui::animScale = 3.0f;
         fclose(oldCfg);
 
-        cfg::config["incDev"] = cfgIn >> 63 & 1;
-        cfg::config["autoBack"] = cfgIn >> 62 & 1;
-        cfg::config["ovrClk"] = cfgIn >> 61 & 1;
-        cfg::config["holdDel"] = cfgIn >> 60 & 1;
-        cfg::config["holdRest"] = cfgIn >> 59 & 1;
-        cfg::config["holdOver"] = cfgIn >> 58 & 1;
-        cfg::config["forceMount"] = cfgIn >> 57 & 1;
-        cfg::config["accSysSave"] = cfgIn >> 56 & 1;
-        cfg::config["sysSaveWrite"] = cfgIn >> 55 & 1;
-        cfg::config["directFsCmd"] = cfgIn >> 53 & 1;
-        cfg::config["zip"] = cfgIn >> 51 & 1;
-        cfg::config["langOverride"] = cfgIn >> 50 & 1;
-        cfg::config["trashBin"] = cfgIn >> 49 & 1;
+        cfg::config[cfg::INC_DEV] = cfgIn >> 63 & 1;
+        cfg::config[cfg::AUTO_BACK] = cfgIn >> 62 & 1;
+        cfg::config[cfg::OVR_CLK] = cfgIn >> 61 & 1;
+        cfg::config[cfg::HOLD_DEL] = cfgIn >> 60 & 1;
+        cfg::config[cfg::HOLD_REST] = cfgIn >> 59 & 1;
+        cfg::config[cfg::HOLD_OVER] = cfgIn >> 58 & 1;
+        cfg::config[cfg::FORCE_MOUNT] = cfgIn >> 57 & 1;
+        cfg::config[cfg::ACC_SYS_SAVE] = cfgIn >> 56 & 1;
+        cfg::config[cfg::SYS_SAVE_WRITE] = cfgIn >> 55 & 1;
+        cfg::config[cfg::DIRECT_FS_CMD] = cfgIn >> 53 & 1;
+        cfg::config[cfg::ZIP] = cfgIn >> 51 & 1;
+        cfg::config[cfg::LANG_OVERRIDE] = cfgIn >> 50 & 1;
+        cfg::config[cfg::TRASH_BIN] = cfgIn >> 49 & 1;
         fs::delfile(legacyCfgPath.c_str());
     }
 }
@@ -311,7 +338,7 @@ static void loadDriveConfig()
 
     if(!clientSecretPath.empty())
     {
-        json_object *installed, *clientID, *clientSecret, *driveJSON = json_object_from_file(clientSecretPath.c_str());
+        json_object *installed, *clientID, *clientSecret, *tokenURI, *apiOrigin, *driveJSON = json_object_from_file(clientSecretPath.c_str());
         if (driveJSON) 
         {
             if(json_object_object_get_ex(driveJSON, "installed", &installed))
@@ -322,6 +349,12 @@ static void loadDriveConfig()
                     cfg::driveClientID = json_object_get_string(clientID);
                     cfg::driveClientSecret = json_object_get_string(clientSecret);
                 }
+
+                // Google always writes token_uri. api_origin is JKSV's own, for testing against tools/mockremote.py
+                if(json_object_object_get_ex(installed, "token_uri", &tokenURI))
+                    cfg::driveTokenURI = json_object_get_string(tokenURI);
+                if(json_object_object_get_ex(installed, "api_origin", &apiOrigin))
+                    cfg::driveAPIOrigin = json_object_get_string(apiOrigin);
             }
             json_object_put(driveJSON);
         }
@@ -346,6 +379,56 @@ static void loadDriveConfig()
             cfg::webdavPassword = json_object_get_string(password);
         }
     }
+
+    // S3
+    json_object *s3JSON = json_object_from_file("/config/JKSV/s3.json");
+    json_object *endpoint, *region, *bucket, *accessKey, *secretKey, *s3BasePath, *partSize, *concurrency, *pathStyle;
+    if (s3JSON)
+    {
+        if (json_object_object_get_ex(s3JSON, "endpoint", &endpoint)) {
+            cfg::s3Endpoint = json_object_get_string(endpoint);
+        }
+        if (json_object_object_get_ex(s3JSON, "region", &region)) {
+            cfg::s3Region = json_object_get_string(region);
+        }
+        if (json_object_object_get_ex(s3JSON, "bucket", &bucket)) {
+            cfg::s3Bucket = json_object_get_string(bucket);
+        }
+        if (json_object_object_get_ex(s3JSON, "accessKey", &accessKey)) {
+            cfg::s3AccessKey = json_object_get_string(accessKey);
+        }
+        if (json_object_object_get_ex(s3JSON, "secretKey", &secretKey)) {
+            cfg::s3SecretKey = json_object_get_string(secretKey);
+        }
+        if (json_object_object_get_ex(s3JSON, "basepath", &s3BasePath)) {
+            cfg::s3BasePath = json_object_get_string(s3BasePath);
+        }
+        // Checked before the cast and multiply so negative or huge values can't wrap. S3 raises anything under its minimum
+        if (json_object_object_get_ex(s3JSON, "partSizeMB", &partSize) && json_object_get_int64(partSize) > 0) {
+            int64_t partSizeMB = json_object_get_int64(partSize);
+            if (partSizeMB > S3_MAX_PART_SIZE / 0x100000)
+                partSizeMB = S3_MAX_PART_SIZE / 0x100000;
+            cfg::s3PartSize = (uint64_t)partSizeMB * 0x100000;
+        }
+        if (json_object_object_get_ex(s3JSON, "concurrency", &concurrency)) {
+            cfg::s3Concurrency = json_object_get_int(concurrency);
+        }
+        if (json_object_object_get_ex(s3JSON, "pathStyle", &pathStyle)) {
+            cfg::s3PathStyle = json_object_get_boolean(pathStyle);
+        }
+        json_object_put(s3JSON);
+    }
+
+    // Local path
+    json_object *localJSON = json_object_from_file("/config/JKSV/local.json");
+    json_object *localPath;
+    if (localJSON)
+    {
+        if (json_object_object_get_ex(localJSON, "path", &localPath)) {
+            cfg::localRemotePath = json_object_get_string(localPath);
+        }
+        json_object_put(localJSON);
+    }
 }
 
 void cfg::loadConfig()
@@ -360,118 +443,66 @@ void cfg::loadConfig()
 
     if(fs::fileExists(cfgPath))
     {
-        fs::dataFile cfgRead(cfgPath);
-        while(cfgRead.readNextLine(true))
+        fs::dataBlob cfgRead(cfgPath);
+        while(cfgRead.readNextLine())
         {
             std::string varName = cfgRead.getName();
-            if(cfgStrings.find(varName) != cfgStrings.end())
+            cfg::configKey key = getBoolKey(varName);
+            if(key != cfg::CONFIG_COUNT)
             {
-                switch(cfgStrings[varName])
-                {
-                    case 0:
-                        fs::setWorkDir(cfgRead.getNextValueStr());
-                        break;
-
-                    case 1:
-                        cfg::config["incDev"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 2:
-                        cfg::config["autoBack"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 3:
-                        cfg::config["ovrClk"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 4:
-                        cfg::config["holdDel"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 5:
-                        cfg::config["holdRest"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 6:
-                        cfg::config["holdOver"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 7:
-                        cfg::config["forceMount"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 8:
-                        cfg::config["accSysSave"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 9:
-                        cfg::config["sysSaveWrite"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 10:
-                        cfg::config["directFsCmd"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 11:
-                        cfg::config["zip"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 12:
-                        cfg::config["langOverride"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 13:
-                        cfg::config["trashBin"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 14:
-                        {
-                            std::string getSort = cfgRead.getNextValueStr();
-                            if(getSort == "ALPHA")
-                                cfg::sortType = cfg::ALPHA;
-                            else if(getSort == "MOST_PLAYED")
-                                cfg::sortType = cfg::MOST_PLAYED;
-                            else
-                                cfg::sortType = cfg::LAST_PLAYED;
-                        }
-                        break;
-
-                    case 15:
-                        {
-                            std::string animFloat = cfgRead.getNextValueStr();
-                            ui::animScale = strtof(animFloat.c_str(), NULL);
-                        }
-                        break;
-
-                    case 16:
-                        {
-                            std::string tid = cfgRead.getNextValueStr();
-                            cfg::favorites.push_back(strtoul(tid.c_str(), NULL, 16));
-                        }
-                        break;
-
-                    case 17:
-                        {
-                            std::string tid = cfgRead.getNextValueStr();
-                            cfg::blacklist.push_back(strtoul(tid.c_str(), NULL, 16));
-                        }
-                        break;
-
-                    case 18:
-                        cfg::config["autoName"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    case 19:
-                        cfg::driveRefreshToken = cfgRead.getNextValueStr();
-                        break;
-
-                    case 20:
-                        cfg::config["autoUpload"] = textToBool(cfgRead.getNextValueStr());
-                        break;
-
-                    default:
-                        break;
-                }
+                cfg::config[key] = textToBool(cfgRead.getNextValueStr());
+                continue;
+            }
+
+            auto other = cfgStrings.find(varName);
+            if(other == cfgStrings.end())
+                continue;
+
+            switch(other->second)
+            {
+                case CFG_WORK_DIR:
+                    fs::setWorkDir(cfgRead.getNextValueStr());
+                    break;
+
+                case CFG_SORT_TYPE:
+                    {
+                        std::string getSort = cfgRead.getNextValueStr();
+                        if(getSort == "ALPHA")
+                            cfg::sortType = cfg::ALPHA;
+                        else if(getSort == "MOST_PLAYED")
+                            cfg::sortType = cfg::MOST_PLAYED;
+                        else
+                            cfg::sortType = cfg::LAST_PLAYED;
+                    }
+                    break;
+
+                case CFG_ANIM_SCALE:
+                    {
+                        std::string animFloat = cfgRead.getNextValueStr();
+                        ui::animScale = strtof(animFloat.c_str(), NULL);
+                    }
+                    break;
+
+                case CFG_FAVORITE:
+                    {
+                        std::string tid = cfgRead.getNextValueStr();
+                        cfg::favorites.push_back(strtoul(tid.c_str(), NULL, 16));
+                    }
+                    break;
+
+                case CFG_BLACKLIST:
+                    {
+                        std::string tid = cfgRead.getNextValueStr();
+                        cfg::blacklist.push_back(strtoul(tid.c_str(), NULL, 16));
+                    }
+                    break;
+
+                case CFG_DRIVE_TOKEN:
+                    cfg::driveRefreshToken = cfgRead.getNextValueStr();
+                    break;
+
+                default:
+                    break;
             }
         }
     }
@@ -490,23 +521,10 @@ void cfg::saveConfig()
 {
     FILE *cfgOut = fopen("sdmc:/config/JKSV/JKSV.cfg", "w");
     fprintf(cfgOut, "#JKSV config.\nworkDir = \"%s\"\n\n", fs::getWorkDir().c_str());
-    fprintf(cfgOut, "includeDeviceSaves = %s\n", boolToText(cfg::config["incDev"]).c_str());
-    fprintf(cfgOut, "autoBackup = %s\n", boolToText(cfg::config["autoBack"]).c_str());
-    fprintf(cfgOut, "autoName = %s\n", boolToText(cfg::config["autoName"]).c_str());
-    fprintf(cfgOut, "overclock = %s\n", boolToText(cfg::config["ovrClk"]).c_str());
-    fprintf(cfgOut, "holdToDelete = %s\n", boolToText(cfg::config["holdDel"]).c_str());
-    fprintf(cfgOut, "holdToRestore = %s\n", boolToText(cfg::config["holdRest"]).c_str());
-    fprintf(cfgOut, "holdToOverwrite = %s\n", boolToText(cfg::config["holdOver"]).c_str());
-    fprintf(cfgOut, "forceMount = %s\n", boolToText(cfg::config["forceMount"]).c_str());
-    fprintf(cfgOut, "accountSystemSaves = %s\n", boolToText(cfg::config["accSysSaves"]).c_str());
-    fprintf(cfgOut, "allowSystemSaveWrite = %s\n", boolToText(cfg::config["sysSaveWrite"]).c_str());
-    fprintf(cfgOut, "directFSCommands = %s\n", boolToText(cfg::config["directFsCmd"]).c_str());
-    fprintf(cfgOut, "exportToZIP = %s\n", boolToText(cfg::config["zip"]).c_str());
-    fprintf(cfgOut, "languageOverride = %s\n", boolToText(cfg::config["langOverride"]).c_str());
-    fprintf(cfgOut, "enableTrashBin = %s\n", boolToText(cfg::config["trashBin"]).c_str());
+    for(unsigned i = 0; i < cfg::CONFIG_COUNT; i++)
+        fprintf(cfgOut, "%s = %s\n", cfgBools[i].name, boolToText(cfg::config[i]).c_str());
     fprintf(cfgOut, "titleSortType = %s\n", sortTypeText().c_str());
     fprintf(cfgOut, "animationScale = %f\n", ui::animScale);
-    fprintf(cfgOut, "autoUpload = %s\n", boolToText(cfg::config["autoUpload"]).c_str());
 
     if(!cfg::driveRefreshToken.empty())
         fprintf(cfgOut, "driveRefreshToken = %s\n", cfg::driveRefreshToken.c_str());
@@ -1,5 +1,7 @@
 #include <string>
 #include <vector>
+#include <strings.h>
+#include <atomic>
 #include <curl/curl.h>
 
 #include "curlfuncs.h"
@@ -7,9 +9,8 @@
 
 size_t curlFuncs::writeDataString(const char *buff, size_t sz, size_t cnt, void *u)
 {
-    std::string *str = (std::string *)u;
-    str->append(buff, 0, sz * cnt);
-    return sz * cnt;
+    stringSink sink((std::string *)u);
+    return writeStream(buff, sz, cnt, &sink);
 }
 
 size_t curlFuncs::writeHeaders(const char *buff, size_t sz, size_t cnt, void *u)
@@ -22,8 +23,13 @@ size_t curlFuncs::writeHeaders(const char *buff, size_t sz, size_t cnt, void *u)
 size_t curlFuncs::readDataFile(char *buff, size_t sz, size_t cnt, void *u)
 {
     curlFuncs::curlUpArgs*in = (curlFuncs::curlUpArgs *)u;
+    if(in->cancel && *in->cancel)
+        return CURL_READFUNC_ABORT;
 
-    size_t ret = fread(buff, sz, cnt, in->f);
+    fileSource src(in->f, in->tap);
+    ssize_t ret = src.read((uint8_t *)buff, sz * cnt);
+    if(ret < 0)
+        return CURL_READFUNC_ABORT;
 
     if(in->o)
         *in->o = ftell(in->f);
@@ -31,6 +37,19 @@ size_t curlFuncs::readDataFile(char *buff, size_t sz, size_t cnt, void *u)
     return ret;
 }
 
+static std::atomic<uint64_t> requestCount(0);
+
+CURLcode curlFuncs::perform(CURL *handle)
+{
+    ++requestCount;
+    return curl_easy_perform(handle);
+}
+
+uint64_t curlFuncs::getRequestCount()
+{
+    return requestCount;
+}
+
 std::string curlFuncs::getHeader(const std::string& name, std::vector<std::string> *h)
 {
     std::string ret = HEADER_ERROR;
@@ -66,36 +85,187 @@ std::string curlFuncs::getJSONURL(std::vector<std::string> *headers, const std::
         curl_easy_setopt(handle, CURLOPT_HEADERDATA, headers);
     }
 
-    if(curl_easy_perform(handle) != CURLE_OK)
+    if(perform(handle) != CURLE_OK)
         ret.clear();//JIC
 
     curl_easy_cleanup(handle);
     return ret;
 }
 
-size_t writeDataBin(uint8_t *buff, size_t sz, size_t cnt, void *u)
+curlFuncs::fileSink::fileSink(const std::string& _path) : streamStage(NULL)
 {
-    size_t sizeIn = sz * cnt;
-    std::vector<uint8_t> *binData = (std::vector<uint8_t> *)u;
-    binData->reserve(sizeIn);
-    binData->insert(binData->end(), buff, buff + sizeIn);
-    return sizeIn;
+    f = fopen(_path.c_str(), "wb");
 }
 
-bool curlFuncs::getBinURL(std::vector<uint8_t> *out, const std::string& _url)
+curlFuncs::fileSink::~fileSink()
+{
+    if(f)
+        fclose(f);
+}
+
+bool curlFuncs::fileSink::write(const uint8_t *_data, size_t _size)
+{
+    return f && fwrite(_data, 1, _size, f) == _size;
+}
+
+bool curlFuncs::fileSink::finish()
+{
+    if(!f)
+        return false;
+
+    bool ret = fclose(f) == 0;
+    f = NULL;
+    return ret;
+}
+
+bool curlFuncs::memorySink::write(const uint8_t *_data, size_t _size)
+{
+    out->insert(out->end(), _data, _data + _size);
+    return true;
+}
+
+bool curlFuncs::stringSink::write(const uint8_t *_data, size_t _size)
+{
+    out->append((const char *)_data, _size);
+    return true;
+}
+
+bool curlFuncs::zipEntrySink::write(const uint8_t *_data, size_t _size)
+{
+    return zipWriteInFileInZip(z, _data, _size) == ZIP_OK;
+}
+
+curlFuncs::sha256Stage::sha256Stage(streamStage *_next) : streamStage(_next)
+{
+    sha256ContextCreate(&ctx);
+    memset(hash, 0, SHA256_HASH_SIZE);
+}
+
+bool curlFuncs::sha256Stage::write(const uint8_t *_data, size_t _size)
+{
+    sha256ContextUpdate(&ctx, _data, _size);
+    return streamStage::write(_data, _size);
+}
+
+bool curlFuncs::sha256Stage::finish()
+{
+    sha256ContextGetHash(&ctx, hash);
+    return streamStage::finish();
+}
+
+bool curlFuncs::sha256Stage::hashMatches(const std::string& _hex) const
+{
+    if(_hex.length() != SHA256_HASH_SIZE * 2)
+        return false;
+
+    char hex[3];
+    for(unsigned i = 0; i < SHA256_HASH_SIZE; i++)
+    {
+        sprintf(hex, "%02x", hash[i]);
+        if(strncasecmp(hex, _hex.c_str() + i * 2, 2) != 0)
+            return false;
+    }
+    return true;
+}
+
+curlFuncs::inflateStage::inflateStage(streamStage *_next) : streamStage(_next), outBuff(STREAM_INFLATE_CHUNK)
+{
+    memset(&strm, 0, sizeof(z_stream));
+    //+32 detects zlib or gzip headers on its own
+    inflateInit2(&strm, MAX_WBITS + 32);
+}
+
+curlFuncs::inflateStage::~inflateStage()
+{
+    inflateEnd(&strm);
+}
+
+bool curlFuncs::inflateStage::write(const uint8_t *_data, size_t _size)
+{
+    //Anything after the end is ignored
+    if(ended)
+        return true;
+
+    strm.next_in = (Bytef *)_data;
+    strm.avail_in = _size;
+    while(strm.avail_in > 0 && !ended)
+    {
+        strm.next_out = outBuff.data();
+        strm.avail_out = STREAM_INFLATE_CHUNK;
+        int res = inflate(&strm, Z_NO_FLUSH);
+        if(res != Z_OK && res != Z_STREAM_END && res != Z_BUF_ERROR)
+            return false;
+
+        ended = res == Z_STREAM_END;
+        size_t have = STREAM_INFLATE_CHUNK - strm.avail_out;
+        if(have > 0 && !streamStage::write(outBuff.data(), have))
+            return false;
+    }
+    return true;
+}
+
+bool curlFuncs::inflateStage::finish()
+{
+    //Truncated data shouldn't look like a good download
+    return ended && streamStage::finish();
+}
+
+bool curlFuncs::progressStage::write(const uint8_t *_data, size_t _size)
+{
+    *o += _size;
+    return streamStage::write(_data, _size);
+}
+
+ssize_t curlFuncs::fileSource::read(uint8_t *_buff, size_t _size)
+{
+    size_t ret = fread(_buff, 1, _size, f);
+    if(ret == 0)
+        return ferror(f) ? -1 : 0;
+
+    if(tap && !tap->write(_buff, ret))
+        return -1;
+
+    return ret;
+}
+
+size_t curlFuncs::writeStream(const char *buff, size_t sz, size_t cnt, void *u)
+{
+    streamStage *out = (streamStage *)u;
+    //Anything short of sz * cnt makes curl abort
+    return out->write((const uint8_t *)buff, sz * cnt) ? sz * cnt : 0;
+}
+
+size_t curlFuncs::readStream(char *buff, size_t sz, size_t cnt, void *u)
+{
+    fileSource *in = (fileSource *)u;
+    ssize_t ret = in->read((uint8_t *)buff, sz * cnt);
+    return ret < 0 ? CURL_READFUNC_ABORT : ret;
+}
+
+bool curlFuncs::getStreamURL(streamStage *_out, const std::string& _url)
 {
     bool ret = false;
     CURL *handle = curl_easy_init();
     curl_easy_setopt(handle, CURLOPT_URL, _url.c_str());
     curl_easy_setopt(handle, CURLOPT_HTTPGET, 1);
     curl_easy_setopt(handle, CURLOPT_USERAGENT, "JKSV");
-    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeDataBin);
-    curl_easy_setopt(handle, CURLOPT_WRITEDATA, out);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeStream);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, _out);
     curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1);
-    curl_easy_setopt(handle, CURLOPT_TIMEOUT, 15);
-    if(curl_easy_perform(handle) == CURLE_OK)
-        ret = true;
+    curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1);
+    //No total timeout, these can be big. Give up if it stalls instead
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 15);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, 1);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, 15);
+    if(perform(handle) == CURLE_OK)
+        ret = _out->finish();
 
     curl_easy_cleanup(handle);
     return ret;
 }
+
+bool curlFuncs::getBinURL(std::vector<uint8_t> *out, const std::string& _url)
+{
+    memorySink mem(out);
+    return getStreamURL(&mem, _url);
+}
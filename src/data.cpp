@@ -5,14 +5,21 @@
 #include <algorithm>
 #include <cstdio>
 #include <ctime>
+#include <atomic>
 #include <switch.h>
 
 #include "data.h"
+#include "titlecache.h"
 #include "file.h"
 #include "util.h"
 #include "type.h"
 #include "cfg.h"
 
+//Save infos and application records read per call
+#define DATA_READ_BATCH 64
+//Threads title and play stat lookups are spread over, the calling one included
+#define DATA_LOAD_THREADS 3
+
 //FsSaveDataSpaceId_All doesn't work for SD
 static const unsigned saveOrder [] = { 0, 1, 2, 3, 4, 100, 101 };
 
@@ -31,44 +38,62 @@ std::unordered_map<uint64_t, data::titleInfo> data::titles;
 //Sorts titles by sortType
 static struct
 {
-    bool operator()(const data::userTitleInfo& a, const data::userTitleInfo& b)
+    bool operator()(const std::shared_ptr<data::userTitleInfo>& a, const std::shared_ptr<data::userTitleInfo>& b)
     {
         //Favorites override EVERYTHING
-        if(cfg::isFavorite(a.tid) != cfg::isFavorite(b.tid)) return cfg::isFavorite(a.tid);
+        if(a->title->fav != b->title->fav)
+            return a->title->fav;
 
         switch(cfg::sortType)
         {
             case cfg::ALPHA:
-                {
-                    std::string titleA = data::getTitleNameByTID(a.tid);
-                    std::string titleB = data::getTitleNameByTID(b.tid);
-                    uint32_t pointA, pointB;
-                    for(unsigned i = 0, j = 0; i < titleA.length(); )
-                    {
-                        ssize_t aCnt = decode_utf8(&pointA, (const uint8_t *)&titleA.data()[i]);
-                        ssize_t bCnt = decode_utf8(&pointB, (const uint8_t *)&titleB.data()[j]);
-                        pointA = tolower(pointA), pointB = tolower(pointB);
-                        if(pointA != pointB)
-                            return pointA < pointB;
-
-                        i += aCnt;
-                        j += bCnt;
-                    }
-                }
+                return a->title->sortKey < b->title->sortKey;
                 break;
 
             case cfg::MOST_PLAYED:
-                return a.playStats.playtime > b.playStats.playtime;
+                return a->playStats.playtime > b->playStats.playtime;
                 break;
 
             case cfg::LAST_PLAYED:
-                return a.playStats.last_timestamp_user> b.playStats.last_timestamp_user;
+                return a->playStats.last_timestamp_user > b->playStats.last_timestamp_user;
                 break;
         }
         return false;
     }
 } sortTitles;
 
+//Folds what should sort together. Code point order does the rest: Latin, then kana, then kanji
+static std::string getSortKey(const std::string& title)
+{
+    std::string ret;
+    ret.reserve(title.length());
+    for(unsigned i = 0; i < title.length(); )
+    {
+        uint32_t point = 0;
+        ssize_t unitCnt = decode_utf8(&point, (const uint8_t *)&title.c_str()[i]);
+        if(unitCnt <= 0)
+            break;
+
+        i += unitCnt;
+
+        //Fullwidth ASCII
+        if(point >= 0xFF01 && point <= 0xFF5E)
+            point -= 0xFEE0;
+        //Katakana to hiragana
+        else if(point >= 0x30A1 && point <= 0x30F6)
+            point -= 0x60;
+
+        if((point >= 'A' && point <= 'Z') || (point >= 0xC0 && point <= 0xDE && point != 0xD7))
+            point += 0x20;
+
+        uint8_t units[4];
+        ssize_t outCnt = encode_utf8(units, point);
+        if(outCnt > 0)
+            ret.append((const char *)units, outCnt);
+    }
+    return ret;
+}
+
 //Returns -1 for new
 static int getUserIndex(const AccountUid& id)
 {
@@ -81,7 +106,7 @@ static int getUserIndex(const AccountUid& id)
 
 static inline bool accountSystemSaveCheck(const FsSaveDataInfo& _inf)
 {
-    if(_inf.save_data_type == FsSaveDataType_System && util::accountUIDToU128(_inf.uid) != 0 && !cfg::config["accSysSave"])
+    if(_inf.save_data_type == FsSaveDataType_System && util::accountUIDToU128(_inf.uid) != 0 && !cfg::config[cfg::ACC_SYS_SAVE])
         return false;
 
     return true;
@@ -91,7 +116,7 @@ static inline bool accountSystemSaveCheck(const FsSaveDataInfo& _inf)
 static bool testMount(const FsSaveDataInfo& _inf)
 {
     bool ret = false;
-    if(!cfg::config["forceMount"])
+    if(!cfg::config[cfg::FORCE_MOUNT])
         return true;
 
     if((ret = fs::mountSave(_inf)))
@@ -100,55 +125,158 @@ static bool testMount(const FsSaveDataInfo& _inf)
     return ret;
 }
 
-static inline void addTitleToList(const uint64_t& tid)
+void data::setTitleNacp(titleNacp& _out, const NacpStruct& _nacp)
 {
-    uint64_t outSize = 0;
-    NsApplicationControlData *ctrlData = new NsApplicationControlData;
-    NacpLanguageEntry *ent;
-    Result ctrlRes = nsGetApplicationControlData(NsApplicationControlSource_Storage, tid, ctrlData, sizeof(NsApplicationControlData), &outSize);
-    Result nacpRes = nacpGetLanguageEntry(&ctrlData->nacp, &ent);
-    size_t iconSize = outSize - sizeof(ctrlData->nacp);
+    _out.save_data_owner_id = _nacp.save_data_owner_id;
+    _out.user_account_save_data_size = _nacp.user_account_save_data_size;
+    _out.user_account_save_data_journal_size = _nacp.user_account_save_data_journal_size;
+    _out.user_account_save_data_journal_size_max = _nacp.user_account_save_data_journal_size_max;
+    _out.device_save_data_size = _nacp.device_save_data_size;
+    _out.device_save_data_journal_size = _nacp.device_save_data_journal_size;
+    _out.device_save_data_journal_size_max = _nacp.device_save_data_journal_size_max;
+    _out.bcat_delivery_cache_storage_size = _nacp.bcat_delivery_cache_storage_size;
+    _out.cache_storage_size = _nacp.cache_storage_size;
+    _out.cache_storage_journal_size = _nacp.cache_storage_journal_size;
+    _out.cache_storage_data_and_journal_size_max = _nacp.cache_storage_data_and_journal_size_max;
+}
 
-    if(R_SUCCEEDED(ctrlRes) && !(outSize < sizeof(ctrlData->nacp)) && R_SUCCEEDED(nacpRes) && iconSize > 0)
+//Sizes, title, author and safe title. Without a nacp there's only the ID to go on
+static void setTitleInfo(const uint64_t& tid, data::titleInfo& info, NacpStruct *nacp)
+{
+    if(nacp)
     {
-        //Copy nacp
-        memcpy(&data::titles[tid].nacp, &ctrlData->nacp, sizeof(NacpStruct));
+        data::setTitleNacp(info.nacp, *nacp);
 
-        //Setup 'shortcuts' to strings
         NacpLanguageEntry *ent;
-        nacpGetLanguageEntry(&data::titles[tid].nacp, &ent);
+        nacpGetLanguageEntry(nacp, &ent);
         if(strlen(ent->name) == 0)
-            data::titles[tid].title = ctrlData->nacp.lang[SetLanguage_ENUS].name;
+            info.title = nacp->lang[SetLanguage_ENUS].name;
         else
-            data::titles[tid].title = ent->name;
-        data::titles[tid].author = ent->author;
+            info.title = ent->name;
+        info.author = ent->author;
         if(cfg::isDefined(tid))
-            data::titles[tid].safeTitle = cfg::getPathDefinition(tid);
-        else if((data::titles[tid].safeTitle = util::safeString(ent->name)) == "")
-            data::titles[tid].safeTitle = util::getIDStr(tid);
-
-        if(cfg::isFavorite(tid))
-            data::titles[tid].fav = true;
-        
-        data::titles[tid].icon = gfx::texMgr->textureLoadFromMem(IMG_FMT_JPG, ctrlData->icon, iconSize);
-        if(!data::titles[tid].icon)
-            data::titles[tid].icon = util::createIconGeneric(util::getIDStrLower(tid).c_str(), 32, true);
+            info.safeTitle = cfg::getPathDefinition(tid);
+        else if((info.safeTitle = util::safeString(ent->name)) == "")
+            info.safeTitle = util::getIDStr(tid);
     }
     else
     {
-        memset(&data::titles[tid].nacp, 0, sizeof(NacpStruct));
-        data::titles[tid].title = util::getIDStr(tid);
-        data::titles[tid].author = "Someone?";
+        memset(&info.nacp, 0, sizeof(data::titleNacp));
+        info.title = util::getIDStr(tid);
+        info.author = "Someone?";
         if(cfg::isDefined(tid))
-            data::titles[tid].safeTitle = cfg::getPathDefinition(tid);
+            info.safeTitle = cfg::getPathDefinition(tid);
         else
-            data::titles[tid].safeTitle = util::getIDStr(tid);
+            info.safeTitle = util::getIDStr(tid);
+    }
+    info.sortKey = getSortKey(info.title);
+    info.fav = cfg::isFavorite(tid);
+}
+
+//Doesn't touch data::titles itself so several can run at once
+static void loadTitleInfo(const uint64_t& tid, data::titleInfo& info)
+{
+    uint32_t version = data::getTitleVersion(tid);
+    bool hasCtrl = false;
+    //Only needed until the parts that are kept are copied out
+    NsApplicationControlData *ctrlData = new NsApplicationControlData;
+    if(data::titleCacheGetCtrl(tid, version, &ctrlData->nacp, hasCtrl))
+    {
+        if(hasCtrl)
+            data::titleIconQueue(tid, version, NULL, 0);
+    }
+    else
+    {
+        uint64_t outSize = 0;
+        NacpLanguageEntry *ent;
+        Result ctrlRes = nsGetApplicationControlData(NsApplicationControlSource_Storage, tid, ctrlData, sizeof(NsApplicationControlData), &outSize);
+        Result nacpRes = nacpGetLanguageEntry(&ctrlData->nacp, &ent);
+        size_t iconSize = outSize - sizeof(ctrlData->nacp);
 
-        data::titles[tid].icon = util::createIconGeneric(util::getIDStrLower(tid).c_str(), 32, true);
+        hasCtrl = R_SUCCEEDED(ctrlRes) && !(outSize < sizeof(ctrlData->nacp)) && R_SUCCEEDED(nacpRes) && iconSize > 0;
+        if(hasCtrl)
+        {
+            data::titleCacheStoreCtrl(tid, version, &ctrlData->nacp);
+            //Icon is decoded on its own time
+            data::titleIconQueue(tid, version, ctrlData->icon, iconSize);
+        }
+        //Installed titles might just be having a bad moment. Only remember the ones with nothing there
+        else if(version == TITLE_VERSION_NONE)
+            data::titleCacheStoreCtrl(tid, version, NULL);
     }
+
+    setTitleInfo(tid, info, hasCtrl ? &ctrlData->nacp : NULL);
+    if(!hasCtrl)
+        data::titleIconGeneric(tid);
+
     delete ctrlData;
 }
 
+typedef struct
+{
+    std::atomic<unsigned> next;
+    unsigned count;
+    void (*func)(unsigned, void *);
+    void *args;
+} parallelJob;
+
+static void parallelWorker_t(void *a)
+{
+    parallelJob *job = (parallelJob *)a;
+    for(unsigned i = job->next++; i < job->count; i = job->next++)
+        (*job->func)(i, job->args);
+}
+
+//Calls func for 0 to count - 1 spread over DATA_LOAD_THREADS, this one included. Returns once all are done
+static void runParallel(unsigned count, void (*func)(unsigned, void *), void *args)
+{
+    parallelJob job;
+    job.next = 0;
+    job.count = count;
+    job.func = func;
+    job.args = args;
+
+    Thread workers[DATA_LOAD_THREADS - 1];
+    unsigned workerCount = 0;
+    for(unsigned i = 0; i < DATA_LOAD_THREADS - 1 && count > 1; i++)
+    {
+        if(R_FAILED(threadCreate(&workers[workerCount], parallelWorker_t, &job, NULL, 0x10000, 0x2B, i + 1)))
+            continue;
+
+        if(R_SUCCEEDED(threadStart(&workers[workerCount])))
+            ++workerCount;
+        else
+            threadClose(&workers[workerCount]);
+    }
+
+    parallelWorker_t(&job);
+    for(unsigned i = 0; i < workerCount; i++)
+    {
+        threadWaitForExit(&workers[i]);
+        threadClose(&workers[i]);
+    }
+}
+
+static void loadTitleInfo_t(unsigned i, void *a)
+{
+    std::vector<std::pair<uint64_t, data::titleInfo *>> *load = (std::vector<std::pair<uint64_t, data::titleInfo *>> *)a;
+    loadTitleInfo(load->at(i).first, *load->at(i).second);
+}
+
+//Loads every title in tids that isn't already. Entries are made up front so nothing moves while the workers fill them in
+static unsigned addTitlesToList(const std::vector<uint64_t>& tids)
+{
+    std::vector<std::pair<uint64_t, data::titleInfo *>> load;
+    for(const uint64_t& tid : tids)
+    {
+        if(data::titles.find(tid) == data::titles.end())
+            load.emplace_back(tid, &data::titles[tid]);
+    }
+
+    runParallel(load.size(), loadTitleInfo_t, &load);
+    return load.size();
+}
+
 static inline bool titleIsLoaded(const uint64_t& tid)
 {
     auto findTid = data::titles.find(tid);
@@ -169,15 +297,21 @@ static void loadUserAccounts()
 }
 
 //This can load titles installed without having save data
-static void loadTitlesFromRecords()
+static unsigned loadTitlesFromRecords()
 {
-    NsApplicationRecord nsRecord;
+    std::vector<uint64_t> tids;
+    NsApplicationRecord *nsRecords = new NsApplicationRecord[DATA_READ_BATCH];
     int32_t entryCount = 0, recordOffset = 0;
-    while(R_SUCCEEDED(nsListApplicationRecord(&nsRecord, 1, recordOffset++, &entryCount)) && entryCount > 0)
+    while(R_SUCCEEDED(nsListApplicationRecord(nsRecords, DATA_READ_BATCH, recordOffset, &entryCount)) && entryCount > 0)
     {
-        if(!titleIsLoaded(nsRecord.application_id))
-            addTitleToList(nsRecord.application_id);
+        for(int32_t i = 0; i < entryCount; i++)
+            tids.push_back(nsRecords[i].application_id);
+
+        recordOffset += entryCount;
     }
+    delete[] nsRecords;
+
+    return addTitlesToList(tids);
 }
 
 static void importSVIs()
@@ -190,7 +324,6 @@ static void importSVIs()
         {
             uint64_t tid = 0;
             NacpStruct *nacp = new NacpStruct;
-            NacpLanguageEntry *ent;
             std::string sviPath = fs::getWorkDir() + "svi/" + sviList.getItem(i);
 
             size_t iconSize = fs::fsize(sviPath) - (sizeof(uint64_t) + sizeof(NacpStruct));
@@ -202,22 +335,11 @@ static void importSVIs()
 
             if(!titleIsLoaded(tid))
             {
-                nacpGetLanguageEntry(nacp, &ent);
-                memcpy(&data::titles[tid].nacp, nacp, sizeof(NacpStruct));
-                data::titles[tid].title = ent->name;
-                data::titles[tid].author = ent->author;
-                if(cfg::isDefined(tid))
-                    data::titles[tid].safeTitle = cfg::getPathDefinition(tid);
-                else if((data::titles[tid].safeTitle = util::safeString(ent->name)) == "")
-                    data::titles[tid].safeTitle = util::getIDStr(tid);
-
-                if(cfg::isFavorite(tid))
-                    data::titles[tid].fav = true;
-
-                if(!data::titles[tid].icon && iconSize > 0)
-                    data::titles[tid].icon = gfx::texMgr->textureLoadFromMem(IMG_FMT_JPG, iconBuffer, iconSize);
-                else if(!data::titles[tid].icon && iconSize == 0)
-                    data::titles[tid].icon = util::createIconGeneric(util::getIDStrLower(tid).c_str(), 32, true);
+                setTitleInfo(tid, data::titles[tid], nacp);
+                if(iconSize > 0)
+                    data::titleIconQueue(tid, TITLE_VERSION_NONE, iconBuffer, iconSize);
+                else
+                    data::titleIconGeneric(tid);
             }
             delete nacp;
             delete[] iconBuffer;
@@ -226,15 +348,95 @@ static void importSVIs()
     }
 }
 
+typedef struct
+{
+    uint64_t tid;
+    FsSaveDataInfo info;
+    PdmPlayStatistics playStats;
+} saveLoad;
+
+static inline uint64_t getSaveTID(const FsSaveDataInfo& info)
+{
+    if(info.save_data_type == FsSaveDataType_System || info.save_data_type == FsSaveDataType_SystemBcat)
+        return info.system_save_data_id;
+
+    return info.application_id;
+}
+
+static void loadPlayStats(saveLoad& save)
+{
+    memset(&save.playStats, 0, sizeof(PdmPlayStatistics));
+    if(save.info.save_data_type == FsSaveDataType_Account || save.info.save_data_type == FsSaveDataType_Device)
+        pdmqryQueryPlayStatisticsByApplicationIdAndUserAccountId(save.info.application_id, save.info.uid, false, &save.playStats);
+}
+
+static void loadPlayStats_t(unsigned i, void *a)
+{
+    loadPlayStats(((std::vector<saveLoad> *)a)->at(i));
+}
+
+//Saves not tied to an account go to one of the system users
+static void setSaveUser(FsSaveDataInfo& info)
+{
+    switch(info.save_data_type)
+    {
+        case FsSaveDataType_Bcat:
+            info.uid = util::u128ToAccountUID(2);
+            break;
+
+        case FsSaveDataType_Device:
+            info.uid = util::u128ToAccountUID(3);
+            break;
+
+        case FsSaveDataType_SystemBcat:
+            info.uid = util::u128ToAccountUID(4);
+            break;
+
+        case FsSaveDataType_Cache:
+            info.uid = util::u128ToAccountUID(5);
+            break;
+
+        case FsSaveDataType_Temporary:
+            info.uid = util::u128ToAccountUID(6);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static std::shared_ptr<data::userTitleInfo> newUserTitleInfo(const uint64_t& tid, const FsSaveDataInfo *_saveInfo, const PdmPlayStatistics *_stats)
+{
+    std::shared_ptr<data::userTitleInfo> ret = std::make_shared<data::userTitleInfo>();
+    ret->tid = tid;
+    ret->title = &data::titles[tid];
+    memcpy(&ret->saveInfo, _saveInfo, sizeof(FsSaveDataInfo));
+    ret->playStats.playtime = _stats->playtime;
+    ret->playStats.last_timestamp_user = _stats->last_timestamp_user;
+    ret->playStats.total_launches = _stats->total_launches;
+    return ret;
+}
+
+//Time since phaseStart in ms. Resets phaseStart for the next one
+static inline double phaseTime(uint64_t& phaseStart)
+{
+    uint64_t now = armGetSystemTick();
+    double ret = (double)armTicksToNs(now - phaseStart) / 1000000;
+    phaseStart = now;
+    return ret;
+}
+
 bool data::loadUsersTitles(bool clearUsers)
 {
     static unsigned systemUserCount = 4;
     FsSaveDataInfoReader it;
-    FsSaveDataInfo info;
     s64 total = 0;
+    uint64_t loadStart = armGetSystemTick(), phaseStart = loadStart;
 
-    loadTitlesFromRecords();
+    unsigned newTitles = loadTitlesFromRecords();
+    double recordsTime = phaseTime(phaseStart);
     importSVIs();
+    double sviTime = phaseTime(phaseStart);
 
     //Clear titles
     for(data::user& u : data::users)
@@ -250,102 +452,215 @@ bool data::loadUsersTitles(bool clearUsers)
         sysBCATPushed = false;
         tempPushed = false;
 
-        users.emplace_back(util::u128ToAccountUID(3), ui::getUIString("saveTypeMainMenu", 0), "Device");
-        users.emplace_back(util::u128ToAccountUID(2), ui::getUIString("saveTypeMainMenu", 1), "BCAT");
-        users.emplace_back(util::u128ToAccountUID(5), ui::getUIString("saveTypeMainMenu", 2), "Cache");
-        users.emplace_back(util::u128ToAccountUID(0), ui::getUIString("saveTypeMainMenu", 3), "System");
+        users.emplace_back(util::u128ToAccountUID(3), ui::getUIString(ui::str::saveTypeMainMenu, 0), "Device");
+        users.emplace_back(util::u128ToAccountUID(2), ui::getUIString(ui::str::saveTypeMainMenu, 1), "BCAT");
+        users.emplace_back(util::u128ToAccountUID(5), ui::getUIString(ui::str::saveTypeMainMenu, 2), "Cache");
+        users.emplace_back(util::u128ToAccountUID(0), ui::getUIString(ui::str::saveTypeMainMenu, 3), "System");
     }
 
+    //Everything is read up front, a batch at a time
+    std::vector<FsSaveDataInfo> infos;
+    FsSaveDataInfo *infoBatch = new FsSaveDataInfo[DATA_READ_BATCH];
     for(unsigned i = 0; i < 7; i++)
     {
         if(R_FAILED(fsOpenSaveDataInfoReader(&it, (FsSaveDataSpaceId)saveOrder[i])))
             continue;
 
-        while(R_SUCCEEDED(fsSaveDataInfoReaderRead(&it, &info, 1, &total)) && total != 0)
-        {
-            uint64_t tid = 0;
-            if(info.save_data_type == FsSaveDataType_System || info.save_data_type == FsSaveDataType_SystemBcat)
-                tid = info.system_save_data_id;
-            else
-                tid = info.application_id;
+        while(R_SUCCEEDED(fsSaveDataInfoReaderRead(&it, infoBatch, DATA_READ_BATCH, &total)) && total != 0)
+            infos.insert(infos.end(), infoBatch, infoBatch + total);
 
-            if(!titleIsLoaded(tid))
-                addTitleToList(tid);
+        fsSaveDataInfoReaderClose(&it);
+    }
+    delete[] infoBatch;
+    double readTime = phaseTime(phaseStart);
 
-            //Don't bother with this stuff
-            if(cfg::isBlacklisted(tid) || !accountSystemSaveCheck(info) || !testMount(info))
-                continue;
+    std::vector<uint64_t> saveTids;
+    saveTids.reserve(infos.size());
+    for(FsSaveDataInfo& info : infos)
+        saveTids.push_back(getSaveTID(info));
 
-            switch(info.save_data_type)
-            {
-                case FsSaveDataType_Bcat:
-                    info.uid = util::u128ToAccountUID(2);
-                    break;
-
-                case FsSaveDataType_Device:
-                    info.uid = util::u128ToAccountUID(3);
-                    break;
-
-                case FsSaveDataType_SystemBcat:
-                    info.uid = util::u128ToAccountUID(4);
-                    if(!sysBCATPushed)
-                    {
-                        ++systemUserCount;
-                        sysBCATPushed = true;
-                        users.emplace_back(util::u128ToAccountUID(4), ui::getUIString("saveTypeMainMenu", 4), "System BCAT");
-                    }
-                    break;
-
-                case FsSaveDataType_Cache:
-                    info.uid = util::u128ToAccountUID(5);
-                    break;
-
-                case FsSaveDataType_Temporary:
-                    info.uid = util::u128ToAccountUID(6);
-                    if(!tempPushed)
-                    {
-                        ++systemUserCount;
-                        tempPushed = true;
-                        users.emplace_back(util::u128ToAccountUID(6), ui::getUIString("saveTypeMainMenu", 5), "Temporary");
-                    }
-                    break;
-            }
+    newTitles += addTitlesToList(saveTids);
+    double titlesTime = phaseTime(phaseStart);
 
-            int u = getUserIndex(info.uid);
-            if(u == -1)
-            {
-                users.emplace(data::users.end() - systemUserCount, info.uid, "", "");
-                u = getUserIndex(info.uid);
-            }
+    //Mounting stays on this thread
+    std::vector<saveLoad> saves;
+    saves.reserve(infos.size());
+    for(FsSaveDataInfo& info : infos)
+    {
+        uint64_t tid = getSaveTID(info);
+
+        //Don't bother with this stuff
+        if(cfg::isBlacklisted(tid) || !accountSystemSaveCheck(info) || !testMount(info))
+            continue;
 
-            PdmPlayStatistics playStats;
-            if(info.save_data_type == FsSaveDataType_Account || info.save_data_type == FsSaveDataType_Device)
-                pdmqryQueryPlayStatisticsByApplicationIdAndUserAccountId(info.application_id, info.uid, false, &playStats);
-            else
-                memset(&playStats, 0, sizeof(PdmPlayStatistics));
-            users[u].addUserTitleInfo(tid, &info, &playStats);
+        setSaveUser(info);
+        if(info.save_data_type == FsSaveDataType_SystemBcat && !sysBCATPushed)
+        {
+            ++systemUserCount;
+            sysBCATPushed = true;
+            users.emplace_back(util::u128ToAccountUID(4), ui::getUIString(ui::str::saveTypeMainMenu, 4), "System BCAT");
         }
-        fsSaveDataInfoReaderClose(&it);
+        else if(info.save_data_type == FsSaveDataType_Temporary && !tempPushed)
+        {
+            ++systemUserCount;
+            tempPushed = true;
+            users.emplace_back(util::u128ToAccountUID(6), ui::getUIString(ui::str::saveTypeMainMenu, 5), "Temporary");
+        }
+
+        saveLoad save;
+        save.tid = tid;
+        save.info = info;
+        saves.push_back(save);
     }
+    double mountTime = phaseTime(phaseStart);
 
-    if(cfg::config["incDev"])
+    runParallel(saves.size(), loadPlayStats_t, &saves);
+    double statsTime = phaseTime(phaseStart);
+
+    for(saveLoad& save : saves)
+    {
+        int u = getUserIndex(save.info.uid);
+        if(u == -1)
+        {
+            users.emplace(data::users.end() - systemUserCount, save.info.uid, "", "");
+            u = getUserIndex(save.info.uid);
+        }
+        users[u].addUserTitleInfo(save.tid, &save.info, &save.playStats);
+    }
+
+    if(cfg::config[cfg::INC_DEV])
     {
         //Get reference to device save user
         unsigned devPos = getUserIndex(util::u128ToAccountUID(3));
         data::user& dev = data::users[devPos];
         for(unsigned i = 0; i < devPos; i++)
         {
-            //Not needed but makes this easier to read
+            //Not needed but makes this easier to read. Entries are shared, not copied
             data::user& u = data::users[i];
             u.titleInfo.insert(u.titleInfo.end(), dev.titleInfo.begin(), dev.titleInfo.end());
         }
     }
 
     data::sortUserTitles();
+    double sortTime = phaseTime(phaseStart);
+
+    fs::logWrite("Title load: records %.1fms, svi %.1fms, save info %.1fms (%u saves), titles %.1fms (%u new), mount test %.1fms, play stats %.1fms, sort %.1fms, total %.1fms\n",
+                 recordsTime, sviTime, readTime, (unsigned)infos.size(), titlesTime, newTitles, mountTime, statsTime, sortTime,
+                 (double)armTicksToNs(armGetSystemTick() - loadStart) / 1000000);
+
+    data::titleCacheFlush();
+
+    return true;
+}
+
+//Puts _entry where sortTitles wants it and records the change
+static void insertSorted(unsigned _user, const std::shared_ptr<data::userTitleInfo>& _entry, std::vector<data::titleListChange>& _changes)
+{
+    std::vector<std::shared_ptr<data::userTitleInfo>>& titleInfo = data::users[_user].titleInfo;
+    auto pos = titleInfo.insert(std::upper_bound(titleInfo.begin(), titleInfo.end(), _entry, sortTitles), _entry);
+    _changes.push_back({ _user, (unsigned)(pos - titleInfo.begin()), _entry->tid, true });
+}
+
+//Last to first so each recorded position is still right when the changes are replayed in order
+static void removeMatching(bool (*match)(const data::userTitleInfo&, uint64_t), uint64_t _val, std::vector<data::titleListChange>& _changes)
+{
+    for(unsigned i = 0; i < data::users.size(); i++)
+    {
+        std::vector<std::shared_ptr<data::userTitleInfo>>& titleInfo = data::users[i].titleInfo;
+        for(int j = titleInfo.size() - 1; j >= 0; j--)
+        {
+            if((*match)(*titleInfo[j], _val))
+            {
+                _changes.push_back({ i, (unsigned)j, titleInfo[j]->tid, false });
+                titleInfo.erase(titleInfo.begin() + j);
+            }
+        }
+    }
+}
+
+static bool matchSaveID(const data::userTitleInfo& _info, uint64_t _saveID)
+{
+    return _info.saveInfo.save_data_id == _saveID;
+}
+
+static bool matchTID(const data::userTitleInfo& _info, uint64_t _tid)
+{
+    return _info.tid == _tid;
+}
+
+bool data::addUserSave(const FsSaveDataAttribute& _attr, std::vector<titleListChange>& _changes)
+{
+    FsSaveDataFilter filter;
+    memset(&filter, 0, sizeof(FsSaveDataFilter));
+    filter.filter_by_application_id = true;
+    filter.filter_by_save_data_type = true;
+    filter.filter_by_user_id = _attr.save_data_type == FsSaveDataType_Account;
+    filter.filter_by_index = _attr.save_data_type == FsSaveDataType_Cache;
+    filter.attr = _attr;
+
+    s64 count = 0;
+    saveLoad save;
+    if(R_FAILED(fsFindSaveDataWithFilter(&count, &save.info, 1, FsSaveDataSpaceId_User, &filter)) || count == 0)
+        return false;
+
+    save.tid = getSaveTID(save.info);
+    addTitlesToList(std::vector<uint64_t>{ save.tid });
+
+    //Nothing to show, nothing to do
+    if(cfg::isBlacklisted(save.tid) || !accountSystemSaveCheck(save.info) || !testMount(save.info))
+        return true;
+
+    setSaveUser(save.info);
+    int u = getUserIndex(save.info.uid);
+    if(u == -1)
+        return false;
+
+    loadPlayStats(save);
+    std::shared_ptr<data::userTitleInfo> entry = newUserTitleInfo(save.tid, &save.info, &save.playStats);
+    insertSorted(u, entry, _changes);
+
+    //Accounts come before the device user
+    if(save.info.save_data_type == FsSaveDataType_Device && cfg::config[cfg::INC_DEV])
+    {
+        for(int i = 0; i < u; i++)
+            insertSorted(i, entry, _changes);
+    }
 
     return true;
 }
 
+void data::removeUserSave(uint64_t _saveID, std::vector<titleListChange>& _changes)
+{
+    removeMatching(matchSaveID, _saveID, _changes);
+}
+
+void data::removeUserTitle(const uint64_t& tid, std::vector<titleListChange>& _changes)
+{
+    removeMatching(matchTID, tid, _changes);
+}
+
+void data::resortTitle(const uint64_t& tid, std::vector<titleListChange>& _changes)
+{
+    data::titles[tid].fav = cfg::isFavorite(tid);
+    for(unsigned i = 0; i < data::users.size(); i++)
+    {
+        std::vector<std::shared_ptr<data::userTitleInfo>>& titleInfo = data::users[i].titleInfo;
+        std::vector<std::shared_ptr<data::userTitleInfo>> moved;
+        for(int j = titleInfo.size() - 1; j >= 0; j--)
+        {
+            if(titleInfo[j]->tid == tid)
+            {
+                _changes.push_back({ i, (unsigned)j, tid, false });
+                moved.push_back(titleInfo[j]);
+                titleInfo.erase(titleInfo.begin() + j);
+            }
+        }
+
+        for(std::shared_ptr<data::userTitleInfo>& entry : moved)
+            insertSorted(i, entry, _changes);
+    }
+}
+
 void data::sortUserTitles()
 {
 
@@ -355,12 +670,15 @@ void data::sortUserTitles()
 
 void data::init()
 {
+    data::titleCacheOpen();
+    data::titleIconInit();
     data::loadUsersTitles(true);
 }
 
 void data::exit()
 {
-    /*Still needed for planned future revisions*/
+    data::titleIconExit();
+    data::titleCacheClose();
 }
 
 void data::setUserIndex(unsigned _sUser)
@@ -385,7 +703,7 @@ void data::setTitleIndex(unsigned _sTitle)
 
 data::userTitleInfo *data::getCurrentUserTitleInfo()
 {
-    return &users[selUser].titleInfo[selData];
+    return users[selUser].titleInfo[selData].get();
 }
 
 unsigned data::getCurrentUserTitleInfoIndex()
@@ -412,14 +730,19 @@ std::string data::getTitleSafeNameByTID(const uint64_t& tid)
 
 SDL_Texture *data::getTitleIconByTID(const uint64_t& tid)
 {
-    return titles[tid].icon;
+    //Can be evicted, so this is asked for every time it's drawn and that counts as using it
+    SDL_Texture *icon = titles[tid].icon;
+    if(icon)
+        gfx::texMgr->textureTouch(icon);
+
+    return icon;
 }
 
 int data::getTitleIndexInUser(const data::user& u, const uint64_t& tid)
 {
     for(unsigned i = 0; i < u.titleInfo.size(); i++)
     {
-        if(u.titleInfo[i].tid == tid)
+        if(u.titleInfo[i]->tid == tid)
             return i;
     }
     return -1;
@@ -477,11 +800,7 @@ void data::user::setUID(const AccountUid& _id)
 
 void data::user::addUserTitleInfo(const uint64_t& tid, const FsSaveDataInfo *_saveInfo, const PdmPlayStatistics *_stats)
 {
-    data::userTitleInfo newInfo;
-    newInfo.tid = tid;
-    memcpy(&newInfo.saveInfo, _saveInfo, sizeof(FsSaveDataInfo));
-    memcpy(&newInfo.playStats, _stats, sizeof(PdmPlayStatistics));
-    titleInfo.push_back(newInfo);
+    titleInfo.push_back(newUserTitleInfo(tid, _saveInfo, _stats));
 }
 
 static const SDL_Color green = {0x00, 0xDD, 0x00, 0xFF};
@@ -492,12 +811,15 @@ void data::dispStats()
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
 
     //Easiest/laziest way to do this
-    std::string stats = ui::getUICString("debugStatus", 0) + std::to_string(users.size()) + "\n";
+    std::string stats = ui::getUICString(ui::str::debugStatus, 0) + std::to_string(users.size()) + "\n";
     for(data::user& u : data::users)
         stats += u.getUsername() + ": " + std::to_string(u.titleInfo.size()) + "\n";
-    stats += ui::getUICString("debugStatus", 1) + cu->getUsername() + "\n";
-    stats += ui::getUICString("debugStatus", 2) + data::getTitleNameByTID(d->tid) + "\n";
-    stats += ui::getUICString("debugStatus", 3) + data::getTitleSafeNameByTID(d->tid) + "\n";
-    stats += ui::getUICString("debugStatus", 4) + std::to_string(cfg::sortType) + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 1) + cu->getUsername() + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 2) + data::getTitleNameByTID(d->tid) + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 3) + data::getTitleSafeNameByTID(d->tid) + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 4) + std::to_string(cfg::sortType) + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 5) + std::to_string(gfx::texMgr->getCount()) + ", "
+             + util::getSizeString(gfx::texMgr->getUsed()) + " / " + util::getSizeString(gfx::texMgr->getBudget()) + "\n";
+    stats += ui::getUICString(ui::str::debugStatus, 6) + std::to_string(gfx::texMgr->getEvictCount()) + "\n";
     gfx::drawTextf(NULL, 16, 2, 2, &green, stats.c_str());
 }
\ No newline at end of file
@@ -97,7 +97,7 @@ bool fs::commitToDevice(const std::string& dev)
     if(R_FAILED(res))
     {
         fs::logWrite("Error committing file to device -> 0x%X\n", res);
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popErrorCommittingFile", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popErrorCommittingFile, 0));
         ret = false;
     }
     return ret;
@@ -143,11 +143,11 @@ void fs::createSaveData(FsSaveDataType _type, uint64_t _tid, AccountUid _uid, th
 {
     data::titleInfo *tinfo = data::getTitleInfoByTID(_tid);
     if(t)
-        t->status->setStatus(ui::getUICString("threadStatusCreatingSaveData", 0), tinfo->title.c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusCreatingSaveData, 0), tinfo->title.c_str());
 
     uint16_t cacheIndex = 0;
     std::string indexStr;
-    if(_type == FsSaveDataType_Cache && !(indexStr = util::getStringInput(SwkbdType_NumPad, "0", ui::getUIString("swkbdSaveIndex", 0), 2, 0, NULL)).empty())
+    if(_type == FsSaveDataType_Cache && !(indexStr = util::getStringInput(SwkbdType_NumPad, "0", ui::getUIString(ui::str::swkbdSaveIndex, 0), 2, 0, NULL)).empty())
         cacheIndex = strtoul(indexStr.c_str(), NULL, 10);
     else if(_type == FsSaveDataType_Cache && indexStr.empty())
     {
@@ -218,12 +218,18 @@ void fs::createSaveData(FsSaveDataType _type, uint64_t _tid, AccountUid _uid, th
     if(R_SUCCEEDED(res = fsCreateSaveDataFileSystem(&attr, &crt, &meta)))
     {
         util::createTitleDirectoryByTID(_tid);
-        data::loadUsersTitles(false);
-        ui::ttlRefresh();
+        std::vector<data::titleListChange> changes;
+        if(data::addUserSave(attr, changes))
+            ui::ttlApplyChanges(changes);
+        else
+        {
+            data::loadUsersTitles(false);
+            ui::ttlRefresh();
+        }
     }
     else
     {
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataCreationFailed", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataCreationFailed, 0));
         fs::logWrite("SaveCreate Failed -> %X\n", res);
     }
 }
@@ -249,7 +255,7 @@ void fs::createSaveDataThreaded(FsSaveDataType _type, uint64_t _tid, AccountUid
 bool fs::extendSaveData(const data::userTitleInfo *tinfo, uint64_t extSize, threadInfo *t)
 {
     if(t)
-        t->status->setStatus(ui::getUICString("threadStatusExtendingSaveData", 0), data::getTitleNameByTID(tinfo->tid).c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusExtendingSaveData, 0), data::getTitleNameByTID(tinfo->tid).c_str());
 
     uint64_t journal = fs::getJournalSizeMax(tinfo);
     uint64_t saveID  = tinfo->saveInfo.save_data_id;
@@ -263,7 +269,7 @@ bool fs::extendSaveData(const data::userTitleInfo *tinfo, uint64_t extSize, thre
         fs::unmountSave();
 
         fs::logWrite("Extend Failed: %uMB to %uMB -> %X\n", totalSize / 1024 / 1024, extSize / 1024 / 1024, res);
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataExtendFailed", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataExtendFailed, 0));
         return false;
     }
     return true;
@@ -360,7 +366,7 @@ uint64_t fs::getJournalSizeMax(const data::userTitleInfo *tinfo)
 static void wipeSave_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("threadStatusResettingSaveData", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusResettingSaveData, 0));
     fs::delDir("sv:/");
     fs::commitToDevice("sv");
     t->finished = true;
@@ -371,11 +377,94 @@ void fs::wipeSave()
     ui::newThread(wipeSave_t, NULL, NULL);
 }
 
+//Queues a finished backup for upload when autoUpload is on. Folders are zipped first and the zip is removed once it's sent
+static void autoUploadBackup(const std::string& _path, uint64_t _tid, fs::transferPriority _priority, threadInfo *t)
+{
+    if(!cfg::config[cfg::AUTO_UPLOAD] || !fs::rfs)
+        return;
+
+    std::string path = _path, name;
+    bool isTemp = false;
+    if(path.back() == '/')
+        path.erase(path.length() - 1);
+
+    if(fs::isDir(path))
+    {
+        name = util::getFilenameFromPath(path) + ".zip";
+        if(t)
+            t->status->setStatus(ui::getUICString(ui::str::threadStatusCompressingSaveForUpload, 0), name.c_str());
+
+        std::string tmpZip = fs::transferGetScratchPath(_tid, name);
+        int zipTrim = util::getTotalPlacesInPath(fs::getWorkDir()) + 2;//Trim path down to save root
+        zipFile zip = zipOpen64(tmpZip.c_str(), 0);
+        fs::copyDirToZip(path + "/", zip, true, zipTrim, NULL);
+        zipClose(zip, NULL);
+        path = tmpZip;
+        isTemp = true;
+    }
+    else
+        name = util::getFilenameFromPath(path);
+
+    fs::transferAdd(fs::TRANSFER_UPLOAD, _priority, path, data::getTitleInfoByTID(_tid)->title, name, fs::fsize(path), isTemp);
+}
+
+//Runs after the threaded copy that makes the backup, so the backup is complete by now
+static void autoUpload_t(void *a)
+{
+    threadInfo *t = (threadInfo *)a;
+    std::string *path = (std::string *)t->argPtr;
+    autoUploadBackup(*path, data::getCurrentUserTitleInfo()->tid, fs::TRANSFER_PRIORITY_UPLOAD, t);
+    delete path;
+    t->finished = true;
+}
+
+static void autoUploadThreaded(const std::string& _path)
+{
+    if(cfg::config[cfg::AUTO_UPLOAD] && fs::rfs)
+        ui::newThread(autoUpload_t, new std::string(_path), NULL);
+}
+
+//Dumps one title's save for batch dumps and queues it behind the others. Holds off while too much is waiting to be uploaded.
+//Returns false once the dump should stop
+static bool dumpTitleSave(data::user *u, data::userTitleInfo& _tinfo, threadInfo *t)
+{
+    bool saveMounted = fs::mountSave(_tinfo.saveInfo);
+    util::createTitleDirectoryByTID(_tinfo.tid);
+    std::string dst;
+    if(saveMounted && fs::dirNotEmpty("sv:/") && cfg::config[cfg::ZIP])
+    {
+        fs::loadPathFilters(_tinfo.tid);
+        dst = util::generatePathByTID(_tinfo.tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + ".zip";
+        zipFile zip = zipOpen64(dst.c_str(), 0);
+        fs::copyDirToZip("sv:/", zip, false, 0, t);
+        zipClose(zip, NULL);
+        fs::freePathFilters();
+    }
+    else if(saveMounted && fs::dirNotEmpty("sv:/"))
+    {
+        fs::loadPathFilters(_tinfo.tid);
+        dst = util::generatePathByTID(_tinfo.tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + "/";
+        fs::mkDir(dst.substr(0, dst.length() - 1));
+        fs::copyDirToDir("sv:/", dst, t);
+        fs::freePathFilters();
+    }
+    fs::unmountSave();
+
+    //Uploads of earlier titles keep going while the next one is dumped
+    if(!dst.empty() && cfg::config[cfg::AUTO_UPLOAD] && fs::rfs)
+    {
+        autoUploadBackup(dst, _tinfo.tid, fs::TRANSFER_PRIORITY_BULK, t);
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusWaitingForUploads, 0));
+        return fs::transferWaitBacklog(fs::TRANSFER_PRIORITY_BULK, TRANSFER_BACKLOG_LIMIT, &t->cancel);
+    }
+    return !t->cancel;
+}
+
 void fs::createNewBackup(void *a)
 {
     if(!fs::dirNotEmpty("sv:/"))
     {
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popSaveIsEmpty", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popSaveIsEmpty, 0));
         return;
     }
 
@@ -387,7 +476,7 @@ void fs::createNewBackup(void *a)
 
     std::string out;
 
-    if(held & HidNpadButton_R || cfg::config["autoName"])
+    if(held & HidNpadButton_R || cfg::config[cfg::AUTO_NAME])
         out = u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD);
     else if(held & HidNpadButton_L)
         out = u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YDM);
@@ -408,7 +497,7 @@ void fs::createNewBackup(void *a)
             ".zip"
         };
         std::string defaultText = u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD);
-        out = util::getStringInput(SwkbdType_QWERTY, defaultText, ui::getUIString("swkbdEnterName", 0), 64, 9, dict);
+        out = util::getStringInput(SwkbdType_QWERTY, defaultText, ui::getUIString(ui::str::swkbdEnterName, 0), 64, 9, dict);
         out = util::safeString(out);
     }
 
@@ -416,7 +505,7 @@ void fs::createNewBackup(void *a)
     {
         std::string ext = util::getExtensionFromString(out);
         std::string path = util::generatePathByTID(d->tid) + out;
-        if(cfg::config["zip"] || ext == "zip")
+        if(cfg::config[cfg::ZIP] || ext == "zip")
         {
             if(ext != "zip")//data::zip is on but extension is not zip
                 path += ".zip";
@@ -431,6 +520,7 @@ void fs::createNewBackup(void *a)
             path += "/";
             fs::copyDirToDirThreaded("sv:/", path);
         }
+        autoUploadThreaded(path);
         ui::fldRefreshMenu();
     }
 }
@@ -446,12 +536,14 @@ void fs::overwriteBackup(void *a)
         fs::mkDir(*dst);
         dst->append("/");
         fs::copyDirToDirThreaded("sv:/", *dst);
+        autoUploadThreaded(*dst);
     }
     else if(!fs::isDir(*dst) && util::getExtensionFromString(*dst) == "zip" && saveHasFiles)
     {
         fs::delfile(*dst);
         zipFile zip = zipOpen64(dst->c_str(), 0);
         fs::copyDirToZipThreaded("sv:/", zip, false, 0);
+        autoUploadThreaded(*dst);
     }
     delete dst;
     t->finished = true;
@@ -463,16 +555,16 @@ void fs::restoreBackup(void *a)
     std::string *restore = (std::string *)t->argPtr;
     data::user *u = data::getCurrentUser();
     data::userTitleInfo *utinfo = data::getCurrentUserTitleInfo();
-    if((utinfo->saveInfo.save_data_type != FsSaveDataType_System || cfg::config["sysSaveWrite"]))
+    if((utinfo->saveInfo.save_data_type != FsSaveDataType_System || cfg::config[cfg::SYS_SAVE_WRITE]))
     {
         bool saveHasFiles = fs::dirNotEmpty("sv:/");
-        if(cfg::config["autoBack"] && cfg::config["zip"] && saveHasFiles)
+        if(cfg::config[cfg::AUTO_BACK] && cfg::config[cfg::ZIP] && saveHasFiles)
         {
             std::string autoZip = util::generatePathByTID(utinfo->tid) + "/AUTO " + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + ".zip";
             zipFile zip = zipOpen64(autoZip.c_str(), 0);
             fs::copyDirToZipThreaded("sv:/", zip, false, 0);
         }
-        else if(cfg::config["autoBack"] && saveHasFiles)
+        else if(cfg::config[cfg::AUTO_BACK] && saveHasFiles)
         {
             std::string autoFolder = util::generatePathByTID(utinfo->tid) + "/AUTO - " + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + "/";
             fs::mkDir(autoFolder.substr(0, autoFolder.length() - 1));
@@ -484,7 +576,7 @@ void fs::restoreBackup(void *a)
             restore->append("/");
             if(fs::dirNotEmpty(*restore))
             {
-                t->status->setStatus(ui::getUICString("threadStatusCalculatingSaveSize", 0));
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusCalculatingSaveSize, 0));
                 unsigned dirCount = 0, fileCount = 0;
                 uint64_t saveSize = 0;
                 int64_t  availSize = 0;
@@ -502,14 +594,14 @@ void fs::restoreBackup(void *a)
                 fs::copyDirToDirCommitThreaded(*restore, "sv:/", "sv");
             }
             else
-                ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popFolderIsEmpty", 0));
+                ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popFolderIsEmpty, 0));
         }
         else if(!fs::isDir(*restore) && util::getExtensionFromString(*restore) == "zip")
         {
             unzFile unz = unzOpen64(restore->c_str());
             if(unz && fs::zipNotEmpty(unz))
             {
-                t->status->setStatus(ui::getUICString("threadStatusCalculatingSaveSize", 0));
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusCalculatingSaveSize, 0));
                 uint64_t saveSize = fs::getZipTotalSize(unz);
                 int64_t  availSize  = 0;
                 fsFsGetTotalSpace(fsdevGetDeviceFileSystem("sv"), "/", &availSize);
@@ -526,7 +618,7 @@ void fs::restoreBackup(void *a)
             }
             else
             {
-                ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popZipIsEmpty", 0));
+                ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popZipIsEmpty, 0));
                 unzClose(unz);
             }
         }
@@ -536,7 +628,7 @@ void fs::restoreBackup(void *a)
             fs::copyFileCommitThreaded(*restore, dstPath, "sv");
         }
     }
-    if(cfg::config["autoBack"])
+    if(cfg::config[cfg::AUTO_BACK])
         ui::fldRefreshMenu();
 
     delete restore;
@@ -549,9 +641,9 @@ void fs::deleteBackup(void *a)
     std::string *deletePath = (std::string *)t->argPtr;
     std::string backupName = util::getFilenameFromPath(*deletePath);
 
-    t->status->setStatus(ui::getUICString("threadStatusDeletingFile", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
     data::userTitleInfo *utinfo = data::getCurrentUserTitleInfo();
-    if(cfg::config["trashBin"])
+    if(cfg::config[cfg::TRASH_BIN])
     {
         std::string oldPath = *deletePath;
         std::string trashPath = wd + "_TRASH_/" + data::getTitleSafeNameByTID(utinfo->tid);
@@ -559,18 +651,18 @@ void fs::deleteBackup(void *a)
         trashPath += "/" + backupName;
 
         rename(oldPath.c_str(), trashPath.c_str());
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataBackupMovedToTrash", 0), backupName.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataBackupMovedToTrash, 0), backupName.c_str());
     }
     else if(fs::isDir(*deletePath))
     {
         *deletePath += "/";
         fs::delDir(*deletePath);
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataBackupDeleted", 0), backupName.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataBackupDeleted, 0), backupName.c_str());
     }
     else
     {
         fs::delfile(*deletePath);
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataBackupDeleted", 0), backupName.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataBackupDeleted, 0), backupName.c_str());
     }
     ui::fldRefreshMenu();
     delete deletePath;
@@ -586,27 +678,10 @@ void fs::dumpAllUserSaves(void *a)
 
     for(unsigned i = 0; i < u->titleInfo.size(); i++)
     {
-        bool saveMounted = fs::mountSave(u->titleInfo[i].saveInfo);
-        util::createTitleDirectoryByTID(u->titleInfo[i].tid);
-        if(saveMounted && fs::dirNotEmpty("sv:/") && cfg::config["zip"])
-        {
-            fs::loadPathFilters(u->titleInfo[i].tid);
-            std::string dst = util::generatePathByTID(u->titleInfo[i].tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + ".zip";
-            zipFile zip = zipOpen64(dst.c_str(), 0);
-            fs::copyDirToZip("sv:/", zip, false, 0, t);
-            zipClose(zip, NULL);
-            fs::freePathFilters();
-        }
-        else if(saveMounted && fs::dirNotEmpty("sv:/"))
-        {
-            fs::loadPathFilters(u->titleInfo[i].tid);
-            std::string dst = util::generatePathByTID(u->titleInfo[i].tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + "/";
-            fs::mkDir(dst.substr(0, dst.length() - 1));
-            fs::copyDirToDir("sv:/", dst, t);
-            fs::freePathFilters();
-        }
-        fs::unmountSave();
+        if(!dumpTitleSave(u, *u->titleInfo[i], t))
+            break;
     }
+
     fs::copyArgsDestroy(c);
     t->finished = true;
 }
@@ -616,33 +691,14 @@ void fs::dumpAllUsersAllSaves(void *a)
     threadInfo *t = (threadInfo *)a;
     fs::copyArgs *c = fs::copyArgsCreate("", "", "", NULL, NULL, false, false, 0);
     t->argPtr = c;
+
     unsigned curUser = 0;
-    while(data::users[curUser].getUID128() != 2)
+    bool keepGoing = true;
+    while(keepGoing && data::users[curUser].getUID128() != 2)
     {
         data::user *u = &data::users[curUser++];
-        for(unsigned i = 0; i < u->titleInfo.size(); i++)
-        {
-            bool saveMounted = fs::mountSave(u->titleInfo[i].saveInfo);
-            util::createTitleDirectoryByTID(u->titleInfo[i].tid);
-            if(saveMounted && fs::dirNotEmpty("sv:/") && cfg::config["zip"])
-            {
-                fs::loadPathFilters(u->titleInfo[i].tid);
-                std::string dst = util::generatePathByTID(u->titleInfo[i].tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + ".zip";
-                zipFile zip = zipOpen64(dst.c_str(), 0);
-                fs::copyDirToZip("sv:/", zip, false, 0, t);
-                zipClose(zip, NULL);
-                fs::freePathFilters();
-            }
-            else if(saveMounted && fs::dirNotEmpty("sv:/"))
-            {
-                fs::loadPathFilters(u->titleInfo[i].tid);
-                std::string dst = util::generatePathByTID(u->titleInfo[i].tid) + u->getUsernameSafe() + " - " + util::getDateTime(util::DATE_FMT_YMD) + "/";
-                fs::mkDir(dst.substr(0, dst.length() - 1));
-                fs::copyDirToDir("sv:/", dst, t);
-                fs::freePathFilters();
-            }
-            fs::unmountSave();
-        }
+        for(unsigned i = 0; keepGoing && i < u->titleInfo.size(); i++)
+            keepGoing = dumpTitleSave(u, *u->titleInfo[i], t);
     }
     fs::copyArgsDestroy(c);
     t->finished = true;
@@ -25,7 +25,7 @@ static struct
 
 void fs::mkDir(const std::string& _p)
 {
-     if(cfg::config["directFsCmd"])
+     if(cfg::config[cfg::DIRECT_FS_CMD])
         fsMkDir(_p.c_str());
     else
         mkdir(_p.c_str(), 777);
@@ -82,7 +82,7 @@ bool fs::isDir(const std::string& _path)
 void fs::copyDirToDir(const std::string& src, const std::string& dst, threadInfo *t)
 {
     if(t)
-        t->status->setStatus(ui::getUICString("threadStatusOpeningFolder", 0), src.c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusOpeningFolder, 0), src.c_str());
 
     fs::dirList *list = new fs::dirList(src);
     for(unsigned i = 0; i < list->getCount(); i++)
@@ -103,7 +103,7 @@ void fs::copyDirToDir(const std::string& src, const std::string& dst, threadInfo
             std::string fullDst = dst + list->getItem(i);
 
             if(t)
-                t->status->setStatus(ui::getUICString("threadStatusCopyingFile", 0), fullSrc.c_str());
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusCopyingFile, 0), fullSrc.c_str());
 
             fs::copyFile(fullSrc, fullDst, t);
         }
@@ -130,7 +130,7 @@ void fs::copyDirToDirThreaded(const std::string& src, const std::string& dst)
 void fs::copyDirToDirCommit(const std::string& src, const std::string& dst, const std::string& dev, threadInfo *t)
 {
     if(t)
-        t->status->setStatus(ui::getUICString("threadStatusOpeningFolder", 0), src.c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusOpeningFolder, 0), src.c_str());
 
     fs::dirList *list = new fs::dirList(src);
     for(unsigned i = 0; i < list->getCount(); i++)
@@ -151,7 +151,7 @@ void fs::copyDirToDirCommit(const std::string& src, const std::string& dst, cons
             std::string fullDst = dst + list->getItem(i);
 
             if(t)
-                t->status->setStatus(ui::getUICString("threadStatusCopyingFile", 0), fullSrc.c_str());
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusCopyingFile, 0), fullSrc.c_str());
 
             fs::copyFileCommit(fullSrc, fullDst, dev, t);
         }
@@ -149,7 +149,10 @@ void fs::dataFile::procLine()
         name.assign(line.begin(), line.begin() + lPos);
     }
     else
+    {
         name = line;
+        lPos = line.size();
+    }
 
     util::stripChar(' ', name);
     ++lPos;
@@ -160,13 +163,26 @@ std::string fs::dataFile::getNextValueStr()
     std::string ret = "";
     //Skip all spaces until we hit actual text
     size_t pos1 = line.find_first_not_of(", ", lPos);
+    if(pos1 == line.npos)
+    {
+        lPos = line.size();
+        return ret;
+    }
+
     //If reading from quotes
     if(line[pos1] == '"')
         lPos = line.find_first_of('"', ++pos1);
     else
-        lPos = line.find_first_of(",;\n", pos1);//Set lPos to end of string we want. This should just set lPos to the end of the line if it fails, which is ok
+        lPos = line.find_first_of(",;\n", pos1);
 
-    ret = line.substr(pos1, lPos++ - pos1);
+    //Last value on the line. lPos stays at the end so nothing else is read from it
+    if(lPos == line.npos)
+    {
+        ret = line.substr(pos1);
+        lPos = line.size();
+    }
+    else
+        ret = line.substr(pos1, lPos++ - pos1);
 
     util::replaceStr(ret, "\\n", "\n");
 
@@ -185,6 +201,226 @@ int fs::dataFile::getNextValueInt()
     return ret;
 }
 
+//Compiled copies of text files go here as <file name>.bin
+#define DATA_BLOB_DIR "sdmc:/config/JKSV/"
+#define DATA_BLOB_MAGIC 0x424B534A
+#define DATA_BLOB_REV 3
+
+typedef struct
+{
+    uint32_t magic, rev;
+    uint32_t lineCount;
+    //Source size and mtime, or the build stamp for romfs
+    uint64_t srcSize, srcStamp, dataSize;
+} dataBlobHeader;
+
+//Only a stat, so checking the blob costs nothing next to parsing. romfs has no timestamps, but it only changes with a new build
+static bool dataBlobSourceStamp(const std::string& _path, uint64_t& _size, uint64_t& _stamp)
+{
+    struct stat s;
+    if(stat(_path.c_str(), &s) != 0)
+        return false;
+
+    _size = s.st_size;
+    if(_path.compare(0, 6, "romfs:") != 0)
+    {
+        _stamp = s.st_mtime;
+        return true;
+    }
+
+    static const char build[] = __DATE__ " " __TIME__;
+    _stamp = ((uint64_t)BLD_YEAR << 48) | ((uint64_t)BLD_MON << 40) | ((uint64_t)BLD_DAY << 32);
+    uint32_t hash = 0x811C9DC5;
+    for(const char *c = build; *c; c++)
+        hash = (hash ^ *c) * 0x01000193;
+
+    _stamp |= hash;
+    return true;
+}
+
+fs::dataBlob::dataBlob(const std::string& _path, bool _cache)
+{
+    uint64_t srcSize = 0, srcStamp = 0;
+    if(!dataBlobSourceStamp(_path, srcSize, srcStamp))
+        return;
+
+    std::string blobPath = DATA_BLOB_DIR + util::getFilenameFromPath(_path) + ".bin";
+    if(_cache && readBlob(blobPath, srcSize, srcStamp))
+    {
+        opened = true;
+        return;
+    }
+
+    fs::dataFile text(_path);
+    if(!text.isOpen())
+        return;
+
+    while(text.readNextLine(true))
+    {
+        dataLine add;
+        add.name = text.getName();
+        while(text.hasNextValue())
+            add.values.push_back(text.getNextValueStr());
+
+        lines.push_back(add);
+    }
+    opened = true;
+
+    if(_cache)
+        writeBlob(blobPath, srcSize, srcStamp);
+}
+
+bool fs::dataBlob::readNextLine()
+{
+    if(cur >= lines.size())
+        return false;
+
+    ++cur;
+    val = 0;
+    return true;
+}
+
+std::string fs::dataBlob::getNextValueStr()
+{
+    std::vector<std::string>& values = lines[cur - 1].values;
+    return val < values.size() ? values[val++] : "";
+}
+
+int fs::dataBlob::getNextValueInt()
+{
+    std::string no = getNextValueStr();
+    if(no[0] == '0' && tolower(no[1]) == 'x')
+        return strtoul(no.c_str(), NULL, 16);
+
+    return strtoul(no.c_str(), NULL, 10);
+}
+
+//Length prefixed string. Returns false if it runs past end
+static bool dataBlobReadStr(const uint8_t *&pos, const uint8_t *end, std::string& _out)
+{
+    uint32_t len;
+    if(end - pos < (ptrdiff_t)sizeof(uint32_t))
+        return false;
+
+    memcpy(&len, pos, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    if((uint64_t)(end - pos) < len)
+        return false;
+
+    _out.assign((const char *)pos, len);
+    pos += len;
+    return true;
+}
+
+static void dataBlobWriteStr(std::vector<uint8_t>& _out, const std::string& _str)
+{
+    uint32_t len = _str.size();
+    _out.insert(_out.end(), (const uint8_t *)&len, (const uint8_t *)&len + sizeof(uint32_t));
+    _out.insert(_out.end(), _str.begin(), _str.end());
+}
+
+bool fs::dataBlob::readBlob(const std::string& _blobPath, uint64_t _srcSize, uint64_t _srcStamp)
+{
+    FILE *blob = fopen(_blobPath.c_str(), "rb");
+    if(!blob)
+        return false;
+
+    dataBlobHeader head;
+    std::vector<uint8_t> data;
+    bool valid = fread(&head, sizeof(dataBlobHeader), 1, blob) == 1 && head.magic == DATA_BLOB_MAGIC && head.rev == DATA_BLOB_REV
+                 && head.srcSize == _srcSize && head.srcStamp == _srcStamp;
+    //Sizes are checked against the blob itself before anything is allocated for them.
+    //Every line is at least a name length and a value count
+    if(valid)
+    {
+        long dataStart = ftell(blob);
+        fseek(blob, 0, SEEK_END);
+        valid = (uint64_t)(ftell(blob) - dataStart) == head.dataSize && head.lineCount <= head.dataSize / (sizeof(uint32_t) * 2);
+        fseek(blob, dataStart, SEEK_SET);
+    }
+
+    if(valid)
+    {
+        data.resize(head.dataSize);
+        valid = fread(data.data(), 1, head.dataSize, blob) == head.dataSize;
+    }
+    fclose(blob);
+    if(!valid)
+        return false;
+
+    const uint8_t *pos = data.data(), *end = data.data() + data.size();
+    lines.resize(head.lineCount);
+    for(dataLine& line : lines)
+    {
+        uint32_t valueCount;
+        if(!dataBlobReadStr(pos, end, line.name) || end - pos < (ptrdiff_t)sizeof(uint32_t))
+        {
+            valid = false;
+            break;
+        }
+
+        memcpy(&valueCount, pos, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        //Every value is at least its length
+        if((uint64_t)(end - pos) < (uint64_t)valueCount * sizeof(uint32_t))
+        {
+            valid = false;
+            break;
+        }
+
+        line.values.resize(valueCount);
+        for(std::string& value : line.values)
+        {
+            if(!dataBlobReadStr(pos, end, value))
+            {
+                valid = false;
+                break;
+            }
+        }
+
+        if(!valid)
+            break;
+    }
+
+    if(!valid || pos != end)
+    {
+        lines.clear();
+        return false;
+    }
+    return true;
+}
+
+void fs::dataBlob::writeBlob(const std::string& _blobPath, uint64_t _srcSize, uint64_t _srcStamp)
+{
+    std::vector<uint8_t> data;
+    for(dataLine& line : lines)
+    {
+        uint32_t valueCount = line.values.size();
+        dataBlobWriteStr(data, line.name);
+        data.insert(data.end(), (const uint8_t *)&valueCount, (const uint8_t *)&valueCount + sizeof(uint32_t));
+        for(std::string& value : line.values)
+            dataBlobWriteStr(data, value);
+    }
+
+    dataBlobHeader head;
+    head.magic = DATA_BLOB_MAGIC;
+    head.rev = DATA_BLOB_REV;
+    head.lineCount = lines.size();
+    head.srcSize = _srcSize;
+    head.srcStamp = _srcStamp;
+    head.dataSize = data.size();
+
+    //JKSV.cfg is read before the log is open, so failures here just mean the text is parsed again next time
+    FILE *blob = fopen(_blobPath.c_str(), "wb");
+    if(!blob)
+        return;
+
+    bool written = fwrite(&head, sizeof(dataBlobHeader), 1, blob) == 1 && fwrite(data.data(), 1, data.size(), blob) == data.size();
+    fclose(blob);
+    if(!written)
+        remove(_blobPath.c_str());
+}
+
 void fs::copyFile(const std::string& src, const std::string& dst, threadInfo *t)
 {
     fs::copyArgs *c = NULL;
@@ -245,7 +481,7 @@ static void copyFileThreaded_t(void *a)
     threadInfo *t = (threadInfo *)a;
     fs::copyArgs *in = (fs::copyArgs *)t->argPtr;
 
-    t->status->setStatus(ui::getUICString("threadStatusCopyingFile", 0), in->src.c_str());
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusCopyingFile, 0), in->src.c_str());
 
     fs::copyFile(in->src, in->dst, t);
     if(in->cleanup)
@@ -325,7 +561,7 @@ static void copyFileCommit_t(void *a)
     threadInfo *t = (threadInfo *)a;
     fs::copyArgs *in = (fs::copyArgs *)t->argPtr;
 
-    t->status->setStatus(ui::getUICString("threadStatusCopyingFile", 0), in->src.c_str());
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusCopyingFile, 0), in->src.c_str());
     in->prog->setMax(fs::fsize(in->src));
     in->prog->update(0);
 
@@ -357,9 +593,24 @@ void fs::fileDrawFunc(void *a)
     }
 }
 
+void fs::backupDrawFunc(void *a)
+{
+    fileDrawFunc(a);
+
+    threadInfo *t = (threadInfo *)a;
+    unsigned transfers = fs::transferGetCount();
+    if(!t->finished && transfers > 0)
+    {
+        uint64_t done = 0, total = 0;
+        fs::transferGetProgress(done, total);
+        std::string progress = util::getSizeString(done) + " / " + util::getSizeString(total);
+        gfx::drawTextf(NULL, 16, 312, 424, &ui::txtCont, ui::getUICString(fs::transferIsPaused() ? ui::str::transferStatusPaused : ui::str::transferStatus, 0), transfers, progress.c_str());
+    }
+}
+
 void fs::delfile(const std::string& path)
 {
-    if(cfg::config["directFsCmd"])
+    if(cfg::config[cfg::DIRECT_FS_CMD])
         fsremove(path.c_str());
     else
         remove(path.c_str());
@@ -368,7 +619,7 @@ void fs::delfile(const std::string& path)
 void fs::getShowFileProps(const std::string& _path)
 {
     size_t size = fs::fsize(_path);
-    ui::showMessage(ui::getUICString("fileModeFileProperties", 0), _path.c_str(), util::getSizeString(size).c_str());
+    ui::showMessage(ui::getUICString(ui::str::fileModeFileProperties, 0), _path.c_str(), util::getSizeString(size).c_str());
 }
 
 bool fs::fileExists(const std::string& path)
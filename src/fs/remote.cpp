@@ -2,17 +2,22 @@
 #include "rfs.h"
 #include "gd.h"
 #include "webdav.h"
+#include "s3.h"
+#include "localfs.h"
 #include "cfg.h"
 #include "ui.h"
 
 rfs::IRemoteFS *fs::rfs = NULL;
 std::string fs::rfsRootID;
+std::string fs::rfsIdentity;
 
 void fs::remoteInit()
 {
     // Google Drive has priority
     driveInit();
     webDavInit();
+    s3Init();
+    localInit();
 }
 
 void fs::remoteExit()
@@ -23,6 +28,18 @@ void fs::remoteExit()
     }
 }
 
+std::string fs::remoteGetTrashDir(const std::string& _title)
+{
+    if(!rfs->dirExists("_TRASH_", rfsRootID) && !rfs->createDir("_TRASH_", rfsRootID))
+        return "";
+
+    std::string trashRoot = rfs->getDirID("_TRASH_", rfsRootID);
+    if(!rfs->dirExists(_title, trashRoot) && !rfs->createDir(_title, trashRoot))
+        return "";
+
+    return rfs->getDirID(_title, trashRoot);
+}
+
 void fs::driveInit()
 {
     // Already initialized?
@@ -36,6 +53,10 @@ void fs::driveInit()
     drive::gd *gDrive = new drive::gd;
     gDrive->setClientID(cfg::driveClientID);
     gDrive->setClientSecret(cfg::driveClientSecret);
+    if(!cfg::driveTokenURI.empty())
+        gDrive->setTokenURL(cfg::driveTokenURI);
+    if(!cfg::driveAPIOrigin.empty())
+        gDrive->setAPIOrigin(cfg::driveAPIOrigin);
     if(!cfg::driveRefreshToken.empty())
     {
         gDrive->setRefreshToken(cfg::driveRefreshToken);
@@ -62,13 +83,15 @@ void fs::driveInit()
             gDrive->createDir(JKSV_DRIVE_FOLDER, "");
 
         rfsRootID = gDrive->getDirID(JKSV_DRIVE_FOLDER);
+        // Folder IDs are unique to the account
+        rfsIdentity = "drive:" + rfsRootID;
         rfs = gDrive;
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popDriveStarted", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popDriveStarted, 0));
     }
     else
     {
         delete gDrive;
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popDriveFailed", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popDriveFailed, 0));
     }
 }
 
@@ -124,11 +147,79 @@ void fs::webDavInit() {
         if (!webdav->createDir(JKSV_DRIVE_FOLDER, baseId))
         {
             delete webdav;
-            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popWebdavFailed", 0));
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popWebdavFailed, 0));
             return;
         }
     }
 
     rfs = webdav;
-    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popWebdavStarted", 0));
-}
\ No newline at end of file
+    rfsIdentity = "webdav:" + cfg::webdavOrigin + rfsRootID;
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popWebdavStarted, 0));
+}
+
+void fs::s3Init() {
+    // Already initialized?
+    if (rfs)
+        return;
+
+    if (cfg::s3Endpoint.empty() || cfg::s3Bucket.empty())
+        return;
+
+    rfs::S3 *s3 = new rfs::S3(cfg::s3Endpoint,
+                              cfg::s3Region,
+                              cfg::s3Bucket,
+                              cfg::s3AccessKey,
+                              cfg::s3SecretKey,
+                              cfg::s3PathStyle,
+                              cfg::s3PartSize,
+                              cfg::s3Concurrency);
+
+    std::string baseId = cfg::s3BasePath + (cfg::s3BasePath.empty() ? "" : "/");
+    rfsRootID = s3->getDirID(JKSV_DRIVE_FOLDER, baseId);
+
+    // check access. Creating the marker fails on auth/config related errors
+    if (!s3->dirExists(JKSV_DRIVE_FOLDER, baseId))
+    {
+        if (!s3->createDir(JKSV_DRIVE_FOLDER, baseId))
+        {
+            delete s3;
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popS3Failed, 0));
+            return;
+        }
+    }
+
+    rfs = s3;
+    rfsIdentity = "s3:" + cfg::s3Endpoint + "/" + cfg::s3Bucket + "/" + rfsRootID;
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popS3Started, 0));
+}
+
+void fs::localInit() {
+    // Already initialized?
+    if (rfs)
+        return;
+
+    if (cfg::localRemotePath.empty())
+        return;
+
+    std::string baseId = cfg::localRemotePath;
+    if (baseId.back() != '/')
+        baseId += "/";
+
+    rfs::LocalFS *local = new rfs::LocalFS;
+    rfsRootID = local->getDirID(JKSV_DRIVE_FOLDER, baseId);
+
+    // Target has to exist. Drives that aren't mounted fail here
+    if (!local->dirExists(JKSV_DRIVE_FOLDER, baseId))
+    {
+        if (!local->createDir(JKSV_DRIVE_FOLDER, baseId))
+        {
+            delete local;
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popLocalRemoteFailed, 0));
+            return;
+        }
+    }
+
+    rfs = local;
+    rfsIdentity = "local:" + rfsRootID;
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popLocalRemoteStarted, 0));
+}
@@ -0,0 +1,197 @@
+#include <switch.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "fs.h"
+#include "rfs.h"
+#include "cfg.h"
+#include "ui.h"
+#include "util.h"
+
+// Each workload is small enough to run in a few seconds on a local remote, large enough to show up on a slow one
+#define BENCH_FOLDER "_BENCH_"
+#define BENCH_FILE_SIZE 0x400000
+#define BENCH_FILE_COUNT 8
+#define BENCH_LIST_RUNS 16
+
+typedef struct
+{
+    const char *name;
+    std::vector<uint64_t> times;
+    //Only counts transfers that completed
+    uint64_t bytes = 0;
+    //HTTP requests actually sent. Stays 0 for the local remote
+    uint64_t requests = 0;
+    unsigned failed = 0;
+} benchResult;
+
+static inline uint64_t benchElapsed(uint64_t start)
+{
+    return armTicksToNs(armGetSystemTick() - start);
+}
+
+//Nearest rank on an already sorted list
+static double benchPercentileMs(const std::vector<uint64_t>& sorted, unsigned p)
+{
+    size_t ind = (sorted.size() * p + 99) / 100;
+    if(ind > 0)
+        --ind;
+
+    return (double)sorted[ind] / 1000000;
+}
+
+static void benchReport(benchResult& r)
+{
+    if(r.times.empty())
+        return;
+
+    std::sort(r.times.begin(), r.times.end());
+    uint64_t total = 0;
+    for(uint64_t& t : r.times)
+        total += t;
+
+    double seconds = (double)total / 1000000000;
+    double mbPerSec = seconds > 0 ? ((double)r.bytes / 0x100000) / seconds : 0;
+    fs::logWrite("Benchmark: %-8s %3u calls, %4u HTTP requests, %u failed, %.2f MB/s, p50 %.1fms, p95 %.1fms, p99 %.1fms, max %.1fms\n",
+                 r.name, (unsigned)r.times.size(), (unsigned)r.requests, r.failed, mbPerSec,
+                 benchPercentileMs(r.times, 50), benchPercentileMs(r.times, 95), benchPercentileMs(r.times, 99),
+                 (double)r.times.back() / 1000000);
+}
+
+//Random data so nothing along the way can compress it
+static bool benchCreateFile(const std::string& path)
+{
+    FILE *out = fopen(path.c_str(), "wb");
+    if(!out)
+        return false;
+
+    std::vector<uint8_t> buff(BUFF_SIZE);
+    for(unsigned i = 0; i < BENCH_FILE_SIZE / BUFF_SIZE; i++)
+    {
+        randomGet(buff.data(), BUFF_SIZE);
+        fwrite(buff.data(), 1, BUFF_SIZE, out);
+    }
+    fclose(out);
+    return fs::fsize(path) == BENCH_FILE_SIZE;
+}
+
+void fs::remoteBenchmark_t(void *a)
+{
+    threadInfo *t = (threadInfo *)a;
+    fs::copyArgs *c = (fs::copyArgs *)t->argPtr;
+    std::string upPath = fs::getWorkDir() + "_bench_up.bin", dlPath = fs::getWorkDir() + "_bench_dl.bin";
+
+    if(cfg::config[cfg::OVR_CLK])
+        util::sysBoost();
+
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusBenchmarking, 0), "setup");
+    if(!benchCreateFile(upPath) || (!fs::rfs->dirExists(BENCH_FOLDER, fs::rfsRootID) && !fs::rfs->createDir(BENCH_FOLDER, fs::rfsRootID)))
+    {
+        fs::logWrite("Benchmark: setup failed\n");
+        fs::delfile(upPath);
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popBenchmarkFailed, 0));
+        fs::copyArgsDestroy(c);
+        t->finished = true;
+        return;
+    }
+    std::string benchDir = fs::rfs->getDirID(BENCH_FOLDER, fs::rfsRootID);
+
+    benchResult upload, list, download, del;
+    upload.name = "upload";
+    list.name = "list";
+    download.name = "download";
+    del.name = "delete";
+
+    c->prog->setMax(BENCH_FILE_SIZE);
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusBenchmarking, 0), upload.name);
+    uint64_t requestStart = curlFuncs::getRequestCount();
+    for(unsigned i = 0; i < BENCH_FILE_COUNT; i++)
+    {
+        char name[32];
+        sprintf(name, "bench%02u.bin", i);
+
+        curlFuncs::curlUpArgs up;
+        up.f = fopen(upPath.c_str(), "rb");
+        up.o = &c->offset;
+        c->offset = 0;
+
+        uint64_t start = armGetSystemTick();
+        fs::rfs->uploadFile(name, benchDir, &up);
+        upload.times.push_back(benchElapsed(start));
+        fclose(up.f);
+    }
+    upload.requests = curlFuncs::getRequestCount() - requestStart;
+
+    //Last listing is kept to check the uploads and drive the rest
+    std::vector<rfs::RfsItem> items;
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusBenchmarking, 0), list.name);
+    requestStart = curlFuncs::getRequestCount();
+    for(unsigned i = 0; i < BENCH_LIST_RUNS; i++)
+    {
+        uint64_t start = armGetSystemTick();
+        items = fs::rfs->getListWithParent(benchDir);
+        list.times.push_back(benchElapsed(start));
+    }
+    list.requests = curlFuncs::getRequestCount() - requestStart;
+
+    //uploadFile() doesn't report back, so only files that show up complete count
+    unsigned uploaded = 0;
+    for(rfs::RfsItem& item : items)
+    {
+        if(!item.isDir && item.size == BENCH_FILE_SIZE)
+            ++uploaded;
+    }
+    upload.failed = BENCH_FILE_COUNT - std::min(uploaded, (unsigned)BENCH_FILE_COUNT);
+    upload.bytes = (uint64_t)uploaded * BENCH_FILE_SIZE;
+
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusBenchmarking, 0), download.name);
+    requestStart = curlFuncs::getRequestCount();
+    for(rfs::RfsItem& item : items)
+    {
+        if(item.isDir)
+            continue;
+
+        curlFuncs::curlDlArgs dl;
+        dl.path = dlPath;
+        dl.size = item.size;
+        dl.o = &c->offset;
+        c->offset = 0;
+
+        uint64_t start = armGetSystemTick();
+        fs::rfs->downloadFile(item.id, &dl);
+        download.times.push_back(benchElapsed(start));
+        if(fs::fsize(dlPath) == BENCH_FILE_SIZE)
+            download.bytes += BENCH_FILE_SIZE;
+        else
+            ++download.failed;
+
+        fs::delfile(dlPath);
+    }
+    download.requests = curlFuncs::getRequestCount() - requestStart;
+
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusBenchmarking, 0), del.name);
+    requestStart = curlFuncs::getRequestCount();
+    for(rfs::RfsItem& item : items)
+    {
+        uint64_t start = armGetSystemTick();
+        fs::rfs->deleteFile(item.id);
+        del.times.push_back(benchElapsed(start));
+    }
+    del.requests = curlFuncs::getRequestCount() - requestStart;
+    del.failed = fs::rfs->getListWithParent(benchDir).size();
+    fs::rfs->deleteFile(benchDir);
+    fs::delfile(upPath);
+
+    benchReport(list);
+    benchReport(upload);
+    benchReport(download);
+    benchReport(del);
+
+    if(cfg::config[cfg::OVR_CLK])
+        util::sysNormal();
+
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popBenchmarkFinished, 0));
+    fs::copyArgsDestroy(c);
+    t->finished = true;
+}
@@ -0,0 +1,474 @@
+#include <switch.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <json-c/json.h>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+
+#include "fs.h"
+#include "cfg.h"
+#include "ui.h"
+
+//Held as pointers so running jobs stay put while others are added or removed. Kept in the order they were added
+static std::vector<fs::transferJob *> transferQueue;
+static std::mutex transferLock;
+static std::condition_variable transferCond;
+static Thread transferWorkers[TRANSFER_WORKER_COUNT];
+static unsigned transferWorkerCount = 0, transferNextID = 0;
+static bool transferPaused = false, transferStop = false;
+
+static const char *transferTypeNames[] = { "upload", "download" };
+
+//Remote title folders by title. Made by the first upload for a title instead of all up front
+static std::unordered_map<std::string, std::string> transferRemoteDirs;
+static std::mutex transferRemoteDirLock;
+
+//transferLock has to be held
+static void transferSave()
+{
+    if(transferQueue.empty())
+    {
+        remove(TRANSFER_QUEUE_PATH);
+        return;
+    }
+
+    json_object *jobs = json_object_new_array();
+    for(fs::transferJob *job : transferQueue)
+    {
+        json_object *jobObj = json_object_new_object();
+        json_object_object_add(jobObj, "type", json_object_new_string(transferTypeNames[job->type]));
+        json_object_object_add(jobObj, "priority", json_object_new_int(job->priority));
+        json_object_object_add(jobObj, "local", json_object_new_string(job->local.c_str()));
+        json_object_object_add(jobObj, "remote", json_object_new_string(job->remote.c_str()));
+        json_object_object_add(jobObj, "title", json_object_new_string(job->title.c_str()));
+        json_object_object_add(jobObj, "name", json_object_new_string(job->name.c_str()));
+        json_object_object_add(jobObj, "size", json_object_new_int64(job->size));
+        json_object_object_add(jobObj, "deleteLocal", json_object_new_boolean(job->deleteLocal));
+        json_object_array_add(jobs, jobObj);
+    }
+    if(json_object_to_file_ext(TRANSFER_QUEUE_PATH, jobs, JSON_C_TO_STRING_PRETTY) != 0)
+        fs::logWrite("Transfer: failed to save queue\n");
+
+    json_object_put(jobs);
+}
+
+static void transferLoad()
+{
+    json_object *jobs = json_object_from_file(TRANSFER_QUEUE_PATH);
+    if(!jobs)
+        return;
+
+    size_t jobCount = json_object_array_length(jobs);
+    bool dropped = false;
+    for(size_t i = 0; i < jobCount; i++)
+    {
+        json_object *jobObj = json_object_array_get_idx(jobs, i), *type, *priority, *local, *remote, *title, *name, *size, *deleteLocal;
+        if(!json_object_object_get_ex(jobObj, "type", &type) || !json_object_object_get_ex(jobObj, "local", &local)
+           || !json_object_object_get_ex(jobObj, "title", &title) || !json_object_object_get_ex(jobObj, "name", &name))
+            continue;
+
+        //Queued for another remote or account. Zips only made for that upload go with it
+        if(!json_object_object_get_ex(jobObj, "remote", &remote) || fs::rfsIdentity != json_object_get_string(remote))
+        {
+            fs::logWrite("Transfer: dropping %s, it was queued for another remote\n", json_object_get_string(name));
+            if(json_object_object_get_ex(jobObj, "deleteLocal", &deleteLocal) && json_object_get_boolean(deleteLocal))
+                fs::delfile(json_object_get_string(local));
+            dropped = true;
+            continue;
+        }
+
+        fs::transferJob *job = new fs::transferJob;
+        job->id = transferNextID++;
+        job->type = strcmp(json_object_get_string(type), "download") == 0 ? fs::TRANSFER_DOWNLOAD : fs::TRANSFER_UPLOAD;
+        if(json_object_object_get_ex(jobObj, "priority", &priority))
+            job->priority = (fs::transferPriority)json_object_get_int(priority);
+        else
+            job->priority = job->type == fs::TRANSFER_DOWNLOAD ? fs::TRANSFER_PRIORITY_DOWNLOAD : fs::TRANSFER_PRIORITY_UPLOAD;
+        job->local = json_object_get_string(local);
+        job->remote = fs::rfsIdentity;
+        job->title = json_object_get_string(title);
+        job->name = json_object_get_string(name);
+        if(json_object_object_get_ex(jobObj, "size", &size))
+            job->size = json_object_get_int64(size);
+        if(json_object_object_get_ex(jobObj, "deleteLocal", &deleteLocal))
+            job->deleteLocal = json_object_get_boolean(deleteLocal);
+
+        transferQueue.push_back(job);
+    }
+    json_object_put(jobs);
+
+    //Zips left behind by a crash before they were queued
+    std::string scratchDir = fs::getWorkDir() + TRANSFER_SCRATCH_DIR;
+    fs::dirList scratchList(scratchDir);
+    for(unsigned i = 0; i < scratchList.getCount(); i++)
+    {
+        std::string path = scratchDir + scratchList.getItem(i);
+        bool queued = false;
+        for(fs::transferJob *job : transferQueue)
+            queued = queued || job->local == path;
+
+        if(!queued && !scratchList.isDir(i))
+            fs::delfile(path);
+    }
+
+    if(dropped)
+        transferSave();
+
+    if(!transferQueue.empty())
+        fs::logWrite("Transfer: resuming %u jobs\n", (unsigned)transferQueue.size());
+}
+
+//transferLock has to be held. Lowest priority first, oldest first within that
+static fs::transferJob *transferNext()
+{
+    fs::transferJob *ret = NULL;
+    for(fs::transferJob *job : transferQueue)
+    {
+        if(!job->running && (!ret || job->priority < ret->priority))
+            ret = job;
+    }
+    return ret;
+}
+
+//Held while checking so two workers starting on the same title don't both try to create it
+static std::string transferGetRemoteDir(const std::string& _title)
+{
+    std::lock_guard<std::mutex> lock(transferRemoteDirLock);
+    auto find = transferRemoteDirs.find(_title);
+    if(find != transferRemoteDirs.end())
+        return find->second;
+
+    if(!fs::rfs->dirExists(_title, fs::rfsRootID) && !fs::rfs->createDir(_title, fs::rfsRootID))
+        return "";
+
+    std::string ret = fs::rfs->getDirID(_title, fs::rfsRootID);
+    transferRemoteDirs[_title] = ret;
+    return ret;
+}
+
+//Checked again next time in case it was removed behind our back
+static void transferForgetRemoteDir(const std::string& _title)
+{
+    std::lock_guard<std::mutex> lock(transferRemoteDirLock);
+    transferRemoteDirs.erase(_title);
+}
+
+static bool transferUpload(fs::transferJob *job)
+{
+    std::string parent = transferGetRemoteDir(job->title);
+    if(parent.empty())
+        return false;
+
+    curlFuncs::curlUpArgs upload;
+    upload.f = fopen(job->local.c_str(), "rb");
+    upload.o = &job->offset;
+    upload.cancel = &job->cancel;
+    if(!upload.f)
+    {
+        fs::logWrite("Transfer: failed to open %s\n", job->local.c_str());
+        return false;
+    }
+
+    if(fs::rfs->fileExists(job->name, parent))
+    {
+        std::string id = fs::rfs->getFileID(job->name, parent);
+
+        //Keep the old version in the remote trash. This is done server side so it costs nothing
+        if(cfg::config[cfg::TRASH_BIN])
+        {
+            std::string trashDir = fs::remoteGetTrashDir(job->title);
+            if(!trashDir.empty())
+                fs::rfs->copyFile(id, job->name, trashDir);
+        }
+
+        fs::rfs->updateFile(id, &upload);
+    }
+    else
+        fs::rfs->uploadFile(job->name, parent, &upload);
+
+    fclose(upload.f);
+
+    bool ret = !job->cancel && job->offset >= job->size && fs::rfs->fileExists(job->name, parent);
+    if(!ret && !job->cancel)
+        transferForgetRemoteDir(job->title);
+
+    return ret;
+}
+
+static bool transferDownload(fs::transferJob *job)
+{
+    if(!fs::rfs->dirExists(job->title, fs::rfsRootID))
+        return false;
+
+    std::string parent = fs::rfs->getDirID(job->title, fs::rfsRootID);
+    std::string id = fs::rfs->getFileID(job->name, parent);
+    if(id.empty())
+        return false;
+
+    //Anything already at local is only replaced once the whole file is here
+    std::string tmpPath = job->local + TRANSFER_TEMP_EXT;
+    curlFuncs::curlDlArgs download;
+    download.path = tmpPath;
+    download.size = job->size;
+    download.o = &job->offset;
+    download.cancel = &job->cancel;
+    fs::rfs->downloadFile(id, &download);
+
+    //Half a backup is worse than none
+    bool ret = !job->cancel && fs::fileExists(tmpPath) && (job->size == 0 || fs::fsize(tmpPath) == job->size);
+    if(ret)
+    {
+        if(fs::fileExists(job->local))
+            fs::delfile(job->local);
+
+        ret = rename(tmpPath.c_str(), job->local.c_str()) == 0;
+        if(!ret)
+            fs::logWrite("Transfer: failed to move %s into place\n", tmpPath.c_str());
+    }
+
+    if(!ret)
+        fs::delfile(tmpPath);
+
+    return ret;
+}
+
+static void transferWorker_t(void *a)
+{
+    std::unique_lock<std::mutex> lock(transferLock);
+    while(true)
+    {
+        fs::transferJob *job = NULL;
+        transferCond.wait(lock, [&job]{ return transferStop || (!transferPaused && (job = transferNext()) != NULL); });
+        if(transferStop)
+            break;
+
+        job->running = true;
+        job->cancel = false;
+        job->paused = false;
+        job->offset = 0;
+        lock.unlock();
+
+        bool success = job->type == fs::TRANSFER_UPLOAD ? transferUpload(job) : transferDownload(job);
+        //Give whatever went wrong a moment before trying again
+        if(!success && !job->cancel)
+            svcSleepThread(TRANSFER_RETRY_DELAY);
+
+        lock.lock();
+        job->running = false;
+        //Paused or stopped, not failed
+        if(!success && !job->dropped && (job->paused || job->cancel || ++job->attempts < TRANSFER_MAX_ATTEMPTS))
+            continue;
+
+        //Nothing else would ever clean these up, so they go whether the upload made it or not
+        if(job->deleteLocal)
+            fs::delfile(job->local);
+
+        if(success)
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTransferFinished, 0), job->name.c_str());
+        else if(job->dropped)
+            fs::logWrite("Transfer: %s of %s cancelled\n", transferTypeNames[job->type], job->name.c_str());
+        else
+        {
+            fs::logWrite("Transfer: %s of %s failed %u times, dropping it\n", transferTypeNames[job->type], job->name.c_str(), job->attempts);
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTransferFailed, 0), job->name.c_str());
+        }
+
+        for(unsigned i = 0; i < transferQueue.size(); i++)
+        {
+            if(transferQueue[i] == job)
+            {
+                transferQueue.erase(transferQueue.begin() + i);
+                break;
+            }
+        }
+        delete job;
+        transferSave();
+        //Anyone waiting on the backlog
+        transferCond.notify_all();
+
+        //Listing the remote takes a round trip, so the folder menu does it on the main thread
+        ui::fldMarkChanged();
+    }
+}
+
+void fs::transferInit()
+{
+    if(!fs::rfs)
+        return;
+
+    std::lock_guard<std::mutex> lock(transferLock);
+    transferLoad();
+    transferStop = false;
+    for(unsigned i = 0; i < TRANSFER_WORKER_COUNT; i++)
+    {
+        if(R_SUCCEEDED(threadCreate(&transferWorkers[transferWorkerCount], transferWorker_t, NULL, NULL, 0x40000, 0x2B, -2)))
+        {
+            if(R_SUCCEEDED(threadStart(&transferWorkers[transferWorkerCount])))
+                ++transferWorkerCount;
+            else
+                threadClose(&transferWorkers[transferWorkerCount]);
+        }
+    }
+}
+
+void fs::transferExit()
+{
+    {
+        std::lock_guard<std::mutex> lock(transferLock);
+        transferStop = true;
+        for(fs::transferJob *job : transferQueue)
+            job->cancel = true;
+    }
+    transferCond.notify_all();
+
+    for(unsigned i = 0; i < transferWorkerCount; i++)
+    {
+        threadWaitForExit(&transferWorkers[i]);
+        threadClose(&transferWorkers[i]);
+    }
+    transferWorkerCount = 0;
+
+    //Whatever is left is already saved and picked up next launch
+    std::lock_guard<std::mutex> lock(transferLock);
+    for(fs::transferJob *job : transferQueue)
+        delete job;
+
+    transferQueue.clear();
+}
+
+unsigned fs::transferAdd(transferType _type, transferPriority _priority, const std::string& _local, const std::string& _title, const std::string& _name, uint64_t _size, bool _deleteLocal)
+{
+    fs::transferJob *job = new fs::transferJob;
+    job->type = _type;
+    job->priority = _priority;
+    job->local = _local;
+    job->remote = fs::rfsIdentity;
+    job->title = _title;
+    job->name = _name;
+    job->size = _size;
+    job->deleteLocal = _deleteLocal;
+
+    unsigned id;
+    {
+        std::lock_guard<std::mutex> lock(transferLock);
+        id = job->id = transferNextID++;
+        transferQueue.push_back(job);
+        transferSave();
+    }
+    transferCond.notify_one();
+    return id;
+}
+
+void fs::transferCancelAll()
+{
+    {
+        std::lock_guard<std::mutex> lock(transferLock);
+        //Running jobs are removed by their worker once they've stopped
+        for(unsigned i = 0; i < transferQueue.size(); )
+        {
+            fs::transferJob *job = transferQueue[i];
+            if(job->running)
+            {
+                job->dropped = true;
+                job->cancel = true;
+                ++i;
+                continue;
+            }
+
+            if(job->deleteLocal)
+                fs::delfile(job->local);
+
+            delete job;
+            transferQueue.erase(transferQueue.begin() + i);
+        }
+        transferSave();
+    }
+    transferCond.notify_all();
+}
+
+void fs::transferSetPaused(bool _paused)
+{
+    {
+        std::lock_guard<std::mutex> lock(transferLock);
+        transferPaused = _paused;
+        //Resuming leaves running jobs alone. Ones still stopping are picked up again once they're back in the queue
+        for(fs::transferJob *job : transferQueue)
+        {
+            if(_paused && job->running)
+            {
+                job->paused = true;
+                job->cancel = true;
+            }
+        }
+    }
+    transferCond.notify_all();
+}
+
+bool fs::transferWaitBacklog(transferPriority _priority, uint64_t _maxBytes, const bool *_cancel)
+{
+    std::unique_lock<std::mutex> lock(transferLock);
+    while(true)
+    {
+        if(transferStop || (_cancel && *_cancel))
+            return false;
+
+        if(transferWorkerCount == 0)
+            return true;
+
+        //Paused counts as full, or a batch dump would fill the SD card while nothing goes out
+        if(!transferPaused)
+        {
+            uint64_t backlog = 0;
+            for(fs::transferJob *job : transferQueue)
+            {
+                if(job->priority == _priority)
+                    backlog += job->size - job->offset;
+            }
+
+            if(backlog <= _maxBytes)
+                return true;
+        }
+
+        //*_cancel is set without a notify, so it's checked every so often
+        transferCond.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
+std::string fs::transferGetScratchPath(uint64_t _tid, const std::string& _name)
+{
+    std::string scratchDir = fs::getWorkDir() + TRANSFER_SCRATCH_DIR;
+    mkdir(scratchDir.c_str(), 777);
+
+    char tid[32];
+    sprintf(tid, "%016lX", _tid);
+    return scratchDir + tid + " - " + _name;
+}
+
+bool fs::transferIsPaused()
+{
+    std::lock_guard<std::mutex> lock(transferLock);
+    return transferPaused;
+}
+
+unsigned fs::transferGetCount()
+{
+    std::lock_guard<std::mutex> lock(transferLock);
+    return transferQueue.size();
+}
+
+void fs::transferGetProgress(uint64_t& _done, uint64_t& _total)
+{
+    std::lock_guard<std::mutex> lock(transferLock);
+    _done = 0;
+    _total = 0;
+    for(fs::transferJob *job : transferQueue)
+    {
+        _total += job->size;
+        if(job->running)
+            _done += job->offset;
+    }
+}
@@ -55,7 +55,7 @@ void fs::copyDirToZip(const std::string& src, zipFile dst, bool trimPath, int tr
     fs::copyArgs *c = NULL;
     if(t)
     {
-        t->status->setStatus(ui::getUICString("threadStatusOpeningFolder", 0), src.c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusOpeningFolder, 0), src.c_str());
         c = (fs::copyArgs *)t->argPtr;
     }
 
@@ -87,7 +87,7 @@ void fs::copyDirToZip(const std::string& src, zipFile dst, bool trimPath, int tr
                 zipNameStart = filename.find_first_of('/') + 1;
 
             if(t)
-                t->status->setStatus(ui::getUICString("threadStatusAddingFileToZip", 0), itm.c_str());
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusAddingFileToZip, 0), itm.c_str());
 
             int zipOpenFile = zipOpenNewFileInZip64(dst, filename.substr(zipNameStart, filename.npos).c_str(), &inf, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_DEFAULT_COMPRESSION, 0);
             if(zipOpenFile == ZIP_OK)
@@ -120,15 +120,15 @@ void copyDirToZip_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
     fs::copyArgs *c = (fs::copyArgs *)t->argPtr;
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
     {
         util::sysBoost();
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popCPUBoostEnabled", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popCPUBoostEnabled, 0));
     }
 
     fs::copyDirToZip(c->src, c->z, c->trimZipPath, c->trimZipPlaces, t);
 
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
         util::sysNormal();
 
     if(c->cleanup)
@@ -163,7 +163,7 @@ void fs::copyZipToDir(unzFile src, const std::string& dst, const std::string& de
         if(unzOpenCurrentFile(src) == UNZ_OK)
         {
             if(t)
-                t->status->setStatus(ui::getUICString("threadStatusDecompressingFile", 0), filename);
+                t->status->setStatus(ui::getUICString(ui::str::threadStatusDecompressingFile, 0), filename);
 
             if(c)
             {
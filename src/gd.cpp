@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <curl/curl.h>
 #include <json-c/json.h>
 #include <string>
@@ -18,10 +19,7 @@ Still major WIP
 
 #define DRIVE_DEFAULT_PARAMS_AND_QUERY "?fields=files(name,id,mimeType,size,parents)&pageSize=1000&q=trashed=false\%20and\%20\%27me\%27\%20in\%20owners"
 
-#define tokenURL "https://oauth2.googleapis.com/token"
-#define tokenCheckURL "https://oauth2.googleapis.com/tokeninfo"
-#define driveURL "https://www.googleapis.com/drive/v3/files"
-#define driveUploadURL "https://www.googleapis.com/upload/drive/v3/files"
+#define DRIVE_BATCH_BOUNDARY "JKSV_BATCH"
 
 static inline void writeDriveError(const std::string& _function, const std::string& _message)
 {
@@ -33,6 +31,24 @@ static inline void writeCurlError(const std::string& _function, int _cerror)
     fs::logWrite("Drive/%s: CURL returned error %i\n", _function.c_str(), _cerror);
 }
 
+void drive::gd::setTokenURL(const std::string& _tokenURL)
+{
+    tokenURL = _tokenURL;
+    tokenCheckURL = _tokenURL.substr(0, _tokenURL.find_last_of('/')) + "/tokeninfo";
+}
+
+void drive::gd::setAPIOrigin(const std::string& _origin)
+{
+    // Trailing slash would double up with the paths
+    std::string origin = _origin;
+    while(!origin.empty() && origin.back() == '/')
+        origin.pop_back();
+
+    driveURL = origin + "/drive/v3/files";
+    driveUploadURL = origin + "/upload/drive/v3/files";
+    driveBatchURL = origin + "/batch/drive/v3";
+}
+
 bool drive::gd::exhangeAuthCode(const std::string& _authCode)
 {
     // Header
@@ -58,12 +74,12 @@ bool drive::gd::exhangeAuthCode(const std::string& _authCode)
     curl_easy_setopt(curl, CURLOPT_HTTPPOST, 1);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, postHeader);
-    curl_easy_setopt(curl, CURLOPT_URL, tokenURL);
+    curl_easy_setopt(curl, CURLOPT_URL, tokenURL.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(post));
     
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
 
     json_object *respParse = json_tokener_parse(jsonResp->c_str());
     if (error == CURLE_OK)
@@ -116,11 +132,11 @@ bool drive::gd::refreshToken()
     curl_easy_setopt(curl, CURLOPT_HTTPPOST, 1);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
-    curl_easy_setopt(curl, CURLOPT_URL, tokenURL);
+    curl_easy_setopt(curl, CURLOPT_URL, tokenURL.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(post));
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
 
     json_object *parse = json_tokener_parse(jsonResp->c_str());
     if (error == CURLE_OK)
@@ -162,7 +178,7 @@ bool drive::gd::tokenIsValid()
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
 
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
     json_object *parse = json_tokener_parse(jsonResp->c_str());
     if (error == CURLE_OK)
     {
@@ -194,7 +210,7 @@ static int requestList(const std::string& _url, const std::string& _token, std::
     curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, _respOut);
-    ret = curl_easy_perform(curl);
+    ret = curlFuncs::perform(curl);
 
 
     curl_slist_free_all(postHeaders);
@@ -227,7 +243,7 @@ static void processList(const std::string& _json, std::vector<rfs::RfsItem>& _dr
             rfs::RfsItem newDirItem;
             newDirItem.name = json_object_get_string(nameString);
             newDirItem.id = json_object_get_string(idString);
-            newDirItem.size = json_object_get_int(size);
+            newDirItem.size = json_object_get_int64(size);
             if(strcmp(json_object_get_string(mimeTypeString), MIMETYPE_FOLDER) == 0)
                 newDirItem.isDir = true;
 
@@ -247,13 +263,20 @@ static void processList(const std::string& _json, std::vector<rfs::RfsItem>& _dr
     json_object_put(parse);
 }
 
-void drive::gd::driveListInit(const std::string& _q)
+void drive::gd::checkToken()
 {
+    //Transfers can get here at the same time. Only one should refresh
+    std::lock_guard<std::mutex> lock(tokenLock);
     if(!tokenIsValid())
         refreshToken();
+}
+
+void drive::gd::driveListInit(const std::string& _q)
+{
+    checkToken();
 
     // Request url with specific fields needed.
-    std::string url = std::string(driveURL) + std::string(DRIVE_DEFAULT_PARAMS_AND_QUERY);
+    std::string url = driveURL + DRIVE_DEFAULT_PARAMS_AND_QUERY;
     if(!_q.empty())
     {
         char *qEsc = curl_easy_escape(NULL, _q.c_str(), _q.length());
@@ -264,17 +287,19 @@ void drive::gd::driveListInit(const std::string& _q)
     std::string jsonResp;
     int error = requestList(url, token, &jsonResp);
     if(error == CURLE_OK)
+    {
+        std::lock_guard<std::mutex> lock(listLock);
         processList(jsonResp, driveList, true);
+    }
     else
         writeCurlError("driveListInit", error);
 }
 
 void drive::gd::driveListAppend(const std::string& _q)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
-    std::string url = std::string(driveURL) + std::string(DRIVE_DEFAULT_PARAMS_AND_QUERY); 
+    std::string url = driveURL + DRIVE_DEFAULT_PARAMS_AND_QUERY; 
     if(!_q.empty())
     {
         char *qEsc = curl_easy_escape(NULL, _q.c_str(), _q.length());
@@ -285,12 +310,16 @@ void drive::gd::driveListAppend(const std::string& _q)
     std::string jsonResp;
     int error = requestList(url, token, &jsonResp);
     if(error == CURLE_OK)
+    {
+        std::lock_guard<std::mutex> lock(listLock);
         processList(jsonResp, driveList, false);
+    }
     else
         writeCurlError("driveListAppend", error);
 }
 
 std::vector<rfs::RfsItem> drive::gd::getListWithParent(const std::string& _parent) {
+    std::lock_guard<std::mutex> lock(listLock);
     std::vector<rfs::RfsItem> filtered;
     for(unsigned i = 0; i < driveList.size(); i++)
     {
@@ -302,6 +331,7 @@ std::vector<rfs::RfsItem> drive::gd::getListWithParent(const std::string& _paren
 
 void drive::gd::debugWriteList()
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(auto& di : driveList)
     {
         fs::logWrite("%s\n\t%s\n", di.name.c_str(), di.id.c_str());
@@ -312,8 +342,7 @@ void drive::gd::debugWriteList()
 
 bool drive::gd::createDir(const std::string& _dirName, const std::string& _parent)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
     bool ret = true;
 
@@ -342,11 +371,11 @@ bool drive::gd::createDir(const std::string& _dirName, const std::string& _paren
     curl_easy_setopt(curl, CURLOPT_HTTPPOST, 1);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, postHeaders);
-    curl_easy_setopt(curl, CURLOPT_URL, driveURL);
+    curl_easy_setopt(curl, CURLOPT_URL, driveURL.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(post));
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
     
     json_object *respParse = json_tokener_parse(jsonResp->c_str()), *checkError;
     json_object_object_get_ex(respParse, "error", &checkError);
@@ -362,6 +391,7 @@ bool drive::gd::createDir(const std::string& _dirName, const std::string& _paren
         newDir.isDir = true;
         newDir.size = 0;
         newDir.parent = _parent;
+        std::lock_guard<std::mutex> lock(listLock);
         driveList.push_back(newDir);
     }
     else
@@ -377,6 +407,7 @@ bool drive::gd::createDir(const std::string& _dirName, const std::string& _paren
 
 bool drive::gd::dirExists(const std::string& _dirName)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(driveList[i].isDir && driveList[i].name == _dirName)
@@ -387,6 +418,7 @@ bool drive::gd::dirExists(const std::string& _dirName)
 
 bool drive::gd::dirExists(const std::string& _dirName, const std::string& _parent)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(driveList[i].isDir && driveList[i].name == _dirName && driveList[i].parent == _parent)
@@ -397,6 +429,7 @@ bool drive::gd::dirExists(const std::string& _dirName, const std::string& _paren
 
 bool drive::gd::fileExists(const std::string& _filename, const std::string& _parent)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(!driveList[i].isDir && driveList[i].name == _filename && driveList[i].parent == _parent)
@@ -407,8 +440,7 @@ bool drive::gd::fileExists(const std::string& _filename, const std::string& _par
 
 void drive::gd::uploadFile(const std::string& _filename, const std::string& _parent, curlFuncs::curlUpArgs *_upload)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
     std::string url = driveUploadURL;
     url.append("?uploadType=resumable");
@@ -442,7 +474,7 @@ void drive::gd::uploadFile(const std::string& _filename, const std::string& _par
     curl_easy_setopt(curl, CURLOPT_HEADERDATA, headers);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(post));
     
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
     std::string location = curlFuncs::getHeader("Location", headers);
     if (error == CURLE_OK && location != HEADER_ERROR)
     {
@@ -455,7 +487,7 @@ void drive::gd::uploadFile(const std::string& _filename, const std::string& _par
         curl_easy_setopt(curlUp, CURLOPT_READDATA, _upload);
         curl_easy_setopt(curlUp, CURLOPT_UPLOAD_BUFFERSIZE, UPLOAD_BUFFER_SIZE);
         curl_easy_setopt(curlUp, CURLOPT_UPLOAD, 1);
-        curl_easy_perform(curlUp);
+        curlFuncs::perform(curlUp);
         curl_easy_cleanup(curlUp);
 
         json_object *parse = json_tokener_parse(jsonResp->c_str()), *id, *name, *mimeType;
@@ -471,6 +503,7 @@ void drive::gd::uploadFile(const std::string& _filename, const std::string& _par
             uploadData.isDir = false;
             uploadData.size = *_upload->o;//should be safe to use
             uploadData.parent = _parent;
+            std::lock_guard<std::mutex> lock(listLock);
             driveList.push_back(uploadData);
         }
         json_object_put(parse);
@@ -486,8 +519,7 @@ void drive::gd::uploadFile(const std::string& _filename, const std::string& _par
 
 void drive::gd::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *_upload)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
     //URL
     std::string url = driveUploadURL;
@@ -511,7 +543,7 @@ void drive::gd::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *_u
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
     curl_easy_setopt(curl, CURLOPT_HEADERDATA, headers);
     
-    int error = curl_easy_perform(curl);
+    int error = curlFuncs::perform(curl);
     std::string location = curlFuncs::getHeader("Location", headers);
     if(error == CURLE_OK && location != HEADER_ERROR)
     {
@@ -522,9 +554,10 @@ void drive::gd::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *_u
         curl_easy_setopt(curlPatch, CURLOPT_READDATA, _upload);
         curl_easy_setopt(curlPatch, CURLOPT_UPLOAD_BUFFERSIZE, UPLOAD_BUFFER_SIZE);
         curl_easy_setopt(curlPatch, CURLOPT_UPLOAD, 1);
-        curl_easy_perform(curlPatch);
+        curlFuncs::perform(curlPatch);
         curl_easy_cleanup(curlPatch);
 
+        std::lock_guard<std::mutex> lock(listLock);
         for(unsigned i = 0; i < driveList.size(); i++)
         {
             if(driveList[i].id == _fileID)
@@ -543,8 +576,7 @@ void drive::gd::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *_u
 
 void drive::gd::downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *_download)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
     //URL
     std::string url = driveURL;
@@ -555,12 +587,13 @@ void drive::gd::downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *
     curl_slist *getHeaders = NULL;
     getHeaders = curl_slist_append(getHeaders, std::string(HEADER_AUTHORIZATION + token).c_str());
 
-    //Downloading is threaded because it's too slow otherwise
-    rfs::dlWriteThreadStruct dlWrite;
-    dlWrite.cfa = _download;
-
-    Thread writeThread;
-    threadCreate(&writeThread, rfs::writeThread_t, &dlWrite, NULL, 0x8000, 0x2B, 2);
+    //Writing is threaded because it's too slow otherwise
+    rfs::DownloadWriter writer(_download);
+    if(!writer.open())
+    {
+        curl_slist_free_all(getHeaders);
+        return;
+    }
 
     //Curl
     CURL *curl = curl_easy_init();
@@ -568,14 +601,11 @@ void drive::gd::downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *
     curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, getHeaders);
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, rfs::writeDataBufferThreaded);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &dlWrite);
-    threadStart(&writeThread);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, rfs::DownloadWriter::writeCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writer);
     
-    curl_easy_perform(curl);
-
-    threadWaitForExit(&writeThread);
-    threadClose(&writeThread);
+    curlFuncs::perform(curl);
+    writer.close();
 
     curl_slist_free_all(getHeaders);
     curl_easy_cleanup(curl);
@@ -583,8 +613,7 @@ void drive::gd::downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *
 
 void drive::gd::deleteFile(const std::string& _fileID)
 {
-    if(!tokenIsValid())
-        refreshToken();
+    checkToken();
 
     //URL
     std::string url = driveURL;
@@ -600,8 +629,9 @@ void drive::gd::deleteFile(const std::string& _fileID)
     curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, delHeaders);
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_perform(curl);
+    curlFuncs::perform(curl);
 
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(driveList[i].id == _fileID)
@@ -615,8 +645,164 @@ void drive::gd::deleteFile(const std::string& _fileID)
     curl_easy_cleanup(curl);
 }
 
+bool drive::gd::copyFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent)
+{
+    checkToken();
+
+    bool ret = false;
+
+    //URL
+    std::string url = driveURL;
+    url.append("/" + _fileID + "/copy");
+
+    //Headers
+    curl_slist *postHeaders = NULL;
+    postHeaders = curl_slist_append(postHeaders, std::string(HEADER_AUTHORIZATION + token).c_str());
+    postHeaders = curl_slist_append(postHeaders, HEADER_CONTENT_TYPE_APP_JSON);
+
+    //Post JSON
+    json_object *post = json_object_new_object();
+    json_object *nameString = json_object_new_string(_newName.c_str());
+    json_object_object_add(post, "name", nameString);
+    if(!_parent.empty())
+    {
+        json_object *parentArray = json_object_new_array();
+        json_object *parentString = json_object_new_string(_parent.c_str());
+        json_object_array_add(parentArray, parentString);
+        json_object_object_add(post, "parents", parentArray);
+    }
+
+    //Curl
+    std::string *jsonResp = new std::string;
+    CURL *curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_HTTPPOST, 1);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, postHeaders);
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(post));
+    int error = curlFuncs::perform(curl);
+
+    json_object *respParse = json_tokener_parse(jsonResp->c_str()), *id = NULL;
+    json_object_object_get_ex(respParse, "id", &id);
+    if(error == CURLE_OK && id)
+    {
+        //Copy keeps the size of the source
+        rfs::RfsItem newFile;
+        newFile.name = _newName;
+        newFile.id = json_object_get_string(id);
+        newFile.isDir = false;
+        newFile.size = 0;
+        newFile.parent = _parent;
+        std::lock_guard<std::mutex> lock(listLock);
+        for(unsigned i = 0; i < driveList.size(); i++)
+        {
+            if(driveList[i].id == _fileID)
+            {
+                newFile.size = driveList[i].size;
+                break;
+            }
+        }
+        driveList.push_back(newFile);
+        ret = true;
+    }
+    else if(error == CURLE_OK)
+        writeDriveError("copyFile", jsonResp->c_str());
+    else
+        writeCurlError("copyFile", error);
+
+    delete jsonResp;
+    json_object_put(post);
+    json_object_put(respParse);
+    curl_slist_free_all(postHeaders);
+    curl_easy_cleanup(curl);
+    return ret;
+}
+
+bool drive::gd::moveFile(const std::string& _fileID, const std::string& _newName, const std::string& _parent)
+{
+    checkToken();
+
+    bool ret = false;
+
+    bool known = false;
+    std::string oldParent;
+    {
+        std::lock_guard<std::mutex> lock(listLock);
+        for(unsigned i = 0; i < driveList.size(); i++)
+        {
+            if(driveList[i].id == _fileID)
+            {
+                known = true;
+                oldParent = driveList[i].parent;
+                break;
+            }
+        }
+    }
+
+    //URL. Moving is just swapping parents
+    std::string url = driveURL;
+    url.append("/" + _fileID);
+    if(known && oldParent != _parent)
+        url.append("?addParents=" + _parent + "&removeParents=" + oldParent);
+    else if(!known)
+        url.append("?addParents=" + _parent);
+
+    //Headers
+    curl_slist *patchHeaders = NULL;
+    patchHeaders = curl_slist_append(patchHeaders, std::string(HEADER_AUTHORIZATION + token).c_str());
+    patchHeaders = curl_slist_append(patchHeaders, HEADER_CONTENT_TYPE_APP_JSON);
+
+    //Patch JSON
+    json_object *patch = json_object_new_object();
+    json_object *nameString = json_object_new_string(_newName.c_str());
+    json_object_object_add(patch, "name", nameString);
+
+    //Curl
+    std::string *jsonResp = new std::string;
+    CURL *curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, patchHeaders);
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, jsonResp);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_object_get_string(patch));
+    int error = curlFuncs::perform(curl);
+
+    json_object *respParse = json_tokener_parse(jsonResp->c_str()), *checkError = NULL;
+    json_object_object_get_ex(respParse, "error", &checkError);
+    if(error == CURLE_OK && !checkError)
+    {
+        std::lock_guard<std::mutex> lock(listLock);
+        for(unsigned i = 0; i < driveList.size(); i++)
+        {
+            if(driveList[i].id == _fileID)
+            {
+                driveList[i].name = _newName;
+                driveList[i].parent = _parent;
+                break;
+            }
+        }
+        ret = true;
+    }
+    else if(error == CURLE_OK)
+        writeDriveError("moveFile", jsonResp->c_str());
+    else
+        writeCurlError("moveFile", error);
+
+    delete jsonResp;
+    json_object_put(patch);
+    json_object_put(respParse);
+    curl_slist_free_all(patchHeaders);
+    curl_easy_cleanup(curl);
+    return ret;
+}
+
 std::string drive::gd::getFileID(const std::string& _name, const std::string& _parent)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(!driveList[i].isDir && driveList[i].name == _name && driveList[i].parent == _parent)
@@ -627,6 +813,7 @@ std::string drive::gd::getFileID(const std::string& _name, const std::string& _p
 
 std::string drive::gd::getDirID(const std::string& _name)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(driveList[i].isDir && driveList[i].name == _name)
@@ -637,10 +824,158 @@ std::string drive::gd::getDirID(const std::string& _name)
 
 std::string drive::gd::getDirID(const std::string& _name, const std::string& _parent)
 {
+    std::lock_guard<std::mutex> lock(listLock);
     for(unsigned i = 0; i < driveList.size(); i++)
     {
         if(driveList[i].isDir && driveList[i].name == _name && driveList[i].parent == _parent)
             return driveList[i].id;
     }
     return "";
-}
\ No newline at end of file
+}
+
+void drive::gd::batchDeleteFile(const std::string& _fileID)
+{
+    batchItem newItem;
+    newItem.type = BATCH_DELETE;
+    newItem.id = _fileID;
+    std::lock_guard<std::mutex> lock(batchLock);
+    batchQueue.push_back(newItem);
+}
+
+bool drive::gd::batchExecute()
+{
+    //Taken out whole so the requests go out without holding the lock
+    std::vector<batchItem> queue;
+    {
+        std::lock_guard<std::mutex> lock(batchLock);
+        queue.swap(batchQueue);
+    }
+
+    if(queue.empty())
+        return true;
+
+    checkToken();
+
+    bool ret = true;
+    for(unsigned i = 0; i < queue.size(); i += DRIVE_BATCH_MAX)
+    {
+        unsigned end = i + DRIVE_BATCH_MAX > queue.size() ? queue.size() : i + DRIVE_BATCH_MAX;
+        std::vector<batchItem> send(queue.begin() + i, queue.begin() + end);
+        if(!batchSend(send))
+            ret = false;
+    }
+    return ret;
+}
+
+void drive::gd::deleteFiles(const std::vector<std::string>& _fileIDs)
+{
+    for(const std::string& fileID : _fileIDs)
+        batchDeleteFile(fileID);
+
+    batchExecute();
+}
+
+bool drive::gd::batchSend(const std::vector<batchItem>& _items)
+{
+    //Build multipart/mixed body. Each part is a full HTTP request
+    std::string body;
+    for(unsigned i = 0; i < _items.size(); i++)
+    {
+        body += "--" DRIVE_BATCH_BOUNDARY "\r\n";
+        body += "Content-Type: application/http\r\n";
+        body += "Content-ID: <item" + std::to_string(i) + ">\r\n\r\n";
+        switch(_items[i].type)
+        {
+            case BATCH_DELETE:
+                body += "DELETE /drive/v3/files/" + _items[i].id + "\r\n\r\n";
+                break;
+        }
+    }
+    body += "--" DRIVE_BATCH_BOUNDARY "--\r\n";
+
+    //Headers
+    curl_slist *postHeaders = NULL;
+    postHeaders = curl_slist_append(postHeaders, std::string(HEADER_AUTHORIZATION + token).c_str());
+    postHeaders = curl_slist_append(postHeaders, "Content-Type: multipart/mixed; boundary=" DRIVE_BATCH_BOUNDARY);
+
+    //Curl
+    std::string *resp = new std::string;
+    std::vector<std::string> *headers = new std::vector<std::string>;
+    CURL *curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_HTTPPOST, 1);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, postHeaders);
+    curl_easy_setopt(curl, CURLOPT_URL, driveBatchURL.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curlFuncs::writeHeaders);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, headers);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.length());
+    int error = curlFuncs::perform(curl);
+
+    bool ret = false;
+    std::string contentType = curlFuncs::getHeader("Content-Type", headers);
+    if(contentType == HEADER_ERROR)
+        contentType = curlFuncs::getHeader("content-type", headers);
+
+    size_t boundaryPos = contentType.find("boundary=");
+    if(error == CURLE_OK && boundaryPos != contentType.npos)
+    {
+        ret = true;
+        std::string delim = "--" + contentType.substr(boundaryPos + 9);
+
+        //Walk each response part. Content-ID maps it back to the request
+        size_t partPos = resp->find(delim);
+        while(partPos != resp->npos)
+        {
+            size_t partStart = partPos + delim.length();
+            size_t partEnd = resp->find(delim, partStart);
+            if(partEnd == resp->npos)
+                break;
+
+            std::string part = resp->substr(partStart, partEnd - partStart);
+            partPos = partEnd;
+
+            size_t idPos = part.find("response-item"), statusPos = part.find("HTTP/1.1 ");
+            if(idPos == part.npos || statusPos == part.npos)
+                continue;
+
+            unsigned index = strtoul(part.c_str() + idPos + 13, NULL, 10);
+            int status = strtol(part.c_str() + statusPos + 9, NULL, 10);
+            if(index >= _items.size())
+                continue;
+
+            const batchItem& item = _items[index];
+            if(status < 200 || status > 299)
+            {
+                writeDriveError("batchSend", part.substr(statusPos));
+                ret = false;
+                continue;
+            }
+
+            if(item.type == BATCH_DELETE)
+            {
+                std::lock_guard<std::mutex> lock(listLock);
+                for(unsigned i = 0; i < driveList.size(); i++)
+                {
+                    if(driveList[i].id == item.id)
+                    {
+                        driveList.erase(driveList.begin() + i);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    else if(error == CURLE_OK)
+        writeDriveError("batchSend", *resp);
+    else
+        writeCurlError("batchSend", error);
+
+    delete resp;
+    delete headers;
+    curl_slist_free_all(postHeaders);
+    curl_easy_cleanup(curl);
+    return ret;
+}
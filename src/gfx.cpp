@@ -1,35 +1,59 @@
 #include <stdio.h>
-#include <map>
+#include <vector>
+#include <list>
+#include <string>
+#include <unordered_map>
 #include <switch.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_SIZES_H
 
 #define VA_SIZE 1024
+//Glyphs are packed into a few of these instead of getting a texture each
+#define GLYPH_ATLAS_SIZE 1024
+#define GLYPH_ATLAS_COUNT 4
+//Keeps filtering from picking up the neighbouring glyph
+#define GLYPH_PADDING 1
+//Laid out strings kept around. Most of what's drawn is the same from frame to frame
+#define TEXT_LAYOUT_CACHE_SIZE 256
 
 #include "gfx.h"
 #include "file.h"
+#include "util.h"
 
 static SDL_Window *wind;
 SDL_Renderer *gfx::render;
 gfx::textureMgr *gfx::texMgr;
+//What NULL targets are drawn to. Only the frame while one is being composed
+static SDL_Texture *frame = NULL, *screenTarget = NULL;
+//SDL drops the clip rect when the target changes, so it's set again every time
+static SDL_Rect clipRect;
+static bool clipSet = false;
 
 static FT_Library lib;
 static FT_Face face[6];
 static int totalFonts = 0;
 static bool loaded = false;
 
+//Each face gets an FT_Size per font size the first time it's used. Switching is just activating them
+typedef struct
+{
+    FT_Size sizes[6];
+} fontSizeSet;
+
+static std::unordered_map<int, fontSizeSet> fontSizes;
+static int activeSize = 0;
+//Advance of every <char, font size> measured so far. Measuring doesn't need the glyph rendered or packed
+static std::unordered_map<uint64_t, int> advanceCache;
+
 static const SDL_Color *textcol;
 static SDL_Color red    = {0xFF, 0x00, 0x00, 0xFF};
 static SDL_Color green  = {0x00, 0xFF, 0x00, 0xFF};
 static SDL_Color blue   = {0x00, 0x99, 0xEE, 0xFF};
 static SDL_Color yellow = {0xF8, 0xFC, 0x00, 0xFF};
 
-static const uint32_t redMask   = 0xFF000000;
-static const uint32_t greenMask = 0x00FF0000;
-static const uint32_t blueMask  = 0x0000FF00;
-static const uint32_t alphaMask = 0x000000FF;
 static const uint32_t breakPoints[7] = {' ', L'　', '/', '_', '-', L'。', L'、'};
 
 static inline bool compClr(const SDL_Color *c1, const SDL_Color *c2)
@@ -37,16 +61,68 @@ static inline bool compClr(const SDL_Color *c1, const SDL_Color *c2)
     return (c1->r == c2->r) && (c1->b == c2->b) && (c1->g == c2->g) && (c1->a == c2->a);
 }
 
-//Cache glyph textures
+//Where a glyph is in the atlases
 typedef struct
 {
     uint16_t w, h;
     int advX, top, left;
-    SDL_Texture *tex;
+    int atlas, x, y;
 } glyphData;
 
-//<Char, font size>, tex
-std::map<std::pair<uint32_t, int>, glyphData> glyphCache;
+//Row of glyphs close to the same height. New ones go on the end
+typedef struct
+{
+    int y, h, x;
+} glyphShelf;
+
+typedef struct
+{
+    SDL_Texture *tex;
+    std::vector<glyphShelf> shelves;
+    int nextY;
+    //Text draw it was last used by. Oldest is cleared when they're all full
+    uint64_t lastUse;
+} glyphAtlas;
+
+//Glyphs waiting to be drawn, one batch per atlas
+typedef struct
+{
+    std::vector<SDL_Vertex> verts;
+    std::vector<int> inds;
+} glyphBatch;
+
+typedef struct
+{
+    int atlas;
+    //Relative to where the string is drawn
+    SDL_Vertex v[4];
+} layoutQuad;
+
+//A string with its markup handled, wrapped and turned into glyph quads
+typedef struct
+{
+    uint64_t hash;
+    std::string text;
+    int size, maxWidth;
+    SDL_Color color;
+    //Quads point into the atlases, so the layout is redone if one is cleared after this
+    uint64_t generation;
+    std::vector<layoutQuad> quads;
+} textLayout;
+
+//<Char, font size>
+static inline uint64_t glyphKey(uint32_t chr, int size)
+{
+    return (uint64_t)chr << 32 | (uint32_t)size;
+}
+
+static std::unordered_map<uint64_t, glyphData> glyphCache;
+static glyphAtlas atlases[GLYPH_ATLAS_COUNT];
+static glyphBatch batches[GLYPH_ATLAS_COUNT];
+static uint64_t textDrawCount = 0, atlasGeneration = 0;
+//Most recently used first
+static std::list<textLayout> layouts;
+static std::unordered_map<uint64_t, std::list<textLayout>::iterator> layoutMap;
 
 static bool loadSystemFont()
 {
@@ -81,9 +157,12 @@ static void freeSystemFont()
 {
     if(loaded)
     {
+        //Faces free their sizes
         for(int i = 0; i < totalFonts; i++)
             FT_Done_Face(face[i]);
 
+        fontSizes.clear();
+        activeSize = 0;
         FT_Done_FreeType(lib);
     }
 
@@ -104,9 +183,23 @@ void gfx::init()
     SDL_SetRenderDrawBlendMode(render, SDL_BLENDMODE_BLEND);
 
     gfx::texMgr = new gfx::textureMgr;
+    gfx::texMgr->setBudget(util::isApplet() ? TEXTURE_BUDGET_APPLET : TEXTURE_BUDGET);
+
+    //Copied over the whole screen as is
+    frame = gfx::texMgr->textureCreate(1280, 720);
+    SDL_SetTextureBlendMode(frame, SDL_BLENDMODE_NONE);
 
     loadSystemFont();
 
+    for(int i = 0; i < GLYPH_ATLAS_COUNT; i++)
+    {
+        atlases[i].tex = SDL_CreateTexture(render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE);
+        SDL_SetTextureBlendMode(atlases[i].tex, SDL_BLENDMODE_BLEND);
+        gfx::texMgr->textureAdd(atlases[i].tex);
+        atlases[i].nextY = 0;
+        atlases[i].lastUse = 0;
+    }
+
     //This is to avoid blank, black glyphs
     for(unsigned i = 0x20; i < 0x7E; i++)
         gfx::drawTextf(NULL, 18, 32, 32, &ui::txtCont, "%c", i);
@@ -125,12 +218,61 @@ void gfx::exit()
 void gfx::present()
 {
     SDL_RenderPresent(render);
+    gfx::texMgr->nextFrame();
 }
 
-static inline void resizeFont(int sz)
+void gfx::frameBegin()
 {
-    for(int i = 0; i < totalFonts; i++)
-        FT_Set_Char_Size(face[i], 0, sz * 64, 90, 90);
+    screenTarget = frame;
+}
+
+void gfx::frameEnd()
+{
+    screenTarget = NULL;
+}
+
+void gfx::frameDraw()
+{
+    SDL_SetRenderTarget(render, NULL);
+    SDL_RenderCopy(render, frame, NULL, NULL);
+}
+
+void gfx::setTarget(SDL_Texture *target)
+{
+    SDL_SetRenderTarget(render, target ? target : screenTarget);
+    SDL_RenderSetClipRect(render, clipSet ? &clipRect : NULL);
+}
+
+void gfx::setClip(const SDL_Rect *clip)
+{
+    clipSet = clip != NULL;
+    if(clipSet)
+        clipRect = *clip;
+}
+
+static void resizeFont(int sz)
+{
+    if(sz == activeSize)
+        return;
+
+    auto find = fontSizes.find(sz);
+    if(find != fontSizes.end())
+    {
+        for(int i = 0; i < totalFonts; i++)
+            FT_Activate_Size(find->second.sizes[i]);
+    }
+    else
+    {
+        fontSizeSet add;
+        for(int i = 0; i < totalFonts; i++)
+        {
+            FT_New_Size(face[i], &add.sizes[i]);
+            FT_Activate_Size(add.sizes[i]);
+            FT_Set_Char_Size(face[i], 0, sz * 64, 90, 90);
+        }
+        fontSizes[sz] = add;
+    }
+    activeSize = sz;
 }
 
 static inline FT_GlyphSlot loadGlyph(const uint32_t c, FT_Int32 flags)
@@ -144,42 +286,174 @@ static inline FT_GlyphSlot loadGlyph(const uint32_t c, FT_Int32 flags)
     return NULL;
 }
 
+static void textFlush()
+{
+    for(int i = 0; i < GLYPH_ATLAS_COUNT; i++)
+    {
+        glyphBatch& b = batches[i];
+        if(b.verts.empty())
+            continue;
+
+        SDL_RenderGeometry(gfx::render, atlases[i].tex, b.verts.data(), b.verts.size(), b.inds.data(), b.inds.size());
+        b.verts.clear();
+        b.inds.clear();
+    }
+}
+
+static void layoutAddGlyph(textLayout& l, const glyphData *g, int x, int y, const SDL_Color *c)
+{
+    layoutQuad q;
+    float left = x, top = y, right = x + g->w, bottom = y + g->h;
+    float u0 = (float)g->x / GLYPH_ATLAS_SIZE, v0 = (float)g->y / GLYPH_ATLAS_SIZE;
+    float u1 = (float)(g->x + g->w) / GLYPH_ATLAS_SIZE, v1 = (float)(g->y + g->h) / GLYPH_ATLAS_SIZE;
+    SDL_Color vc = {c->r, c->g, c->b, 0xFF};
+
+    q.atlas = g->atlas;
+    q.v[0] = {{left, top}, vc, {u0, v0}};
+    q.v[1] = {{right, top}, vc, {u1, v0}};
+    q.v[2] = {{right, bottom}, vc, {u1, v1}};
+    q.v[3] = {{left, bottom}, vc, {u0, v1}};
+    l.quads.push_back(q);
+}
+
+static void textAddLayout(const textLayout& l, int x, int y)
+{
+    static const int quadInds[6] = {0, 1, 2, 0, 2, 3};
+    for(const layoutQuad& q : l.quads)
+    {
+        glyphBatch& b = batches[q.atlas];
+        int first = b.verts.size();
+        for(int i = 0; i < 4; i++)
+        {
+            SDL_Vertex v = q.v[i];
+            v.position.x += x;
+            v.position.y += y;
+            b.verts.push_back(v);
+        }
+
+        for(int i = 0; i < 6; i++)
+            b.inds.push_back(first + quadInds[i]);
+
+        atlases[q.atlas].lastUse = textDrawCount;
+    }
+}
+
+//Shortest shelf the glyph fits on, as long as it is no more than a third taller. Otherwise a new shelf is started
+static bool atlasPack(glyphAtlas& a, int w, int h, int& x, int& y)
+{
+    glyphShelf *best = NULL;
+    for(glyphShelf& shelf : a.shelves)
+    {
+        if(shelf.h >= h && shelf.h <= h + h / 3 + 1 && shelf.x + w <= GLYPH_ATLAS_SIZE && (!best || shelf.h < best->h))
+            best = &shelf;
+    }
+
+    if(!best)
+    {
+        if(a.nextY + h > GLYPH_ATLAS_SIZE)
+            return false;
+
+        a.shelves.push_back({a.nextY, h, 0});
+        a.nextY += h;
+        best = &a.shelves.back();
+    }
+
+    x = best->x;
+    y = best->y;
+    best->x += w;
+    return true;
+}
+
+//Empties the least recently used atlas and drops everything that was in it
+static int atlasEvict()
+{
+    int oldest = 0;
+    for(int i = 1; i < GLYPH_ATLAS_COUNT; i++)
+    {
+        if(atlases[i].lastUse < atlases[oldest].lastUse)
+            oldest = i;
+    }
+
+    //Anything already queued from it has to go out before it's overwritten
+    textFlush();
+    ++atlasGeneration;
+    atlases[oldest].shelves.clear();
+    atlases[oldest].nextY = 0;
+    for(auto g = glyphCache.begin(); g != glyphCache.end(); )
+    {
+        if(g->second.atlas == oldest)
+            g = glyphCache.erase(g);
+        else
+            ++g;
+    }
+    return oldest;
+}
+
 static glyphData *getGlyph(uint32_t chr, int size)
 {
-    //If it's already been loaded and rendered, grab the texture
-    if(glyphCache.find(std::make_pair(chr, size)) != glyphCache.end())
-        return &glyphCache[std::make_pair(chr, size)];
+    //If it's already been loaded and packed, use it
+    uint64_t key = glyphKey(chr, size);
+    auto cached = glyphCache.find(key);
+    if(cached != glyphCache.end())
+        return &cached->second;
 
     //Load glyph with Freetype
+    resizeFont(size);
     FT_GlyphSlot glyph = loadGlyph(chr, FT_LOAD_RENDER);
-    FT_Bitmap bmp = glyph->bitmap;
-    if(bmp.pixel_mode != FT_PIXEL_MODE_GRAY)
+    if(!glyph)
         return NULL;
 
-    //Convert to SDL_Surface -> Texture
-    SDL_Texture *tex;
-    size_t glyphSize = bmp.rows * bmp.width;
-    uint8_t *bmpPtr = bmp.buffer;
-    uint32_t basePixel = 0xFFFFFF00;
-    uint32_t *tmpBuff = (uint32_t *)malloc(sizeof(uint32_t) * glyphSize);
+    FT_Bitmap bmp = glyph->bitmap;
+    if(bmp.pixel_mode != FT_PIXEL_MODE_GRAY || bmp.width + GLYPH_PADDING > GLYPH_ATLAS_SIZE || bmp.rows + GLYPH_PADDING > GLYPH_ATLAS_SIZE)
+        return NULL;
 
-    //Loop through and fill out buffer
-    for(size_t i = 0; i < glyphSize; i++)
-        tmpBuff[i] = basePixel | *bmpPtr++;
+    glyphData add = {(uint16_t)bmp.width, (uint16_t)bmp.rows, (int)glyph->advance.x >> 6, glyph->bitmap_top, glyph->bitmap_left, 0, 0, 0};
+    advanceCache[key] = add.advX;
+    if(bmp.width > 0 && bmp.rows > 0)
+    {
+        int packW = bmp.width + GLYPH_PADDING, packH = bmp.rows + GLYPH_PADDING;
+        add.atlas = -1;
+        for(int i = 0; i < GLYPH_ATLAS_COUNT && add.atlas == -1; i++)
+        {
+            if(atlasPack(atlases[i], packW, packH, add.x, add.y))
+                add.atlas = i;
+        }
 
-    SDL_Surface *tmpSurf = SDL_CreateRGBSurfaceFrom(tmpBuff, bmp.width, bmp.rows, 32, 4 * bmp.width, redMask, greenMask, blueMask, alphaMask);
-    tex = SDL_CreateTextureFromSurface(gfx::render, tmpSurf);
+        if(add.atlas == -1)
+        {
+            add.atlas = atlasEvict();
+            atlasPack(atlases[add.atlas], packW, packH, add.x, add.y);
+        }
 
-    SDL_FreeSurface(tmpSurf);
-    free(tmpBuff);
+        //White with the glyph as alpha so vertex color tints it
+        std::vector<uint32_t> pixels(bmp.width * bmp.rows);
+        for(unsigned row = 0; row < bmp.rows; row++)
+        {
+            uint8_t *bmpPtr = bmp.buffer + row * bmp.pitch;
+            for(unsigned col = 0; col < bmp.width; col++)
+                pixels[row * bmp.width + col] = 0xFFFFFF00 | bmpPtr[col];
+        }
 
-    //Add it to texture manager so textures are freed on exit
-    gfx::texMgr->textureAdd(tex);
+        SDL_Rect dst = {add.x, add.y, (int)bmp.width, (int)bmp.rows};
+        SDL_UpdateTexture(atlases[add.atlas].tex, &dst, pixels.data(), bmp.width * sizeof(uint32_t));
+    }
 
-    //Add it to cache map
-    glyphCache[std::make_pair(chr, size)] = {(uint16_t)bmp.width, (uint16_t)bmp.rows, (int)glyph->advance.x >> 6, glyph->bitmap_top, glyph->bitmap_left, tex};
+    return &(glyphCache[key] = add);
+}
 
-    return &glyphCache[std::make_pair(chr, size)];
+//Glyphs that don't exist measure 0, same as they draw
+static int getGlyphAdvance(uint32_t chr, int size)
+{
+    uint64_t key = glyphKey(chr, size);
+    auto cached = advanceCache.find(key);
+    if(cached != advanceCache.end())
+        return cached->second;
+
+    resizeFont(size);
+    FT_GlyphSlot glyph = loadGlyph(chr, FT_LOAD_DEFAULT);
+    int advance = glyph ? (int)glyph->advance.x >> 6 : 0;
+    advanceCache[key] = advance;
+    return advance;
 }
 
 //Takes care of special characters/color switching
@@ -230,48 +504,6 @@ static inline bool specialChar(const uint32_t *p, const int *fontSize, const SDL
     return ret;
 }
 
-void gfx::drawTextf(SDL_Texture *target, int fontSize, int x, int y, const SDL_Color *c, const char *fmt, ...)
-{
-    SDL_SetRenderTarget(gfx::render, target);
-    char tmp[VA_SIZE];
-    va_list args;
-    va_start(args, fmt);
-    vsprintf(tmp, fmt, args);
-    va_end(args);
-
-    int tmpX = x;
-    uint32_t point = 0;
-    ssize_t unitCnt = 0;
-    size_t textLength = strlen(tmp);
-
-    resizeFont(fontSize);
-
-    textcol = c;
-
-    for(unsigned i = 0; i < textLength; )
-    {
-        unitCnt = decode_utf8(&point, (const uint8_t *)&tmp[i]);
-        if(unitCnt <= 0)
-            break;
-
-        i += unitCnt;
-        if(specialChar(&point, &fontSize, c, &x, &tmpX, &y))
-            continue;
-
-        glyphData *g = getGlyph(point, fontSize);
-        if(g != NULL)
-        {
-            SDL_Rect src = {0, 0, g->w, g->h};
-            SDL_Rect dst = {tmpX + g->left, y + (fontSize - g->top), g->w, g->h};
-            SDL_SetTextureColorMod(g->tex, textcol->r, textcol->g, textcol->b);
-            SDL_RenderCopy(render, g->tex, &src, &dst);
-
-            tmpX += g->advX;
-        }
-    }
-    SDL_SetRenderTarget(gfx::render, NULL);
-}
-
 inline bool isBreakChar(uint32_t point)
 {
     for(int i = 0; i < 7; i++)
@@ -299,67 +531,149 @@ inline size_t findNextBreak(const char *str)
     return length;
 }
 
-void gfx::drawTextfWrap(SDL_Texture *target, int fontSize, int x, int y, int maxWidth, const SDL_Color *c, const char *fmt, ...)
+//maxWidth of 0 doesn't wrap
+static void layoutText(textLayout& l)
 {
-    SDL_SetRenderTarget(gfx::render, target);
-    char tmp[VA_SIZE], wordBuff[128];
-    va_list args;
-    va_start(args, fmt);
-    vsprintf(tmp, fmt, args);
-    va_end(args);
-
-    resizeFont(fontSize);
-    size_t nextBreak = 0, strlength = strlen(tmp);
-    int tmpX = x;
-
-    textcol = c;
-
-    for(unsigned i = 0; i < strlength; )
+    //A glyph added later can clear an atlas that earlier ones went into. Second pass finds them all cached
+    for(int pass = 0; pass < 2 && (pass == 0 || l.generation != atlasGeneration); pass++)
     {
-        nextBreak = findNextBreak(&tmp[i]);
-        memset(wordBuff, 0, 128);
-        memcpy(wordBuff, &tmp[i], nextBreak);
+        const char *str = l.text.c_str();
+        int fontSize = l.size, baseX = 0, tmpX = 0, y = 0;
+        size_t length = l.text.length();
 
-        size_t width = gfx::getTextWidth(wordBuff, fontSize);
+        textcol = &l.color;
+        l.quads.clear();
+        l.generation = atlasGeneration;
 
-        if((int)(tmpX + width) >= (int)(x + maxWidth))
+        for(unsigned i = 0; i < length; )
         {
-            tmpX = x;
-            y += fontSize + 8;
+            size_t wordLength = length - i;
+            if(l.maxWidth > 0)
+            {
+                char wordBuff[128];
+                size_t nextBreak = findNextBreak(&str[i]);
+                memset(wordBuff, 0, 128);
+                memcpy(wordBuff, &str[i], nextBreak);
+
+                size_t width = gfx::getTextWidth(wordBuff, fontSize);
+                if((int)(tmpX + width) >= l.maxWidth)
+                {
+                    tmpX = baseX;
+                    y += fontSize + 8;
+                }
+                wordLength = strlen(wordBuff);
+            }
+
+            uint32_t point = 0;
+            for(unsigned j = 0; j < wordLength; )
+            {
+                ssize_t unitCnt = decode_utf8(&point, (const uint8_t *)&str[i + j]);
+                if(unitCnt <= 0)
+                    break;
+
+                j += unitCnt;
+                if(specialChar(&point, &fontSize, &l.color, &baseX, &tmpX, &y))
+                    continue;
+
+                glyphData *g = getGlyph(point, fontSize);
+                if(g != NULL)
+                {
+                    if(g->w > 0)
+                        layoutAddGlyph(l, g, tmpX + g->left, y + (fontSize - g->top), textcol);
+
+                    tmpX += g->advX;
+                }
+            }
+            i += wordLength;
         }
+    }
+}
 
-        size_t wordLength = strlen(wordBuff);
-        uint32_t point = 0;
-        for(unsigned j = 0; j < wordLength; )
-        {
-            ssize_t unitCnt = decode_utf8(&point, (const uint8_t *)&wordBuff[j]);
-            if(unitCnt <= 0)
-                break;
+static uint64_t layoutHash(const char *str, int fontSize, int maxWidth, const SDL_Color *c)
+{
+    //FNV-1a
+    uint64_t hash = 0xCBF29CE484222325;
+    for(const char *p = str; *p; p++)
+        hash = (hash ^ (uint8_t)*p) * 0x100000001B3;
 
-            j += unitCnt;
+    uint32_t params[3] = {(uint32_t)fontSize, (uint32_t)maxWidth, (uint32_t)(c->r << 24 | c->g << 16 | c->b << 8 | c->a)};
+    for(uint32_t param : params)
+        hash = (hash ^ param) * 0x100000001B3;
 
-            if(specialChar(&point, &fontSize, c, &x, &tmpX, &y))
-                continue;
+    return hash;
+}
 
-            glyphData *g = getGlyph(point, fontSize);
-            if(g != NULL)
-            {
-                SDL_Rect src = {0, 0, g->w, g->h};
-                SDL_Rect dst = {tmpX + g->left, y + (fontSize - g->top), g->w, g->h};
-                SDL_SetTextureColorMod(g->tex, textcol->r, textcol->g, textcol->b);
-                SDL_RenderCopy(render, g->tex, &src, &dst);
+static const textLayout& getLayout(const char *str, int fontSize, int maxWidth, const SDL_Color *c)
+{
+    uint64_t hash = layoutHash(str, fontSize, maxWidth, c);
+    auto find = layoutMap.find(hash);
+    if(find != layoutMap.end())
+    {
+        textLayout& l = *find->second;
+        if(l.size == fontSize && l.maxWidth == maxWidth && compClr(&l.color, c) && l.text == str)
+        {
+            layouts.splice(layouts.begin(), layouts, find->second);
+            if(l.generation != atlasGeneration)
+                layoutText(l);
 
-                tmpX += g->advX;
-            }
+            return l;
         }
-        i += wordLength;
+
+        //Different string with the same hash. It gets replaced
+        layouts.erase(find->second);
+        layoutMap.erase(find);
+    }
+
+    if(layouts.size() >= TEXT_LAYOUT_CACHE_SIZE)
+    {
+        layoutMap.erase(layouts.back().hash);
+        layouts.pop_back();
     }
-    SDL_SetRenderTarget(gfx::render, NULL);
+
+    layouts.emplace_front();
+    textLayout& l = layouts.front();
+    l.hash = hash;
+    l.text = str;
+    l.size = fontSize;
+    l.maxWidth = maxWidth;
+    l.color = *c;
+    layoutMap[hash] = layouts.begin();
+    layoutText(l);
+    return l;
+}
+
+void gfx::drawTextf(SDL_Texture *target, int fontSize, int x, int y, const SDL_Color *c, const char *fmt, ...)
+{
+    gfx::setTarget(target);
+    char tmp[VA_SIZE];
+    va_list args;
+    va_start(args, fmt);
+    vsprintf(tmp, fmt, args);
+    va_end(args);
+
+    ++textDrawCount;
+    textAddLayout(getLayout(tmp, fontSize, 0, c), x, y);
+    textFlush();
+    gfx::setTarget(NULL);
+}
+
+void gfx::drawTextfWrap(SDL_Texture *target, int fontSize, int x, int y, int maxWidth, const SDL_Color *c, const char *fmt, ...)
+{
+    gfx::setTarget(target);
+    char tmp[VA_SIZE];
+    va_list args;
+    va_start(args, fmt);
+    vsprintf(tmp, fmt, args);
+    va_end(args);
+
+    ++textDrawCount;
+    textAddLayout(getLayout(tmp, fontSize, maxWidth, c), x, y);
+    textFlush();
+    gfx::setTarget(NULL);
 }
 
 size_t gfx::getTextWidth(const char *str, int fontSize)
 {
-    resizeFont(fontSize);
     size_t width = 0, strlength = strlen(str);
     uint32_t unitCnt = 0, point = 0;
 
@@ -375,9 +689,7 @@ size_t gfx::getTextWidth(const char *str, int fontSize)
         if(point == '\n' || point == '#' || point == '*' || point == '<' || point == '>')
             continue;
 
-        glyphData *g = getGlyph(point, fontSize);
-        if(g != NULL)
-            width += g->advX;
+        width += getGlyphAdvance(point, fontSize);
     }
     return width;
 }
@@ -387,7 +699,7 @@ void gfx::texDraw(SDL_Texture *target, SDL_Texture *tex, int x, int y)
     int tW = 0, tH = 0;
     if(SDL_QueryTexture(tex, NULL, NULL, &tW, &tH) == 0)
     {
-        SDL_SetRenderTarget(gfx::render, target);
+        gfx::setTarget(target);
         SDL_Rect src = {0, 0, tW, tH};
         SDL_Rect pos = {x, y, tW, tH};
         SDL_RenderCopy(gfx::render, tex, &src, &pos);
@@ -399,7 +711,7 @@ void gfx::texDrawStretch(SDL_Texture *target, SDL_Texture *tex, int x, int y, in
     int tW = 0, tH = 0;
     if(SDL_QueryTexture(tex, NULL, NULL, &tW, &tH) == 0)
     {
-        SDL_SetRenderTarget(gfx::render, target);
+        gfx::setTarget(target);
         SDL_Rect src = {0, 0, tW, tH};
         SDL_Rect pos = {x, y, w, h};
         SDL_RenderCopy(gfx::render, tex, &src, &pos);
@@ -410,20 +722,20 @@ void gfx::texDrawPart(SDL_Texture *target, SDL_Texture *tex, int srcX, int srcY,
 {
     SDL_Rect src = {srcX, srcY, srcW, srcH};
     SDL_Rect dst = {dstX, dstY, srcW, srcH};
-    SDL_SetRenderTarget(gfx::render, target);
+    gfx::setTarget(target);
     SDL_RenderCopy(gfx::render, tex, &src, &dst);
 }
 
 void gfx::drawLine(SDL_Texture *target, const SDL_Color *c, int x1, int y1, int x2, int y2)
 {
-    SDL_SetRenderTarget(gfx::render, target);
+    gfx::setTarget(target);
     SDL_SetRenderDrawColor(gfx::render, c->r, c->g, c->b, c->a);
     SDL_RenderDrawLine(gfx::render, x1, y1, x2, y2);
 }
 
 void gfx::drawRect(SDL_Texture *target, const SDL_Color *c, int x, int y, int w, int h)
 {
-    SDL_SetRenderTarget(gfx::render, target);
+    gfx::setTarget(target);
     SDL_SetRenderDrawColor(gfx::render, c->r, c->g, c->b, c->a);
     SDL_Rect rect = {x, y, w, h};
     SDL_RenderFillRect(gfx::render, &rect);
@@ -431,7 +743,7 @@ void gfx::drawRect(SDL_Texture *target, const SDL_Color *c, int x, int y, int w,
 
 void gfx::clearTarget(SDL_Texture *target, const SDL_Color *clear)
 {
-    SDL_SetRenderTarget(gfx::render, target);
+    gfx::setTarget(target);
     SDL_SetRenderDrawColor(gfx::render, clear->r, clear->g, clear->b, clear->a);
     SDL_RenderClear(gfx::render);
 }
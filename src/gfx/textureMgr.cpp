@@ -1,29 +1,81 @@
-#include <vector>
-#include <algorithm>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 
 #include "gfx.h"
 
+//RGBA8888 for everything made here
+static size_t textureSize(SDL_Texture *_tex)
+{
+    int w = 0, h = 0;
+    SDL_QueryTexture(_tex, NULL, NULL, &w, &h);
+    return w * h * sizeof(uint32_t);
+}
+
 gfx::textureMgr::~textureMgr()
 {
-    for(auto tex : textures)
+    for(auto& tex : textures)
+        SDL_DestroyTexture(tex.first);
+}
+
+void gfx::textureMgr::track(SDL_Texture *_tex)
+{
+    textureEntry& e = textures[_tex];
+    e.size = textureSize(_tex);
+    e.evictable = false;
+    e.key = 0;
+    e.lastUse = frame;
+    e.evictFunc = NULL;
+    used += e.size;
+}
+
+void gfx::textureMgr::untrack(SDL_Texture *_tex)
+{
+    auto find = textures.find(_tex);
+    if(find == textures.end())
+        return;
+
+    if(find->second.evictable)
+        lru.erase(find->second.lruPos);
+
+    used -= find->second.size;
+    textures.erase(find);
+}
+
+void gfx::textureMgr::makeRoom(size_t _need)
+{
+    //Oldest are at the back. Anything used this frame or the last is probably on screen
+    while(used + _need > budget && !lru.empty())
+    {
+        SDL_Texture *tex = lru.back();
+        textureEntry& e = textures[tex];
+        if(e.lastUse + 1 >= frame)
+            break;
+
+        uint64_t key = e.key;
+        textureEvictFunc func = e.evictFunc;
+        untrack(tex);
         SDL_DestroyTexture(tex);
+        ++evictCount;
+        if(func)
+            (*func)(key);
+    }
 }
 
 void gfx::textureMgr::textureAdd(SDL_Texture *_tex)
 {
-    textures.push_back(_tex);
+    makeRoom(textureSize(_tex));
+    track(_tex);
 }
 
 SDL_Texture *gfx::textureMgr::textureCreate(int _w, int _h)
 {
     SDL_Texture *ret = NULL;
+    makeRoom(_w * _h * sizeof(uint32_t));
     ret = SDL_CreateTexture(gfx::render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC | SDL_TEXTUREACCESS_TARGET, _w, _h);
     if(ret)
     {
         SDL_SetTextureBlendMode(ret, SDL_BLENDMODE_BLEND);
-        textures.push_back(ret);
+        track(ret);
     }
     return ret;
 }
@@ -34,10 +86,14 @@ SDL_Texture *gfx::textureMgr::textureLoadFromFile(const char *_path)
     SDL_Surface *tmp = IMG_Load(_path);
     if(tmp)
     {
+        makeRoom(tmp->w * tmp->h * sizeof(uint32_t));
         ret = SDL_CreateTextureFromSurface(gfx::render, tmp);
-        textures.push_back(ret);
         SDL_FreeSurface(tmp);
-        SDL_SetTextureBlendMode(ret, SDL_BLENDMODE_BLEND);
+        if(ret)
+        {
+            SDL_SetTextureBlendMode(ret, SDL_BLENDMODE_BLEND);
+            track(ret);
+        }
     }
     return ret;
 }
@@ -106,19 +162,64 @@ SDL_Texture *gfx::textureMgr::textureLoadFromMem(imgTypes _type, const void *_da
     }
 
     if(ret)
-        textures.push_back(ret);
+        textureAdd(ret);
 
     return ret;
 }
 
-void gfx::textureMgr::textureResize(SDL_Texture **_tex, int _w, int _h)
+SDL_Texture *gfx::textureMgr::textureLoadFromPixels(const void *_pixels, int _w, int _h)
 {
-    auto texIt = std::find(textures.begin(), textures.end(), *_tex);
-    if(texIt != textures.end())
+    makeRoom(_w * _h * sizeof(uint32_t));
+    SDL_Texture *ret = SDL_CreateTexture(gfx::render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, _w, _h);
+    if(ret)
     {
-        SDL_DestroyTexture(*texIt);
-        *_tex = SDL_CreateTexture(gfx::render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC | SDL_TEXTUREACCESS_TARGET, _w, _h);
-        SDL_SetTextureBlendMode(*_tex, SDL_BLENDMODE_BLEND);
-        *texIt = *_tex;
+        SDL_UpdateTexture(ret, NULL, _pixels, _w * sizeof(uint32_t));
+        SDL_SetTextureBlendMode(ret, SDL_BLENDMODE_BLEND);
+        track(ret);
     }
-}
\ No newline at end of file
+    return ret;
+}
+
+void gfx::textureMgr::textureResize(SDL_Texture **_tex, int _w, int _h)
+{
+    if(textures.find(*_tex) == textures.end())
+        return;
+
+    textureDestroy(*_tex);
+    *_tex = textureCreate(_w, _h);
+}
+
+void gfx::textureMgr::textureDestroy(SDL_Texture *_tex)
+{
+    if(textures.find(_tex) == textures.end())
+        return;
+
+    untrack(_tex);
+    SDL_DestroyTexture(_tex);
+}
+
+void gfx::textureMgr::textureSetEvictable(SDL_Texture *_tex, uint64_t _key, textureEvictFunc _func)
+{
+    auto find = textures.find(_tex);
+    if(find == textures.end() || find->second.evictable)
+        return;
+
+    textureEntry& e = find->second;
+    e.evictable = true;
+    e.key = _key;
+    e.evictFunc = _func;
+    e.lastUse = frame;
+    lru.push_front(_tex);
+    e.lruPos = lru.begin();
+}
+
+void gfx::textureMgr::textureTouch(SDL_Texture *_tex)
+{
+    auto find = textures.find(_tex);
+    if(find == textures.end() || !find->second.evictable)
+        return;
+
+    textureEntry& e = find->second;
+    e.lastUse = frame;
+    lru.splice(lru.begin(), lru, e.lruPos);
+}
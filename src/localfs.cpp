@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include "localfs.h"
+#include "fs.h"
+
+// Straight file to file. stdio buffering is turned off so every chunk is only copied once
+static bool copyStream(FILE *in, FILE *out, uint64_t *progress, bool *cancel, curlFuncs::streamStage *tap) {
+    setvbuf(out, NULL, _IONBF, 0);
+
+    // Same source curl reads through, so a tap sees the same data either way
+    curlFuncs::fileSource src(in, tap);
+    std::vector<uint8_t> buffer(LOCAL_COPY_BUFFER_SIZE);
+    uint64_t total = 0;
+    ssize_t read = 0;
+    while((read = src.read(buffer.data(), LOCAL_COPY_BUFFER_SIZE)) > 0) {
+        if(cancel && *cancel)
+            return false;
+
+        if(fwrite(buffer.data(), 1, read, out) != (size_t)read)
+            return false;
+
+        total += read;
+        if(progress)
+            *progress = total;
+    }
+    return read == 0;
+}
+
+static bool copyPath(const std::string& src, const std::string& dst, uint64_t *progress, bool *cancel, curlFuncs::streamStage *tap) {
+    FILE *in = fopen(src.c_str(), "rb");
+    if(!in)
+        return false;
+
+    FILE *out = fopen(dst.c_str(), "wb");
+    if(!out) {
+        fclose(in);
+        return false;
+    }
+
+    setvbuf(in, NULL, _IONBF, 0);
+    bool ret = copyStream(in, out, progress, cancel, tap);
+    fclose(in);
+    ret = fclose(out) == 0 && ret;
+    return ret;
+}
+
+// Puts temp in dst's place. rename won't overwrite here, so dst is only removed once temp is complete
+static bool replacePath(const std::string& temp, const std::string& dst) {
+    if(rename(temp.c_str(), dst.c_str()) == 0)
+        return true;
+
+    remove(dst.c_str());
+    return rename(temp.c_str(), dst.c_str()) == 0;
+}
+
+std::string rfs::LocalFS::appendResourceToParentId(const std::string& resourceName, const std::string& parentId, bool isDir) {
+    return parentId + resourceName + (isDir ? "/" : "");
+}
+
+bool rfs::LocalFS::createDir(const std::string& dirName, const std::string& parentId) {
+    std::string path = appendResourceToParentId(dirName, parentId, false);
+    if(mkdir(path.c_str(), 777) != 0) {
+        fs::logWrite("LocalFS: directory creation failed: %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool rfs::LocalFS::dirExists(const std::string& dirName, const std::string& parentId) {
+    struct stat s;
+    std::string path = appendResourceToParentId(dirName, parentId, false);
+    return stat(path.c_str(), &s) == 0 && S_ISDIR(s.st_mode);
+}
+
+bool rfs::LocalFS::fileExists(const std::string& filename, const std::string& parentId) {
+    struct stat s;
+    std::string path = appendResourceToParentId(filename, parentId, false);
+    return stat(path.c_str(), &s) == 0 && S_ISREG(s.st_mode);
+}
+
+void rfs::LocalFS::uploadFile(const std::string& filename, const std::string& parentId, curlFuncs::curlUpArgs *_upload) {
+    updateFile(appendResourceToParentId(filename, parentId, false), _upload);
+}
+
+void rfs::LocalFS::updateFile(const std::string& fileID, curlFuncs::curlUpArgs *_upload) {
+    FILE *out = fopen(fileID.c_str(), "wb");
+    if(!out) {
+        fs::logWrite("LocalFS: failed to open %s for writing\n", fileID.c_str());
+        return;
+    }
+
+    if(!copyStream(_upload->f, out, _upload->o, _upload->cancel, _upload->tap))
+        fs::logWrite("LocalFS: file upload failed: %s\n", fileID.c_str());
+
+    fclose(out);
+}
+
+void rfs::LocalFS::downloadFile(const std::string& fileID, curlFuncs::curlDlArgs *_download) {
+    if(!copyPath(fileID, _download->path, _download->o, _download->cancel, _download->tap))
+        fs::logWrite("LocalFS: file download failed: %s\n", fileID.c_str());
+}
+
+void rfs::LocalFS::deleteFile(const std::string& fileID) {
+    if(!fileID.empty() && fileID.back() == '/')
+        fs::delDir(fileID);
+    else if(remove(fileID.c_str()) != 0)
+        fs::logWrite("LocalFS: file deletion failed: %s\n", fileID.c_str());
+}
+
+bool rfs::LocalFS::copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    std::string dst = appendResourceToParentId(newName, parentId, false);
+    std::string temp = dst + LOCAL_TEMP_EXT;
+    if(!copyPath(fileID, temp, NULL, NULL, NULL)) {
+        remove(temp.c_str());
+        fs::logWrite("LocalFS: copy failed: %s -> %s\n", fileID.c_str(), dst.c_str());
+        return false;
+    }
+
+    if(!replacePath(temp, dst)) {
+        remove(temp.c_str());
+        fs::logWrite("LocalFS: failed to replace %s\n", dst.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool rfs::LocalFS::moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    std::string dst = appendResourceToParentId(newName, parentId, false);
+    std::string temp = dst + LOCAL_TEMP_EXT;
+
+    // rename only works on the same device. Fall back to copying across devices
+    remove(temp.c_str());
+    if(rename(fileID.c_str(), temp.c_str()) == 0) {
+        if(replacePath(temp, dst))
+            return true;
+
+        // Put it back where it was rather than leave it under the temp name
+        rename(temp.c_str(), fileID.c_str());
+        fs::logWrite("LocalFS: failed to replace %s\n", dst.c_str());
+        return false;
+    }
+
+    if(!copyFile(fileID, newName, parentId))
+        return false;
+
+    remove(fileID.c_str());
+    return true;
+}
+
+std::string rfs::LocalFS::getFileID(const std::string& name, const std::string& parentId) {
+    return appendResourceToParentId(name, parentId, false);
+}
+
+std::string rfs::LocalFS::getDirID(const std::string& dirName, const std::string& parentId) {
+    return appendResourceToParentId(dirName, parentId, true);
+}
+
+std::vector<rfs::RfsItem> rfs::LocalFS::getListWithParent(const std::string& _parent) {
+    std::vector<rfs::RfsItem> list;
+    fs::dirList dir(_parent, true);
+    for(unsigned i = 0; i < dir.getCount(); i++) {
+        RfsItem item;
+        item.name = dir.getItem(i);
+        // Unfinished copy or move
+        if(!dir.isDir(i) && "." + dir.getItemExt(i) == LOCAL_TEMP_EXT)
+            continue;
+
+        item.isDir = dir.isDir(i);
+        item.id = appendResourceToParentId(item.name, _parent, item.isDir);
+        item.parent = _parent;
+        item.size = item.isDir ? 0 : fs::fsize(item.id);
+        list.push_back(item);
+    }
+    return list;
+}
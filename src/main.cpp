@@ -53,12 +53,16 @@ int main(int argc, const char *argv[])
     curl_global_init(CURL_GLOBAL_ALL);
     //Drive needs config read
     if(!util::isApplet())
+    {
         fs::remoteInit();
+        fs::transferInit();
+    }
     else
-        ui::showMessage(ui::getUICString("appletModeWarning", 0));
+        ui::showMessage(ui::getUICString(ui::str::appletModeWarning, 0));
         
     while(ui::runApp()){ }
 
+    fs::transferExit();
     fs::remoteExit();
     curl_global_cleanup();
     cfg::saveConfig();
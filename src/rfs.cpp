@@ -1,51 +1,146 @@
+#include <stdio.h>
+#include <algorithm>
+
 #include "rfs.h"
+#include "fs.h"
 
-std::vector<uint8_t> rfs::downloadBuffer;
+void rfs::IRemoteFS::deleteFiles(const std::vector<std::string>& _fileIDs)
+{
+    for(const std::string& fileID : _fileIDs)
+        deleteFile(fileID);
+}
 
-void rfs::writeThread_t(void *a)
+rfs::DownloadWriter::DownloadWriter(curlFuncs::curlDlArgs *_dl) : streamStage(_dl->tap), dl(_dl) {}
+
+rfs::DownloadWriter::~DownloadWriter()
 {
-    rfs::dlWriteThreadStruct *in = (rfs::dlWriteThreadStruct *)a;
-    std::vector<uint8_t> localBuff;
-    unsigned written = 0;
+    if(threadRunning || out)
+        close();
+}
+
+bool rfs::DownloadWriter::open()
+{
+    out = fopen(dl->path.c_str(), "wb");
+    if(!out)
+    {
+        fs::logWrite("DownloadWriter: failed to open %s\n", dl->path.c_str());
+        return false;
+    }
+    //Writes are already big, stdio doesn't need to copy them again
+    setvbuf(out, NULL, _IONBF, 0);
 
-    FILE *out = fopen(in->cfa->path.c_str(), "wb");
+    fillBuffer.reserve(DOWNLOAD_BUFFER_SIZE);
+    writeBuffer.reserve(DOWNLOAD_BUFFER_SIZE);
 
-    while(written < in->cfa->size)
+    if(R_FAILED(threadCreate(&writeThread, writeThread_t, this, NULL, 0x8000, 0x2B, 2)) || R_FAILED(threadStart(&writeThread)))
     {
-        std::unique_lock<std::mutex> dataLock(in->dataLock);
-        in->cond.wait(dataLock, [in]{ return in->bufferFull; });
-        localBuff.clear();
-        localBuff.assign(in->sharedBuffer.begin(), in->sharedBuffer.end());
-        in->sharedBuffer.clear();
-        in->bufferFull = false;
-        dataLock.unlock();
-        in->cond.notify_one();
+        fs::logWrite("DownloadWriter: failed to start write thread\n");
+        fclose(out);
+        out = NULL;
+        return false;
+    }
+    threadRunning = true;
+    return true;
+}
 
-        written += fwrite(localBuff.data(), 1, localBuff.size(), out);
+bool rfs::DownloadWriter::close()
+{
+    if(threadRunning)
+    {
+        if(!fillBuffer.empty())
+            submit();
+
+        {
+            std::lock_guard<std::mutex> lock(dataLock);
+            finished = true;
+        }
+        cond.notify_one();
+
+        threadWaitForExit(&writeThread);
+        threadClose(&writeThread);
+        threadRunning = false;
     }
-    fclose(out);
-    rfs::downloadBuffer.clear();
+
+    if(out)
+    {
+        fclose(out);
+        out = NULL;
+    }
+    return !writeFailed;
 }
 
-size_t rfs::writeDataBufferThreaded(uint8_t *buff, size_t sz, size_t cnt, void *u)
+bool rfs::DownloadWriter::submit()
 {
-    rfs::dlWriteThreadStruct *in = (rfs::dlWriteThreadStruct *)u;
-    rfs::downloadBuffer.insert(rfs::downloadBuffer.end(), buff, buff + (sz * cnt));
-    in->downloaded += sz * cnt;
+    std::unique_lock<std::mutex> lock(dataLock);
+    cond.wait(lock, [this]{ return !writePending; });
+    if(writeFailed)
+        return false;
+
+    fillBuffer.swap(writeBuffer);
+    writePending = true;
+    lock.unlock();
+    cond.notify_one();
+    return true;
+}
 
-    if(in->downloaded == in->cfa->size || rfs::downloadBuffer.size() == DOWNLOAD_BUFFER_SIZE)
+void rfs::DownloadWriter::writeThread_t(void *a)
+{
+    rfs::DownloadWriter *in = (rfs::DownloadWriter *)a;
+    while(true)
     {
-        std::unique_lock<std::mutex> dataLock(in->dataLock);
-        in->cond.wait(dataLock, [in]{ return in->bufferFull == false; });
-        in->sharedBuffer.assign(rfs::downloadBuffer.begin(), rfs::downloadBuffer.end());
-        rfs::downloadBuffer.clear();
-        in->bufferFull = true;
-        dataLock.unlock();
+        std::unique_lock<std::mutex> lock(in->dataLock);
+        in->cond.wait(lock, [in]{ return in->writePending || in->finished; });
+        if(!in->writePending)
+            break;
+
+        //writeBuffer is only touched here while writePending is set, so the lock isn't needed for the write
+        lock.unlock();
+        bool failed = fwrite(in->writeBuffer.data(), 1, in->writeBuffer.size(), in->out) != in->writeBuffer.size();
+        in->writeBuffer.clear();
+
+        lock.lock();
+        if(failed)
+        {
+            fs::logWrite("DownloadWriter: write to %s failed\n", in->dl->path.c_str());
+            in->writeFailed = true;
+        }
+        in->writePending = false;
+        lock.unlock();
         in->cond.notify_one();
     }
+}
+
+bool rfs::DownloadWriter::write(const uint8_t *_data, size_t _size)
+{
+    if(dl->cancel && *dl->cancel)
+        return false;
 
-    if(in->cfa->o)
-        *in->cfa->o = in->downloaded;
+    //Tap first so a failed hash or inflate stops the download before it's written
+    if(next && !next->write(_data, _size))
+        return false;
 
-    return sz * cnt;
+    //Top the buffer off and pass it on when full. curl usually sends 16K at a time so this rarely loops
+    size_t used = 0;
+    while(used < _size)
+    {
+        size_t copy = std::min(_size - used, DOWNLOAD_BUFFER_SIZE - fillBuffer.size());
+        fillBuffer.insert(fillBuffer.end(), _data + used, _data + used + copy);
+        used += copy;
+
+        if(fillBuffer.size() == DOWNLOAD_BUFFER_SIZE && !submit())
+            return false;
+    }
+
+    downloaded += _size;
+    if(dl->o)
+        *dl->o = downloaded;
+
+    return true;
+}
+
+size_t rfs::DownloadWriter::writeCallback(const char *buff, size_t sz, size_t cnt, void *u)
+{
+    //Returning short makes curl abort the transfer
+    curlFuncs::streamStage *in = (rfs::DownloadWriter *)u;
+    return curlFuncs::writeStream(buff, sz, cnt, in);
 }
@@ -0,0 +1,750 @@
+#include <switch.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <cctype>
+#include <algorithm>
+#include <mutex>
+#include <tinyxml2.h>
+
+#include "s3.h"
+#include "fs.h"
+
+#define S3_UNSIGNED_PAYLOAD "UNSIGNED-PAYLOAD"
+#define S3_THREAD_STACK 0x40000
+#define S3_RETRY_COUNT 2
+
+// State shared between multipart upload workers
+typedef struct
+{
+    rfs::S3 *s3;
+    std::string key, uploadId;
+    FILE *f;
+    uint64_t fileStart, size, partSize, sent = 0;
+    unsigned nextPart = 0, partCount;
+    std::vector<std::string> etags;
+    uint64_t *progress;
+    //From the transfer. Every worker stops when it's set
+    bool *cancel;
+    bool failed = false;
+    std::mutex lock;
+} s3UploadShared;
+
+typedef struct
+{
+    s3UploadShared *shared;
+    uint64_t offset, remaining;
+} s3PartReader;
+
+// State shared between ranged download workers
+typedef struct
+{
+    rfs::S3 *s3;
+    std::string key, path;
+    uint64_t size, partSize, received = 0;
+    unsigned nextRange = 0, rangeCount;
+    uint64_t *progress;
+    bool *cancel;
+    bool failed = false;
+    std::mutex lock;
+} s3DownloadShared;
+
+typedef struct
+{
+    s3DownloadShared *shared;
+    FILE *f;
+    uint64_t written;
+} s3RangeWriter;
+
+static std::string uriEncode(const std::string& in, bool encodeSlash) {
+    static const char *hexChars = "0123456789ABCDEF";
+    std::string ret;
+    for(unsigned char c : in) {
+        if(isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || (c == '/' && !encodeSlash)) {
+            ret += c;
+        } else {
+            ret += '%';
+            ret += hexChars[c >> 4];
+            ret += hexChars[c & 0xF];
+        }
+    }
+    return ret;
+}
+
+static std::string toHex(const uint8_t *data, size_t size) {
+    static const char *hexChars = "0123456789abcdef";
+    std::string ret;
+    for(size_t i = 0; i < size; i++) {
+        ret += hexChars[data[i] >> 4];
+        ret += hexChars[data[i] & 0xF];
+    }
+    return ret;
+}
+
+static std::string sha256Hex(const std::string& in) {
+    uint8_t hash[SHA256_HASH_SIZE];
+    sha256CalculateHash(hash, in.c_str(), in.length());
+    return toHex(hash, SHA256_HASH_SIZE);
+}
+
+static void hmac(uint8_t *out, const void *key, size_t keySize, const std::string& data) {
+    hmacSha256CalculateMac(out, key, keySize, data.c_str(), data.length());
+}
+
+static size_t readNothing(char *buff, size_t sz, size_t cnt, void *u) {
+    return 0;
+}
+
+static bool responseHasError(const std::string& resp) {
+    // S3 can answer copy and complete requests with 200 and an error document
+    return resp.find("<Error>") != resp.npos;
+}
+
+static std::string getXMLText(tinyxml2::XMLElement *parent, const char *name) {
+    tinyxml2::XMLElement *elem = parent->FirstChildElement(name);
+    if(elem && elem->GetText())
+        return elem->GetText();
+
+    return "";
+}
+
+static std::string getHeaderAnyCase(const std::string& name, std::vector<std::string> *headers) {
+    std::string ret = curlFuncs::getHeader(name, headers);
+    if(ret == HEADER_ERROR) {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        ret = curlFuncs::getHeader(lower, headers);
+    }
+    return ret;
+}
+
+rfs::S3::S3(const std::string& endpoint, const std::string& region, const std::string& bucket, const std::string& accessKey, const std::string& secretKey, bool pathStyle, uint64_t partSize, unsigned concurrency)
+    : region(region), bucket(bucket), accessKey(accessKey), secretKey(secretKey), pathStyle(pathStyle), partSize(partSize), concurrency(concurrency)
+{
+    size_t schemeEnd = endpoint.find("://");
+    if(schemeEnd != endpoint.npos) {
+        scheme = endpoint.substr(0, schemeEnd);
+        host = endpoint.substr(schemeEnd + 3);
+    } else {
+        scheme = "https";
+        host = endpoint;
+    }
+
+    if(!host.empty() && host.back() == '/')
+        host.pop_back();
+
+    if(this->region.empty())
+        this->region = "us-east-1";
+
+    if(this->partSize < S3_MIN_PART_SIZE)
+        this->partSize = S3_MIN_PART_SIZE;
+    else if(this->partSize > S3_MAX_PART_SIZE)
+        this->partSize = S3_MAX_PART_SIZE;
+
+    if(this->concurrency == 0)
+        this->concurrency = 1;
+    else if(this->concurrency > S3_MAX_CONCURRENCY)
+        this->concurrency = S3_MAX_CONCURRENCY;
+}
+
+// parentId is either empty (bucket root) or ends with a "/"
+std::string rfs::S3::appendResourceToParentId(const std::string& resourceName, const std::string& parentId, bool isDir) {
+    return parentId + resourceName + (isDir ? "/" : "");
+}
+
+CURL* rfs::S3::createRequest(const char* method, const std::string& key, const S3Query& query, const std::vector<std::string>& amzHeaders, curl_slist** _headers) {
+    std::string hostHeader = pathStyle ? host : bucket + "." + host;
+    std::string canonicalUri = pathStyle ? "/" + uriEncode(bucket, true) + "/" + uriEncode(key, false) : "/" + uriEncode(key, false);
+
+    // Query parameters have to be sorted for the canonical request
+    S3Query sortedQuery = query;
+    std::sort(sortedQuery.begin(), sortedQuery.end());
+    std::string queryString;
+    for(auto& param : sortedQuery) {
+        if(!queryString.empty())
+            queryString += "&";
+        queryString += uriEncode(param.first, true) + "=" + uriEncode(param.second, true);
+    }
+
+    char amzDate[17], dateStamp[9];
+    time_t now = time(NULL);
+    struct tm *utc = gmtime(&now);
+    strftime(amzDate, 17, "%Y%m%dT%H%M%SZ", utc);
+    strftime(dateStamp, 9, "%Y%m%d", utc);
+
+    // Everything sent as a header is signed. amzHeaders are "name:value" with lowercase names
+    std::vector<std::pair<std::string, std::string>> signHeaders;
+    for(const std::string& header : amzHeaders) {
+        size_t colon = header.find(':');
+        signHeaders.push_back(std::make_pair(header.substr(0, colon), header.substr(colon + 1)));
+    }
+    signHeaders.push_back(std::make_pair("host", hostHeader));
+    signHeaders.push_back(std::make_pair("x-amz-content-sha256", S3_UNSIGNED_PAYLOAD));
+    signHeaders.push_back(std::make_pair("x-amz-date", amzDate));
+    std::sort(signHeaders.begin(), signHeaders.end());
+
+    std::string canonicalHeaders, signedHeaders;
+    for(auto& header : signHeaders) {
+        canonicalHeaders += header.first + ":" + header.second + "\n";
+        signedHeaders += (signedHeaders.empty() ? "" : ";") + header.first;
+        *_headers = curl_slist_append(*_headers, std::string(header.first + ": " + header.second).c_str());
+    }
+
+    std::string canonicalRequest = std::string(method) + "\n" + canonicalUri + "\n" + queryString + "\n" + canonicalHeaders + "\n" + signedHeaders + "\n" + S3_UNSIGNED_PAYLOAD;
+    std::string scope = std::string(dateStamp) + "/" + region + "/s3/aws4_request";
+    std::string stringToSign = "AWS4-HMAC-SHA256\n" + std::string(amzDate) + "\n" + scope + "\n" + sha256Hex(canonicalRequest);
+
+    // Signing key is derived from the secret for every date, region and service
+    std::string secret = "AWS4" + secretKey;
+    uint8_t kDate[SHA256_HASH_SIZE], kRegion[SHA256_HASH_SIZE], kService[SHA256_HASH_SIZE], kSigning[SHA256_HASH_SIZE], signature[SHA256_HASH_SIZE];
+    hmac(kDate, secret.c_str(), secret.length(), dateStamp);
+    hmac(kRegion, kDate, SHA256_HASH_SIZE, region);
+    hmac(kService, kRegion, SHA256_HASH_SIZE, "s3");
+    hmac(kSigning, kService, SHA256_HASH_SIZE, "aws4_request");
+    hmac(signature, kSigning, SHA256_HASH_SIZE, stringToSign);
+
+    std::string authorization = "Authorization: AWS4-HMAC-SHA256 Credential=" + accessKey + "/" + scope + ", SignedHeaders=" + signedHeaders + ", Signature=" + toHex(signature, SHA256_HASH_SIZE);
+    *_headers = curl_slist_append(*_headers, authorization.c_str());
+
+    std::string url = scheme + "://" + hostHeader + canonicalUri + (queryString.empty() ? "" : "?" + queryString);
+
+    CURL* handle = curl_easy_init();
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, *_headers);
+
+    std::string methodStr = method;
+    if(methodStr == "HEAD") {
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+    } else if(methodStr == "PUT") {
+        // Callers without a body keep the empty read
+        curl_easy_setopt(handle, CURLOPT_UPLOAD, 1L);
+        curl_easy_setopt(handle, CURLOPT_READFUNCTION, readNothing);
+        curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, (curl_off_t)0);
+    } else if(methodStr == "POST") {
+        curl_easy_setopt(handle, CURLOPT_POST, 1L);
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDS, "");
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, 0L);
+    } else if(methodStr != "GET") {
+        curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, method);
+    }
+
+    return handle;
+}
+
+bool rfs::S3::performRequest(CURL* handle, const char* what, long* responseCode) {
+    CURLcode res = curlFuncs::perform(handle);
+    *responseCode = 0;
+    if(res != CURLE_OK) {
+        fs::logWrite("S3: %s failed: %s\n", what, curl_easy_strerror(res));
+        return false;
+    }
+
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, responseCode);
+    if(*responseCode < 200 || *responseCode > 299) {
+        fs::logWrite("S3: %s returned %li\n", what, *responseCode);
+        return false;
+    }
+    return true;
+}
+
+uint64_t rfs::S3::getObjectSize(const std::string& key) {
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("HEAD", key, {}, {}, &headers);
+
+    long code;
+    curl_off_t size = 0;
+    if(performRequest(handle, "HEAD", &code))
+        curl_easy_getinfo(handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &size);
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return size > 0 ? size : 0;
+}
+
+bool rfs::S3::createDir(const std::string& dirName, const std::string& parentId) {
+    std::string key = appendResourceToParentId(dirName, parentId, true);
+    fs::logWrite("S3: Create directory marker %s\n", key.c_str());
+
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("PUT", key, {}, {}, &headers);
+
+    long code;
+    bool ret = performRequest(handle, "createDir", &code);
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return ret;
+}
+
+bool rfs::S3::dirExists(const std::string& dirName, const std::string& parentId) {
+    // Prefixes exist as soon as anything is stored under them, marker or not
+    std::string prefix = getDirID(dirName, parentId);
+    S3Query query = {{"list-type", "2"}, {"prefix", prefix}, {"max-keys", "1"}};
+
+    std::string resp;
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("GET", "", query, {}, &headers);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &resp);
+
+    long code;
+    bool ret = false;
+    if(performRequest(handle, "dirExists", &code)) {
+        tinyxml2::XMLDocument doc;
+        if(doc.Parse(resp.c_str()) == tinyxml2::XML_SUCCESS && doc.RootElement())
+            ret = strtoul(getXMLText(doc.RootElement(), "KeyCount").c_str(), NULL, 10) > 0;
+    }
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return ret;
+}
+
+bool rfs::S3::fileExists(const std::string& filename, const std::string& parentId) {
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("HEAD", getFileID(filename, parentId), {}, {}, &headers);
+
+    // 404 is the expected answer here, don't log it as an error
+    bool ret = false;
+    if(curlFuncs::perform(handle) == CURLE_OK) {
+        long code;
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &code);
+        ret = code == 200;
+    }
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return ret;
+}
+
+void rfs::S3::uploadFile(const std::string& filename, const std::string& parentId, curlFuncs::curlUpArgs *_upload) {
+    updateFile(getFileID(filename, parentId), _upload);
+}
+
+void rfs::S3::updateFile(const std::string& fileID, curlFuncs::curlUpArgs *_upload) {
+    // Objects are replaced whole, so update and upload are the same
+    long start = ftell(_upload->f);
+    fseek(_upload->f, 0, SEEK_END);
+    uint64_t size = ftell(_upload->f) - start;
+    fseek(_upload->f, start, SEEK_SET);
+
+    // Parts are read out of order, a tap needs the file front to back
+    if(size > partSize && !_upload->tap) {
+        if(!multipartUpload(fileID, size, _upload))
+            fs::logWrite("S3: multipart upload of %s failed\n", fileID.c_str());
+        return;
+    }
+
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("PUT", fileID, {}, {}, &headers);
+    curl_easy_setopt(handle, CURLOPT_READFUNCTION, curlFuncs::readDataFile);
+    curl_easy_setopt(handle, CURLOPT_READDATA, _upload);
+    curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, (curl_off_t)size);
+    curl_easy_setopt(handle, CURLOPT_UPLOAD_BUFFERSIZE, UPLOAD_BUFFER_SIZE);
+
+    long code;
+    performRequest(handle, "upload", &code);
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+}
+
+// Parts share the one FILE. Reads are locked and seek to the part's own offset
+static size_t readPart(char *buff, size_t sz, size_t cnt, void *u) {
+    s3PartReader *in = (s3PartReader *)u;
+    if(in->shared->cancel && *in->shared->cancel)
+        return CURL_READFUNC_ABORT;
+
+    size_t want = sz * cnt;
+    if(want > in->remaining)
+        want = in->remaining;
+
+    if(want == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(in->shared->lock);
+    fseek(in->shared->f, in->shared->fileStart + in->offset, SEEK_SET);
+    size_t read = fread(buff, 1, want, in->shared->f);
+    in->offset += read;
+    in->remaining -= read;
+    in->shared->sent += read;
+    if(in->shared->progress)
+        *in->shared->progress = in->shared->sent;
+
+    return read;
+}
+
+void rfs::S3::uploadPart_t(void *a) {
+    s3UploadShared *shared = (s3UploadShared *)a;
+    while(true) {
+        unsigned part;
+        {
+            std::lock_guard<std::mutex> lock(shared->lock);
+            if(shared->failed || shared->nextPart >= shared->partCount)
+                break;
+            part = shared->nextPart++;
+        }
+
+        uint64_t offset = part * shared->partSize;
+        uint64_t length = std::min(shared->partSize, shared->size - offset);
+        std::string etag;
+        bool ok = false;
+        for(int attempt = 0; attempt < S3_RETRY_COUNT && !ok && !(shared->cancel && *shared->cancel); attempt++) {
+            s3PartReader reader = {shared, offset, length};
+            std::vector<std::string> respHeaders;
+            curl_slist *headers = NULL;
+            S3Query query = {{"partNumber", std::to_string(part + 1)}, {"uploadId", shared->uploadId}};
+            CURL* handle = shared->s3->createRequest("PUT", shared->key, query, {}, &headers);
+            curl_easy_setopt(handle, CURLOPT_READFUNCTION, readPart);
+            curl_easy_setopt(handle, CURLOPT_READDATA, &reader);
+            curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, (curl_off_t)length);
+            curl_easy_setopt(handle, CURLOPT_UPLOAD_BUFFERSIZE, UPLOAD_BUFFER_SIZE);
+            curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, curlFuncs::writeHeaders);
+            curl_easy_setopt(handle, CURLOPT_HEADERDATA, &respHeaders);
+
+            long code;
+            ok = shared->s3->performRequest(handle, "UploadPart", &code);
+            if(ok) {
+                etag = getHeaderAnyCase("ETag", &respHeaders);
+                ok = etag != HEADER_ERROR;
+            }
+
+            // Take back progress from the failed try
+            if(!ok) {
+                std::lock_guard<std::mutex> lock(shared->lock);
+                shared->sent -= length - reader.remaining;
+            }
+
+            curl_slist_free_all(headers);
+            curl_easy_cleanup(handle);
+        }
+
+        std::lock_guard<std::mutex> lock(shared->lock);
+        if(ok)
+            shared->etags[part] = etag;
+        else
+            shared->failed = true;
+    }
+}
+
+bool rfs::S3::multipartUpload(const std::string& key, uint64_t size, curlFuncs::curlUpArgs *_upload) {
+    // Start
+    std::string resp;
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("POST", key, {{"uploads", ""}}, {}, &headers);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &resp);
+
+    long code;
+    std::string uploadId;
+    if(performRequest(handle, "CreateMultipartUpload", &code)) {
+        tinyxml2::XMLDocument doc;
+        if(doc.Parse(resp.c_str()) == tinyxml2::XML_SUCCESS && doc.RootElement())
+            uploadId = getXMLText(doc.RootElement(), "UploadId");
+    }
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+
+    if(uploadId.empty())
+        return false;
+
+    // Parts
+    s3UploadShared shared;
+    shared.s3 = this;
+    shared.key = key;
+    shared.uploadId = uploadId;
+    shared.f = _upload->f;
+    shared.fileStart = ftell(_upload->f);
+    shared.size = size;
+    shared.partSize = partSize;
+    shared.partCount = (size + partSize - 1) / partSize;
+    shared.etags.resize(shared.partCount);
+    shared.progress = _upload->o;
+    shared.cancel = _upload->cancel;
+
+    unsigned threadCount = std::min(concurrency, shared.partCount);
+    std::vector<Thread> workers(threadCount);
+    for(unsigned i = 0; i < threadCount; i++) {
+        threadCreate(&workers[i], uploadPart_t, &shared, NULL, S3_THREAD_STACK, 0x2B, -2);
+        threadStart(&workers[i]);
+    }
+
+    for(unsigned i = 0; i < threadCount; i++) {
+        threadWaitForExit(&workers[i]);
+        threadClose(&workers[i]);
+    }
+
+    // Abort so the server drops the parts already stored
+    if(shared.failed) {
+        headers = NULL;
+        handle = createRequest("DELETE", key, {{"uploadId", uploadId}}, {}, &headers);
+        performRequest(handle, "AbortMultipartUpload", &code);
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(handle);
+        return false;
+    }
+
+    // Complete
+    std::string body = "<CompleteMultipartUpload>";
+    for(unsigned i = 0; i < shared.partCount; i++)
+        body += "<Part><PartNumber>" + std::to_string(i + 1) + "</PartNumber><ETag>" + shared.etags[i] + "</ETag></Part>";
+    body += "</CompleteMultipartUpload>";
+
+    resp.clear();
+    headers = NULL;
+    handle = createRequest("POST", key, {{"uploadId", uploadId}}, {}, &headers);
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, body.c_str());
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, (long)body.length());
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &resp);
+
+    bool ret = performRequest(handle, "CompleteMultipartUpload", &code) && !responseHasError(resp);
+    if(!ret)
+        fs::logWrite("S3: %s\n", resp.c_str());
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return ret;
+}
+
+void rfs::S3::downloadFile(const std::string& fileID, curlFuncs::curlDlArgs *_download) {
+    uint64_t size = _download->size > 0 ? _download->size : getObjectSize(fileID);
+
+    if(size > partSize && concurrency > 1 && !_download->tap) {
+        if(!rangedDownload(fileID, size, _download))
+            fs::logWrite("S3: ranged download of %s failed\n", fileID.c_str());
+        return;
+    }
+
+    //Writing is threaded because it's too slow otherwise
+    DownloadWriter writer(_download);
+    if(!writer.open())
+        return;
+
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("GET", fileID, {}, {}, &headers);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, DownloadWriter::writeCallback);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &writer);
+
+    long code;
+    performRequest(handle, "download", &code);
+    writer.close();
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+}
+
+static size_t writeRange(const char *buff, size_t sz, size_t cnt, void *u) {
+    s3RangeWriter *in = (s3RangeWriter *)u;
+    if(in->shared->cancel && *in->shared->cancel)
+        return 0;
+
+    size_t written = fwrite(buff, 1, sz * cnt, in->f);
+    in->written += written;
+
+    std::lock_guard<std::mutex> lock(in->shared->lock);
+    in->shared->received += written;
+    if(in->shared->progress)
+        *in->shared->progress = in->shared->received;
+
+    return written;
+}
+
+void rfs::S3::downloadRange_t(void *a) {
+    s3DownloadShared *shared = (s3DownloadShared *)a;
+
+    // Every worker writes through its own FILE into the preallocated target
+    FILE *out = fopen(shared->path.c_str(), "r+b");
+    if(!out) {
+        std::lock_guard<std::mutex> lock(shared->lock);
+        shared->failed = true;
+        return;
+    }
+
+    while(true) {
+        unsigned range;
+        {
+            std::lock_guard<std::mutex> lock(shared->lock);
+            if(shared->failed || shared->nextRange >= shared->rangeCount)
+                break;
+            range = shared->nextRange++;
+        }
+
+        uint64_t offset = range * shared->partSize;
+        uint64_t end = std::min(offset + shared->partSize, shared->size) - 1;
+        std::string rangeHeader = "Range: bytes=" + std::to_string(offset) + "-" + std::to_string(end);
+        bool ok = false;
+        for(int attempt = 0; attempt < S3_RETRY_COUNT && !ok && !(shared->cancel && *shared->cancel); attempt++) {
+            fseek(out, offset, SEEK_SET);
+            s3RangeWriter writer = {shared, out, 0};
+
+            curl_slist *headers = NULL;
+            CURL* handle = shared->s3->createRequest("GET", shared->key, {}, {}, &headers);
+            headers = curl_slist_append(headers, rangeHeader.c_str());
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeRange);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, &writer);
+
+            long code;
+            ok = shared->s3->performRequest(handle, "GetObject range", &code) && code == 206 && writer.written == end - offset + 1;
+            if(!ok) {
+                std::lock_guard<std::mutex> lock(shared->lock);
+                shared->received -= writer.written;
+            }
+
+            curl_slist_free_all(headers);
+            curl_easy_cleanup(handle);
+        }
+
+        if(!ok) {
+            std::lock_guard<std::mutex> lock(shared->lock);
+            shared->failed = true;
+        }
+    }
+    fclose(out);
+}
+
+bool rfs::S3::rangedDownload(const std::string& key, uint64_t size, curlFuncs::curlDlArgs *_download) {
+    // Size the file up front so ranges can land anywhere
+    FILE *create = fopen(_download->path.c_str(), "wb");
+    if(!create)
+        return false;
+    ftruncate(fileno(create), size);
+    fclose(create);
+
+    s3DownloadShared shared;
+    shared.s3 = this;
+    shared.key = key;
+    shared.path = _download->path;
+    shared.size = size;
+    shared.partSize = partSize;
+    shared.rangeCount = (size + partSize - 1) / partSize;
+    shared.progress = _download->o;
+    shared.cancel = _download->cancel;
+
+    unsigned threadCount = std::min(concurrency, shared.rangeCount);
+    std::vector<Thread> workers(threadCount);
+    for(unsigned i = 0; i < threadCount; i++) {
+        threadCreate(&workers[i], downloadRange_t, &shared, NULL, S3_THREAD_STACK, 0x2B, -2);
+        threadStart(&workers[i]);
+    }
+
+    for(unsigned i = 0; i < threadCount; i++) {
+        threadWaitForExit(&workers[i]);
+        threadClose(&workers[i]);
+    }
+
+    return !shared.failed;
+}
+
+void rfs::S3::deleteFile(const std::string& fileID) {
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("DELETE", fileID, {}, {}, &headers);
+
+    long code;
+    performRequest(handle, "delete", &code);
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+}
+
+bool rfs::S3::copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    std::string copySource = "x-amz-copy-source:/" + uriEncode(bucket, true) + "/" + uriEncode(fileID, false);
+
+    std::string resp;
+    curl_slist *headers = NULL;
+    CURL* handle = createRequest("PUT", getFileID(newName, parentId), {}, {copySource}, &headers);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &resp);
+
+    long code;
+    bool ret = performRequest(handle, "CopyObject", &code) && !responseHasError(resp);
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(handle);
+    return ret;
+}
+
+bool rfs::S3::moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    // No rename in S3. Copy is still server side
+    if(!copyFile(fileID, newName, parentId))
+        return false;
+
+    deleteFile(fileID);
+    return true;
+}
+
+std::string rfs::S3::getFileID(const std::string& name, const std::string& parentId) {
+    return appendResourceToParentId(name, parentId, false);
+}
+
+std::string rfs::S3::getDirID(const std::string& dirName, const std::string& parentId) {
+    return appendResourceToParentId(dirName, parentId, true);
+}
+
+std::vector<rfs::RfsItem> rfs::S3::getListWithParent(const std::string& _parent) {
+    std::vector<rfs::RfsItem> list;
+    std::string continuationToken;
+    bool truncated = false;
+
+    // ListObjectsV2 pages at 1000 keys
+    do {
+        S3Query query = {{"list-type", "2"}, {"prefix", _parent}, {"delimiter", "/"}};
+        if(!continuationToken.empty())
+            query.push_back(std::make_pair("continuation-token", continuationToken));
+
+        std::string resp;
+        curl_slist *headers = NULL;
+        CURL* handle = createRequest("GET", "", query, {}, &headers);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, &resp);
+
+        long code;
+        bool ok = performRequest(handle, "ListObjectsV2", &code);
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(handle);
+
+        tinyxml2::XMLDocument doc;
+        if(!ok || doc.Parse(resp.c_str()) != tinyxml2::XML_SUCCESS || !doc.RootElement()) {
+            fs::logWrite("S3: Failed to list %s\n", _parent.c_str());
+            break;
+        }
+
+        tinyxml2::XMLElement *root = doc.RootElement();
+        for(tinyxml2::XMLElement *contents = root->FirstChildElement("Contents"); contents; contents = contents->NextSiblingElement("Contents")) {
+            std::string key = getXMLText(contents, "Key");
+            // Skip the directory's own marker
+            if(key.length() <= _parent.length())
+                continue;
+
+            RfsItem item;
+            item.id = key;
+            item.name = key.substr(_parent.length());
+            item.parent = _parent;
+            item.isDir = false;
+            item.size = strtoull(getXMLText(contents, "Size").c_str(), NULL, 10);
+            list.push_back(item);
+        }
+
+        for(tinyxml2::XMLElement *prefix = root->FirstChildElement("CommonPrefixes"); prefix; prefix = prefix->NextSiblingElement("CommonPrefixes")) {
+            std::string key = getXMLText(prefix, "Prefix");
+            if(key.length() <= _parent.length())
+                continue;
+
+            RfsItem item;
+            item.id = key;
+            item.name = key.substr(_parent.length(), key.length() - _parent.length() - 1);
+            item.parent = _parent;
+            item.isDir = true;
+            item.size = 0;
+            list.push_back(item);
+        }
+
+        truncated = getXMLText(root, "IsTruncated") == "true";
+        continuationToken = getXMLText(root, "NextContinuationToken");
+    } while(truncated && !continuationToken.empty());
+
+    return list;
+}
@@ -0,0 +1,619 @@
+#include <switch.h>
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
+
+#include "data.h"
+#include "titlecache.h"
+#include "file.h"
+#include "util.h"
+
+//Blobs are appended as titles change and the index is written after them
+#define TITLE_CACHE_MAGIC 0x4354534B
+#define TITLE_CACHE_REV 2
+#define TITLE_CACHE_CTRL 1
+#define TITLE_CACHE_ICON 2
+#define TITLE_ICON_PIXELS (TITLE_ICON_SIZE * TITLE_ICON_SIZE)
+
+typedef struct
+{
+    uint32_t magic, rev;
+    //0 while blobs are being appended. A cache left like that is thrown out
+    uint64_t indexOffset;
+    //Blobs nothing points to anymore. Compacted once there are more of them than live ones
+    uint64_t deadBytes;
+    uint32_t count, pad;
+} titleCacheHeader;
+
+typedef struct
+{
+    uint64_t tid;
+    uint32_t version, flags;
+    uint64_t ctrlOffset, iconOffset;
+} titleCacheEntry;
+
+static FILE *titleCache = NULL;
+static std::mutex titleCacheLock;
+static std::unordered_map<uint64_t, titleCacheEntry> titleCacheIndex;
+static uint64_t titleCacheEnd = 0, titleCacheDead = 0;
+static bool titleCacheDirty = false;
+static unsigned titleCacheHits = 0, titleCacheMisses = 0;
+
+typedef struct
+{
+    uint64_t tid;
+    uint32_t version;
+    //Empty means cache or ns
+    std::vector<uint8_t> jpeg;
+    //Higher goes first. Bumped every frame the icon is on screen
+    uint64_t wanted = 0;
+} titleIconJob;
+
+typedef struct
+{
+    uint64_t tid;
+    //Empty gets a generic icon
+    std::vector<uint32_t> pixels;
+    //Only icons that can be rebuilt are let go under texture pressure. SVI icons aren't in the cache
+    bool evictable = false;
+} titleIconDecoded;
+
+static std::vector<titleIconJob *> titleIconJobs;
+static std::vector<titleIconDecoded *> titleIconDone;
+static std::mutex titleIconLock;
+static std::condition_variable titleIconCond;
+static Thread titleIconThread;
+static bool titleIconRunning = false, titleIconStop = false;
+static uint64_t titleIconWantCounter = 0;
+//Icons freed to stay under the texture budget. They're queued again when they're back on screen
+static std::unordered_set<uint64_t> titleIconEvicted;
+
+static inline uint64_t titleCacheBlobSize(uint32_t flags)
+{
+    uint64_t ret = 0;
+    if(flags & TITLE_CACHE_CTRL)
+        ret += sizeof(NacpStruct);
+    if(flags & TITLE_CACHE_ICON)
+        ret += TITLE_ICON_PIXELS * sizeof(uint32_t);
+
+    return ret;
+}
+
+//Writes _index at _indexOffset and the header pointing to it
+static bool titleCacheWriteIndex(FILE *f, const std::vector<titleCacheEntry>& _index, uint64_t _indexOffset, uint64_t _deadBytes)
+{
+    titleCacheHeader head = { TITLE_CACHE_MAGIC, TITLE_CACHE_REV, _indexOffset, _deadBytes, (uint32_t)_index.size(), 0 };
+    fseek(f, _indexOffset, SEEK_SET);
+    if(fwrite(_index.data(), sizeof(titleCacheEntry), _index.size(), f) != _index.size())
+        return false;
+
+    fseek(f, 0, SEEK_SET);
+    return fwrite(&head, sizeof(titleCacheHeader), 1, f) == 1 && fflush(f) == 0;
+}
+
+static std::vector<titleCacheEntry> titleCacheGetIndex()
+{
+    std::vector<titleCacheEntry> ret;
+    ret.reserve(titleCacheIndex.size());
+    for(auto& e : titleCacheIndex)
+        ret.push_back(e.second);
+
+    return ret;
+}
+
+static bool titleCacheCopyBlob(FILE *out, uint64_t& _offset, uint64_t _size, std::vector<uint8_t>& _buff)
+{
+    _buff.resize(_size);
+    fseek(titleCache, _offset, SEEK_SET);
+    if(fread(_buff.data(), 1, _size, titleCache) != _size || fwrite(_buff.data(), 1, _size, out) != _size)
+        return false;
+
+    _offset = ftell(out) - _size;
+    return true;
+}
+
+//Copies the live blobs to a new file
+static bool titleCacheCompact(std::vector<titleCacheEntry>& _index)
+{
+    FILE *out = fopen(TITLE_CACHE_TEMP, "wb");
+    if(!out)
+        return false;
+
+    titleCacheHeader head;
+    memset(&head, 0, sizeof(titleCacheHeader));
+    bool ret = fwrite(&head, sizeof(titleCacheHeader), 1, out) == 1;
+
+    std::vector<uint8_t> blob;
+    for(titleCacheEntry& e : _index)
+    {
+        if(ret && (e.flags & TITLE_CACHE_CTRL))
+            ret = titleCacheCopyBlob(out, e.ctrlOffset, titleCacheBlobSize(TITLE_CACHE_CTRL), blob);
+        if(ret && (e.flags & TITLE_CACHE_ICON))
+            ret = titleCacheCopyBlob(out, e.iconOffset, titleCacheBlobSize(TITLE_CACHE_ICON), blob);
+    }
+
+    ret = ret && titleCacheWriteIndex(out, _index, ftell(out), 0);
+    fclose(out);
+    fclose(titleCache);
+    titleCache = NULL;
+
+    remove(TITLE_CACHE_PATH);
+    if(ret)
+        rename(TITLE_CACHE_TEMP, TITLE_CACHE_PATH);
+    else
+        remove(TITLE_CACHE_TEMP);
+
+    return ret;
+}
+
+//titleCacheLock has to be held. Anything cut short from here on leaves a cache that gets rebuilt
+static void titleCacheStartAppend()
+{
+    if(titleCacheDirty)
+        return;
+
+    titleCacheHeader head;
+    memset(&head, 0, sizeof(titleCacheHeader));
+    fseek(titleCache, 0, SEEK_SET);
+    fwrite(&head, sizeof(titleCacheHeader), 1, titleCache);
+    titleCacheDirty = true;
+}
+
+//titleCacheLock has to be held. Returns the offset _dat was written at or 0
+static uint64_t titleCacheAppend(const void *_dat, size_t _size)
+{
+    titleCacheStartAppend();
+    fseek(titleCache, titleCacheEnd, SEEK_SET);
+    if(fwrite(_dat, 1, _size, titleCache) != _size)
+    {
+        fs::logWrite("Title cache: write failed\n");
+        return 0;
+    }
+
+    uint64_t ret = titleCacheEnd;
+    titleCacheEnd += _size;
+    return ret;
+}
+
+void data::titleCacheOpen()
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    titleCacheIndex.clear();
+    titleCacheDirty = false;
+
+    titleCacheHeader head;
+    titleCache = fopen(TITLE_CACHE_PATH, "r+b");
+    if(titleCache && fread(&head, sizeof(titleCacheHeader), 1, titleCache) == 1 && head.magic == TITLE_CACHE_MAGIC && head.rev == TITLE_CACHE_REV && head.indexOffset != 0)
+    {
+        //Whole index in one read
+        std::vector<titleCacheEntry> index(head.count);
+        fseek(titleCache, head.indexOffset, SEEK_SET);
+        if(fread(index.data(), sizeof(titleCacheEntry), head.count, titleCache) == head.count)
+        {
+            for(titleCacheEntry& e : index)
+                titleCacheIndex[e.tid] = e;
+
+            titleCacheEnd = head.indexOffset;
+            titleCacheDead = head.deadBytes;
+            return;
+        }
+        titleCacheIndex.clear();
+    }
+
+    //Missing, old or broken. Start over
+    if(titleCache)
+        fclose(titleCache);
+
+    memset(&head, 0, sizeof(titleCacheHeader));
+    titleCache = fopen(TITLE_CACHE_PATH, "w+b");
+    if(titleCache && fwrite(&head, sizeof(titleCacheHeader), 1, titleCache) == 1)
+    {
+        titleCacheEnd = sizeof(titleCacheHeader);
+        titleCacheDead = 0;
+        titleCacheDirty = true;
+    }
+    else if(titleCache)
+    {
+        fclose(titleCache);
+        titleCache = NULL;
+    }
+}
+
+void data::titleCacheFlush()
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    if(titleCacheHits + titleCacheMisses > 0)
+        fs::logWrite("Title cache: %u cached, %u fetched\n", titleCacheHits, titleCacheMisses);
+
+    titleCacheHits = 0;
+    titleCacheMisses = 0;
+    if(!titleCache || !titleCacheDirty)
+        return;
+
+    if(titleCacheWriteIndex(titleCache, titleCacheGetIndex(), titleCacheEnd, titleCacheDead))
+        titleCacheDirty = false;
+    else
+        fs::logWrite("Title cache: failed to write %s\n", TITLE_CACHE_PATH);
+}
+
+void data::titleCacheClose()
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    if(!titleCache)
+        return;
+
+    //Titles that aren't around anymore
+    for(auto e = titleCacheIndex.begin(); e != titleCacheIndex.end(); )
+    {
+        if(data::titles.find(e->first) == data::titles.end())
+        {
+            titleCacheDead += titleCacheBlobSize(e->second.flags);
+            e = titleCacheIndex.erase(e);
+            titleCacheDirty = true;
+        }
+        else
+            ++e;
+    }
+
+    if(titleCacheDirty)
+    {
+        std::vector<titleCacheEntry> index = titleCacheGetIndex();
+        bool written = false;
+        if(titleCacheDead > titleCacheEnd - sizeof(titleCacheHeader) - titleCacheDead)
+            written = titleCacheCompact(index);
+        else
+            written = titleCacheWriteIndex(titleCache, index, titleCacheEnd, titleCacheDead);
+
+        if(!written)
+        {
+            fs::logWrite("Title cache: failed to write %s\n", TITLE_CACHE_PATH);
+            if(titleCache)
+                fclose(titleCache);
+            titleCache = NULL;
+            remove(TITLE_CACHE_PATH);
+        }
+    }
+
+    if(titleCache)
+        fclose(titleCache);
+    titleCache = NULL;
+    titleCacheIndex.clear();
+}
+
+uint32_t data::getTitleVersion(const uint64_t& tid)
+{
+    NsApplicationContentMetaStatus meta[16];
+    s32 count = 0;
+    if(R_FAILED(nsListApplicationContentMetaStatus(tid, 0, meta, 16, &count)) || count == 0)
+        return TITLE_VERSION_NONE;
+
+    uint32_t ret = 0;
+    for(int i = 0; i < count; i++)
+    {
+        if(meta[i].version > ret)
+            ret = meta[i].version;
+    }
+    return ret;
+}
+
+bool data::titleCacheGetCtrl(const uint64_t& tid, uint32_t version, NacpStruct *nacp, bool& _hasCtrl)
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    auto find = titleCacheIndex.find(tid);
+    if(!titleCache || find == titleCacheIndex.end() || find->second.version != version)
+    {
+        ++titleCacheMisses;
+        return false;
+    }
+
+    titleCacheEntry& e = find->second;
+    _hasCtrl = e.flags & TITLE_CACHE_CTRL;
+    if(_hasCtrl)
+    {
+        fseek(titleCache, e.ctrlOffset, SEEK_SET);
+        if(fread(nacp, sizeof(NacpStruct), 1, titleCache) != 1)
+        {
+            ++titleCacheMisses;
+            return false;
+        }
+    }
+    else
+        memset(nacp, 0, sizeof(NacpStruct));
+
+    ++titleCacheHits;
+    return true;
+}
+
+void data::titleCacheStoreCtrl(const uint64_t& tid, uint32_t version, const NacpStruct *nacp)
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    if(!titleCache)
+        return;
+
+    titleCacheEntry e = { tid, version, 0, 0, 0 };
+    if(nacp)
+    {
+        if((e.ctrlOffset = titleCacheAppend(nacp, sizeof(NacpStruct))) == 0)
+            return;
+
+        e.flags |= TITLE_CACHE_CTRL;
+    }
+    else
+        titleCacheStartAppend();
+
+    auto old = titleCacheIndex.find(tid);
+    if(old != titleCacheIndex.end())
+        titleCacheDead += titleCacheBlobSize(old->second.flags);
+
+    titleCacheIndex[tid] = e;
+}
+
+static bool titleCacheGetIcon(const uint64_t& tid, uint32_t version, uint32_t *pixels)
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    auto find = titleCacheIndex.find(tid);
+    if(!titleCache || find == titleCacheIndex.end() || find->second.version != version || !(find->second.flags & TITLE_CACHE_ICON))
+        return false;
+
+    fseek(titleCache, find->second.iconOffset, SEEK_SET);
+    return fread(pixels, sizeof(uint32_t), TITLE_ICON_PIXELS, titleCache) == TITLE_ICON_PIXELS;
+}
+
+//Only kept if the control data for version is already cached. Returns whether it was
+static bool titleCacheStoreIcon(const uint64_t& tid, uint32_t version, const uint32_t *pixels)
+{
+    std::lock_guard<std::mutex> lock(titleCacheLock);
+    auto find = titleCacheIndex.find(tid);
+    if(!titleCache || find == titleCacheIndex.end() || find->second.version != version)
+        return false;
+
+    uint64_t iconOffset = titleCacheAppend(pixels, TITLE_ICON_PIXELS * sizeof(uint32_t));
+    if(iconOffset == 0)
+        return false;
+
+    titleCacheEntry& e = find->second;
+    if(e.flags & TITLE_CACHE_ICON)
+        titleCacheDead += titleCacheBlobSize(TITLE_CACHE_ICON);
+
+    e.flags |= TITLE_CACHE_ICON;
+    e.iconOffset = iconOffset;
+    return true;
+}
+
+//Decodes a control data JPEG straight to tile sized RGBA8888
+static bool decodeTitleIcon(const void *jpeg, size_t jpegSize, uint32_t *pixels)
+{
+    SDL_RWops *jpegData = SDL_RWFromConstMem(jpeg, jpegSize);
+    SDL_Surface *decoded = IMG_LoadJPG_RW(jpegData);
+    SDL_RWclose(jpegData);
+    if(!decoded)
+        return false;
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(decoded);
+    if(!converted)
+        return false;
+
+    SDL_Surface *tile = SDL_CreateRGBSurfaceWithFormatFrom(pixels, TITLE_ICON_SIZE, TITLE_ICON_SIZE, 32, TITLE_ICON_SIZE * sizeof(uint32_t), SDL_PIXELFORMAT_RGBA8888);
+    bool ret = tile && SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE) == 0 && SDL_BlitScaled(converted, NULL, tile, NULL) == 0;
+    if(tile)
+        SDL_FreeSurface(tile);
+    SDL_FreeSurface(converted);
+
+    return ret;
+}
+
+static bool decodeTitleIconFromNS(const uint64_t& tid, uint32_t *pixels)
+{
+    uint64_t outSize = 0;
+    NsApplicationControlData *ctrlData = new NsApplicationControlData;
+    bool ret = R_SUCCEEDED(nsGetApplicationControlData(NsApplicationControlSource_Storage, tid, ctrlData, sizeof(NsApplicationControlData), &outSize))
+               && outSize > sizeof(ctrlData->nacp)
+               && decodeTitleIcon(ctrlData->icon, outSize - sizeof(ctrlData->nacp), pixels);
+    delete ctrlData;
+
+    return ret;
+}
+
+//titleIconLock has to be held
+static titleIconJob *titleIconNext()
+{
+    titleIconJob *ret = NULL;
+    for(titleIconJob *job : titleIconJobs)
+    {
+        if(!ret || job->wanted > ret->wanted)
+            ret = job;
+    }
+    return ret;
+}
+
+static void titleIconThread_t(void *a)
+{
+    std::unique_lock<std::mutex> lock(titleIconLock);
+    while(true)
+    {
+        titleIconCond.wait(lock, []{ return titleIconStop || !titleIconJobs.empty(); });
+        if(titleIconStop)
+            break;
+
+        titleIconJob *job = titleIconNext();
+        for(unsigned i = 0; i < titleIconJobs.size(); i++)
+        {
+            if(titleIconJobs[i] == job)
+            {
+                titleIconJobs.erase(titleIconJobs.begin() + i);
+                break;
+            }
+        }
+        lock.unlock();
+
+        titleIconDecoded *done = new titleIconDecoded;
+        done->tid = job->tid;
+        done->pixels.resize(TITLE_ICON_PIXELS);
+        bool decoded = false;
+        if(!job->jpeg.empty())
+        {
+            if((decoded = decodeTitleIcon(job->jpeg.data(), job->jpeg.size(), done->pixels.data())))
+                done->evictable = titleCacheStoreIcon(job->tid, job->version, done->pixels.data());
+        }
+        else if((decoded = titleCacheGetIcon(job->tid, job->version, done->pixels.data())))
+            done->evictable = true;
+        else if((decoded = decodeTitleIconFromNS(job->tid, done->pixels.data())))
+            done->evictable = titleCacheStoreIcon(job->tid, job->version, done->pixels.data());
+
+        //Generic icons are rebuilt from the title ID alone
+        if(!decoded)
+        {
+            done->pixels.clear();
+            done->evictable = true;
+        }
+        delete job;
+
+        lock.lock();
+        titleIconDone.push_back(done);
+
+        //Caught up. Good time to save what's been added
+        if(titleIconJobs.empty())
+        {
+            lock.unlock();
+            data::titleCacheFlush();
+            lock.lock();
+        }
+    }
+}
+
+void data::titleIconInit()
+{
+    titleIconStop = false;
+    if(R_SUCCEEDED(threadCreate(&titleIconThread, titleIconThread_t, NULL, NULL, 0x40000, 0x2C, -2)))
+    {
+        if(R_SUCCEEDED(threadStart(&titleIconThread)))
+            titleIconRunning = true;
+        else
+            threadClose(&titleIconThread);
+    }
+}
+
+void data::titleIconExit()
+{
+    {
+        std::lock_guard<std::mutex> lock(titleIconLock);
+        titleIconStop = true;
+    }
+    titleIconCond.notify_all();
+
+    if(titleIconRunning)
+    {
+        threadWaitForExit(&titleIconThread);
+        threadClose(&titleIconThread);
+        titleIconRunning = false;
+    }
+
+    for(titleIconJob *job : titleIconJobs)
+        delete job;
+    for(titleIconDecoded *done : titleIconDone)
+        delete done;
+
+    titleIconJobs.clear();
+    titleIconDone.clear();
+}
+
+void data::titleIconQueue(const uint64_t& tid, uint32_t version, const void *jpeg, size_t jpegSize)
+{
+    titleIconJob *job = new titleIconJob;
+    job->tid = tid;
+    job->version = version;
+    if(jpeg && jpegSize > 0)
+        job->jpeg.assign((const uint8_t *)jpeg, (const uint8_t *)jpeg + jpegSize);
+
+    {
+        std::lock_guard<std::mutex> lock(titleIconLock);
+        titleIconJobs.push_back(job);
+    }
+    titleIconCond.notify_one();
+}
+
+void data::titleIconGeneric(const uint64_t& tid)
+{
+    titleIconDecoded *done = new titleIconDecoded;
+    done->tid = tid;
+    done->evictable = true;
+
+    std::lock_guard<std::mutex> lock(titleIconLock);
+    titleIconDone.push_back(done);
+}
+
+static void titleIconEvict(uint64_t _key)
+{
+    data::titleInfo *t = data::getTitleInfoByTID(_key);
+    if(t)
+        t->icon = NULL;
+
+    std::lock_guard<std::mutex> lock(titleIconLock);
+    titleIconEvicted.insert(_key);
+}
+
+void data::titleIconRequest(const uint64_t& tid)
+{
+    {
+        std::lock_guard<std::mutex> lock(titleIconLock);
+        for(titleIconJob *job : titleIconJobs)
+        {
+            if(job->tid == tid)
+            {
+                job->wanted = ++titleIconWantCounter;
+                return;
+            }
+        }
+
+        if(titleIconEvicted.erase(tid) == 0)
+            return;
+    }
+
+    //Only icons in the cache or generic ones are evicted, so the cache has it at the version it holds
+    uint32_t version = TITLE_VERSION_NONE;
+    {
+        std::lock_guard<std::mutex> lock(titleCacheLock);
+        auto find = titleCacheIndex.find(tid);
+        if(find != titleCacheIndex.end() && (find->second.flags & TITLE_CACHE_ICON))
+            version = find->second.version;
+    }
+
+    if(version == TITLE_VERSION_NONE)
+        data::titleIconGeneric(tid);
+    else
+        data::titleIconQueue(tid, version, NULL, 0);
+}
+
+unsigned data::titleIconUpload(unsigned _max)
+{
+    std::vector<titleIconDecoded *> upload;
+    {
+        std::lock_guard<std::mutex> lock(titleIconLock);
+        unsigned count = titleIconDone.size() < _max ? titleIconDone.size() : _max;
+        upload.assign(titleIconDone.begin(), titleIconDone.begin() + count);
+        titleIconDone.erase(titleIconDone.begin(), titleIconDone.begin() + count);
+    }
+
+    for(titleIconDecoded *done : upload)
+    {
+        data::titleInfo *t = data::getTitleInfoByTID(done->tid);
+        if(t && !t->icon)
+        {
+            if(done->pixels.empty())
+                t->icon = util::createIconGeneric(util::getIDStrLower(done->tid).c_str(), 32, true);
+            else
+                t->icon = gfx::texMgr->textureLoadFromPixels(done->pixels.data(), TITLE_ICON_SIZE, TITLE_ICON_SIZE);
+
+            if(t->icon && done->evictable)
+                gfx::texMgr->textureSetEvictable(t->icon, done->tid, titleIconEvict);
+        }
+        delete done;
+    }
+    return upload.size();
+}
@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <cstring>
 #include <vector>
+#include <atomic>
 #include <sys/stat.h>
 #include <switch.h>
 
@@ -10,12 +11,30 @@
 #include "ui.h"
 #include "gfx.h"
 #include "util.h"
+#include "titlecache.h"
 
 //Current menu state
 int ui::mstate = USR_SEL, ui::prevState = USR_SEL;
 
 float ui::animScale = 3.0f;
 
+uint8_t ui::pulseShift = 0;
+static bool pulseAdd = true;
+
+//Starts dirty so the first frame is composed
+static std::atomic<bool> frameDirty(true);
+static unsigned framesSinceRedraw = 0;
+
+typedef struct
+{
+    SDL_Texture *target;
+    int x, y, w, h;
+} boundBox;
+
+//Select boxes from the last composed frame and whether one is being composed
+static std::vector<boundBox> boundBoxes;
+static bool composing = false;
+
 //pad data?
 PadState ui::pad;
 HidTouchScreenState ui::touchState;
@@ -151,8 +170,8 @@ void ui::init()
     threadMngr  = new ui::threadProcMngr;
 
     //Need these from user/main menu
-    settPos = ui::usrMenu->getOptPos(ui::getUICString("mainMenuSettings", 0));
-    extPos  = ui::usrMenu->getOptPos(ui::getUICString("mainMenuExtras", 0));
+    settPos = ui::usrMenu->getOptPos(ui::getUICString(ui::str::mainMenuSettings, 0));
+    extPos  = ui::usrMenu->getOptPos(ui::getUICString(ui::str::mainMenuExtras, 0));
 }
 
 void ui::exit()
@@ -184,8 +203,9 @@ void ui::showLoadScreen()
     SDL_Texture *icon = gfx::texMgr->textureLoadFromFile("romfs:/icon.png");
     gfx::clearTarget(NULL, &ui::clearClr);
     gfx::texDraw(NULL, icon, 512, 232);
-    gfx::drawTextf(NULL, 16, 1100, 673, &ui::txtCont, ui::getUICString("loadingStartPage", 0));
+    gfx::drawTextf(NULL, 16, 1100, 673, &ui::txtCont, ui::getUICString(ui::str::loadingStartPage, 0));
     gfx::present();
+    gfx::texMgr->textureDestroy(icon);
 }
 
 void ui::drawUI()
@@ -204,8 +224,8 @@ void ui::drawUI()
 
     //Version / translation author
     gfx::drawTextf(NULL, 12, 8, 700, &ui::txtCont, "v. %02d.%02d.%04d", BLD_MON, BLD_DAY, BLD_YEAR);
-    if(ui::getUIString("author", 0) != "NULL")
-        gfx::drawTextf(NULL, 12, 8, 682, &ui::txtCont, "%s%s", ui::getUICString("translationMainPage", 0), ui::getUICString("author", 0));
+    if(ui::getUIString(ui::str::author, 0) != "NULL")
+        gfx::drawTextf(NULL, 12, 8, 682, &ui::txtCont, "%s%s", ui::getUICString(ui::str::translationMainPage, 0), ui::getUICString(ui::str::author, 0));
 
     //This only draws the help text now and only does when user select is open
     ui::usrDraw(NULL);
@@ -230,11 +250,97 @@ void ui::drawUI()
 
 static bool debugDisp = false;
 
+void ui::markDirty()
+{
+    frameDirty = true;
+}
+
+void ui::addBoundBox(SDL_Texture *target, int x, int y, int w, int h)
+{
+    if(composing)
+        boundBoxes.push_back({target, x, y, w, h});
+}
+
+static void pulseUpdate()
+{
+    if(pulseAdd)
+    {
+        ui::pulseShift += 6;
+        if(ui::pulseShift >= 0x72)
+            pulseAdd = false;
+    }
+    else
+    {
+        ui::pulseShift -= 3;
+        if(ui::pulseShift <= 0x00)
+            pulseAdd = true;
+    }
+}
+
+//Where target ends up on screen and which panel it is. Returns false for anything drawn somewhere else first
+static bool boundBoxLocate(SDL_Texture *target, SDL_Rect& _rect, int& _panel)
+{
+    _panel = -1;
+    if(!target)
+    {
+        _rect = {0, 0, 1280, 720};
+        return true;
+    }
+    else if(target == corePanel)
+    {
+        _rect = {30, 89, 1220, 559};
+        return true;
+    }
+
+    for(unsigned i = 0; i < panels.size(); i++)
+    {
+        if(panels[i]->getTexture() == target)
+        {
+            _rect = panels[i]->getRect();
+            _panel = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+//Only the outlines change between composed frames, so they're drawn again over the old frame
+static bool boundBoxRedraw()
+{
+    for(boundBox& b : boundBoxes)
+    {
+        SDL_Rect targetRect;
+        int panel;
+        if(!boundBoxLocate(b.target, targetRect, panel))
+            return false;
+
+        //Panels drawn after it are over top of it
+        SDL_Rect boxRect = {targetRect.x + b.x, targetRect.y + b.y, b.w, b.h};
+        bool covered = false;
+        for(unsigned i = panel + 1; i < panels.size() && !covered; i++)
+        {
+            SDL_Rect panelRect = panels[i]->getRect();
+            covered = panels[i]->isVisible() && SDL_HasIntersection(&boxRect, &panelRect);
+        }
+        if(covered)
+            continue;
+
+        gfx::setClip(&targetRect);
+        ui::drawBoundBoxOutline(NULL, boxRect.x, boxRect.y, b.w, b.h);
+        gfx::setClip(NULL);
+    }
+    return true;
+}
+
 bool ui::runApp()
 {
     ui::updateInput();
     uint64_t down = ui::padKeysDown();
 
+    //Checked before and after updating so the frame after one finishes is drawn without it
+    if(!threadMngr->empty() || !popMessages->empty())
+        frameDirty = true;
+
     if(threadMngr->empty())
     {
         if(down & HidNpadButton_StickL && down & HidNpadButton_StickR)
@@ -270,7 +376,32 @@ bool ui::runApp()
 
     popMessages->update();
 
-    drawUI();
+    if(!threadMngr->empty() || !popMessages->empty() || ui::padKeysHeld() || ui::touchState.count > 0)
+        frameDirty = true;
+
+    if(data::titleIconUpload(TITLE_ICON_UPLOADS_PER_FRAME) > 0)
+        frameDirty = true;
+
+    pulseUpdate();
+    //Anything that asks for a redraw while this one is composed gets the next one
+    if(frameDirty.exchange(false) || ++framesSinceRedraw >= UI_FULL_REDRAW_FRAMES)
+    {
+        framesSinceRedraw = 0;
+        boundBoxes.clear();
+        composing = true;
+        gfx::frameBegin();
+        drawUI();
+        gfx::frameEnd();
+        composing = false;
+        gfx::frameDraw();
+    }
+    else
+    {
+        gfx::frameDraw();
+        if(!boundBoxRedraw())
+            frameDirty = true;
+    }
+
     if(debugDisp)
         data::dispStats();
 
@@ -288,6 +419,7 @@ void ui::showPopMessage(int frameCount, const char *fmt, ...)
     va_end(args);
 
     popMessages->popMessageAdd(tmp, frameCount);
+    ui::markDirty();
 }
 
 void ui::toTTL(void *a)
@@ -303,6 +435,6 @@ void ui::toTTL(void *a)
     else
     {
         data::user *u = data::getCurrentUser();
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataNoneFound", 0), u->getUsername().c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataNoneFound, 0), u->getUsername().c_str());
     }
 }
@@ -76,7 +76,7 @@ static void toFMUser(void *a)
 static void _delUpdate(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("threadStatusDeletingUpdate", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingUpdate, 0));
     FsFileSystem sys;
     fsOpenBisFileSystem(&sys, FsBisPartitionId_System, "");
     fsdevMountDevice("sys", sys);
@@ -92,19 +92,19 @@ static void extMenuOptRemoveUpdate(void *a)
 
 static void extMenuTerminateProcess(void *a)
 {
-    std::string idStr = util::getStringInput(SwkbdType_QWERTY, "0100000000000000", ui::getUIString("swkbdProcessID", 0), 18, 0, NULL);
+    std::string idStr = util::getStringInput(SwkbdType_QWERTY, "0100000000000000", ui::getUIString(ui::str::swkbdProcessID, 0), 18, 0, NULL);
     if(!idStr.empty())
     {
         uint64_t termID = std::strtoull(idStr.c_str(), NULL, 16);
         if(R_SUCCEEDED(pmshellTerminateProgram(termID)))
-            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popProcessShutdown", 0), idStr.c_str());
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popProcessShutdown, 0), idStr.c_str());
     }
 }
 
 static void extMenuMountSysSave(void *a)
 {
     FsFileSystem sys;
-    std::string idStr = util::getStringInput(SwkbdType_QWERTY, "8000000000000000", ui::getUIString("swkbdSysSavID", 0), 18, 0, NULL);
+    std::string idStr = util::getStringInput(SwkbdType_QWERTY, "8000000000000000", ui::getUIString(ui::str::swkbdSysSavID, 0), 18, 0, NULL);
     uint64_t mountID = std::strtoull(idStr.c_str(), NULL, 16);
     if(R_SUCCEEDED(fsOpen_SystemSaveData(&sys, FsSaveDataSpaceId_System, mountID, (AccountUid) {0})))
     {
@@ -139,11 +139,11 @@ static void extMenuPackJKSVZip_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
     fs::copyArgs *c = (fs::copyArgs *)t->argPtr;
-    t->status->setStatus(ui::getUICString("threadStatusPackingJKSV", 0));
-    if(cfg::config["ovrClk"])
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusPackingJKSV, 0));
+    if(cfg::config[cfg::OVR_CLK])
     {
         util::sysBoost();
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popCPUBoostEnabled", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popCPUBoostEnabled, 0));
     }
 
     fs::dirList *jksv = new fs::dirList(fs::getWorkDir());
@@ -155,7 +155,8 @@ static void extMenuPackJKSVZip_t(void *a)
         zipFile zip = zipOpen64(zipPath.c_str(), 0);
         for(unsigned i = 0; i < jksv->getCount(); i++)
         {
-            if(jksv->isDir(i) && jksv->getItem(i) != "_TRASH_")
+            //Upload scratch zips are already copies of backups
+            if(jksv->isDir(i) && jksv->getItem(i) != "_TRASH_" && jksv->getItem(i) + "/" != TRANSFER_SCRATCH_DIR)
             {
                 std::string srcPath = fs::getWorkDir() + jksv->getItem(i) + "/";
                 fs::copyDirToZip(srcPath, zip, true, pathTrimPlaces, t);
@@ -163,7 +164,7 @@ static void extMenuPackJKSVZip_t(void *a)
         }
         zipClose(zip, NULL);
     }
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
         util::sysNormal();
 
     delete jksv;
@@ -183,13 +184,24 @@ static void extMenuOutputEnUs(void *a)
     ui::newThread(ui::saveTranslationFiles, NULL, NULL);
 }
 
+static void extMenuBenchmarkRemote(void *a)
+{
+    if(!fs::rfs)
+    {
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popRemoteNotActive, 0));
+        return;
+    }
+    fs::copyArgs *send = fs::copyArgsCreate("", "", "", NULL, NULL, false, false, 0);
+    ui::newThread(fs::remoteBenchmark_t, send, fs::fileDrawFunc);
+}
+
 void ui::extInit()
 {
     ui::extMenu = new ui::menu(200, 24, 1002, 24, 4);
     ui::extMenu->setCallback(extMenuCallback, NULL);
     ui::extMenu->setActive(false);
-    for(unsigned i = 0; i < 12; i++)
-        ui::extMenu->addOpt(NULL, ui::getUIString("extrasMenu", i));
+    for(unsigned i = 0; i < 13; i++)
+        ui::extMenu->addOpt(NULL, ui::getUIString(ui::str::extrasMenu, i));
 
     //SD to SD
     ui::extMenu->optAddButtonEvent(0, HidNpadButton_A, toFMSDtoSD, NULL);
@@ -215,6 +227,8 @@ void ui::extInit()
     ui::extMenu->optAddButtonEvent(10, HidNpadButton_A, extMenuPackJKSV, NULL);
     //Translation so I can be lazy
     ui::extMenu->optAddButtonEvent(11, HidNpadButton_A, extMenuOutputEnUs, NULL);
+    //Remote pipeline numbers
+    ui::extMenu->optAddButtonEvent(12, HidNpadButton_A, extMenuBenchmarkRemote, NULL);
 }
 
 void ui::extExit()
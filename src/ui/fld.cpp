@@ -1,4 +1,5 @@
 #include <switch.h>
+#include <atomic>
 
 #include "ui.h"
 #include "fs.h"
@@ -13,19 +14,49 @@ static unsigned int fldGuideWidth = 0;
 static Mutex fldLock = 0;
 static std::string driveParent;
 static std::vector<rfs::RfsItem> driveFldList;
+//Set from other threads. The menu is only rebuilt from fldUpdate so it never changes under the main thread
+static std::atomic<bool> fldListChanged(false);
+
+static void fldFuncCancelTransfers(void *a)
+{
+    threadInfo *t = (threadInfo *)a;
+    fs::transferCancelAll();
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTransfersCancelled, 0));
+    ui::fldMarkChanged();
+    t->finished = true;
+}
 
 static void fldMenuCallback(void *a)
 {
     switch(ui::padKeysDown())
     {
         case HidNpadButton_B:
-            fs::unmountSave();
-            fs::freePathFilters();
-            fldMenu->setActive(false);
-            ui::fldPanel->closePanel();
-            unsigned cusr = data::getCurrentUserIndex();
-            ui::ttlSetActive(cusr, true, true);
-            ui::updateInput();
+            {
+                fs::unmountSave();
+                fs::freePathFilters();
+                fldMenu->setActive(false);
+                ui::fldPanel->closePanel();
+                unsigned cusr = data::getCurrentUserIndex();
+                ui::ttlSetActive(cusr, true, true);
+                ui::updateInput();
+            }
+            break;
+
+        case HidNpadButton_Minus:
+            if(fs::rfs)
+            {
+                bool pause = !fs::transferIsPaused();
+                fs::transferSetPaused(pause);
+                ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(pause ? ui::str::popTransfersPaused : ui::str::popTransfersResumed, 0));
+            }
+            break;
+
+        case HidNpadButton_ZL:
+            if(fs::rfs && fs::transferGetCount() > 0)
+            {
+                ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], fldFuncCancelTransfers, NULL, NULL, ui::getUICString(ui::str::confirmCancelTransfers, 0), fs::transferGetCount());
+                ui::confirm(conf);
+            }
             break;
     }
 }
@@ -38,7 +69,18 @@ static void fldPanelDraw(void *a)
     fldMenu->draw(fldBuffer, &ui::txtCont, true);
     gfx::texDraw(target, fldBuffer, 0, 0);
     gfx::drawLine(target, &ui::divClr, 10, 648, fldGuideWidth + 54, 648);
-    gfx::drawTextf(target, 18, 32, 673, &ui::txtCont, ui::getUICString("helpFolder", 0));
+    gfx::drawTextf(target, 18, 32, 673, &ui::txtCont, ui::getUICString(ui::str::helpFolder, 0));
+
+    unsigned transfers = fs::transferGetCount();
+    if(transfers > 0)
+    {
+        //Progress moves on its own
+        ui::markDirty();
+        uint64_t done = 0, total = 0;
+        fs::transferGetProgress(done, total);
+        std::string progress = util::getSizeString(done) + " / " + util::getSizeString(total);
+        gfx::drawTextf(target, 14, 32, 698, &ui::txtCont, ui::getUICString(fs::transferIsPaused() ? ui::str::transferStatusPaused : ui::str::transferStatus, 0), transfers, progress.c_str());
+    }
     mutexUnlock(&fldLock);
 }
 
@@ -55,7 +97,7 @@ static void fldFuncOverwrite(void *a)
     std::string *send = new std::string;
     send->assign(util::generatePathByTID(utinfo->tid) + in->getItm());
 
-    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdOver"], fs::overwriteBackup, fldFuncCancel, send, ui::getUICString("confirmOverwrite", 0), in->getItm().c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_OVER], fs::overwriteBackup, fldFuncCancel, send, ui::getUICString(ui::str::confirmOverwrite, 0), in->getItm().c_str());
     ui::confirm(conf);
 }
 
@@ -66,7 +108,7 @@ static void fldFuncDelete(void *a)
     std::string *send = new std::string;
     send->assign(util::generatePathByTID(utinfo->tid) + in->getItm());
 
-    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdDel"], fs::deleteBackup, fldFuncCancel, send, ui::getUICString("confirmDelete", 0), in->getItm().c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], fs::deleteBackup, fldFuncCancel, send, ui::getUICString(ui::str::confirmDelete, 0), in->getItm().c_str());
     ui::confirm(conf);
 }
 
@@ -77,7 +119,7 @@ static void fldFuncRestore(void *a)
     std::string *send = new std::string;
     send->assign(util::generatePathByTID(utinfo->tid) + in->getItm());
 
-    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdRest"], fs::restoreBackup, fldFuncCancel, send, ui::getUICString("confirmRestore", 0), in->getItm().c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_REST], fs::restoreBackup, fldFuncCancel, send, ui::getUICString(ui::str::confirmRestore, 0), in->getItm().c_str());
     ui::confirm(conf);
 }
 
@@ -90,15 +132,15 @@ static void fldFuncUpload_t(void *a)
     data::userTitleInfo *utinfo = data::getCurrentUserTitleInfo();
     std::string path, tmpZip, filename;//Final path to upload from
 
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
         util::sysBoost();
 
     //Zip first then upload if folder based backup
     if(di->isDir())
     {
-        t->status->setStatus(ui::getUICString("threadStatusCompressingSaveForUpload", 0), di->getItm().c_str());
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusCompressingSaveForUpload, 0), di->getItm().c_str());
         filename = di->getItm() + ".zip";
-        tmpZip = util::generatePathByTID(utinfo->tid) + di->getItm() + ".zip";
+        tmpZip = fs::transferGetScratchPath(utinfo->tid, filename);
         std::string fldPath = util::generatePathByTID(utinfo->tid) + di->getItm() + "/";
 
         int zipTrim = util::getTotalPlacesInPath(fs::getWorkDir()) + 2;//Trim path down to save root
@@ -113,36 +155,11 @@ static void fldFuncUpload_t(void *a)
         path = util::generatePathByTID(utinfo->tid) + di->getItm();
     }
 
-    //Change thread stuff so upload status can be shown
-    t->status->setStatus(ui::getUICString("threadStatusUploadingFile", 0), di->getItm().c_str());
-    fs::copyArgs *cpyArgs = fs::copyArgsCreate("", "", "", NULL, NULL, false, false, 0);
-    cpyArgs->prog->setMax(fs::fsize(path));
-    cpyArgs->prog->update(0);
-    t->argPtr = cpyArgs;
-    t->drawFunc = fs::fileDrawFunc;
-
-    //curlDlArgs
-    curlFuncs::curlUpArgs upload;
-    upload.f = fopen(path.c_str(), "rb");
-    upload.o = &cpyArgs->offset;
-
-    if(fs::rfs->fileExists(filename, driveParent))
-    {
-        std::string id = fs::rfs->getFileID(filename, driveParent);
-        fs::rfs->updateFile(id, &upload);
-    }
-    else
-        fs::rfs->uploadFile(filename, driveParent, &upload);
+    //The zip made above is only for uploading and goes once it's sent
+    fs::transferAdd(fs::TRANSFER_UPLOAD, fs::TRANSFER_PRIORITY_UPLOAD, path, data::getTitleInfoByTID(utinfo->tid)->title, filename, fs::fsize(path), !tmpZip.empty());
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTransferQueued, 0), filename.c_str());
 
-    fclose(upload.f);
-
-    if(!tmpZip.empty())
-        fs::delfile(tmpZip);
-    
-    fs::copyArgsDestroy(cpyArgs);
-    t->drawFunc = NULL;
-
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
         util::sysNormal();
 
     ui::fldRefreshMenu();
@@ -155,7 +172,7 @@ static void fldFuncUpload(void *a)
     if(fs::rfs)
         ui::newThread(fldFuncUpload_t, a, NULL);
     else
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popRemoteNotActive", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popRemoteNotActive, 0));
 }
 
 static void fldFuncDownload_t(void *a)
@@ -164,36 +181,10 @@ static void fldFuncDownload_t(void *a)
     rfs::RfsItem *in = (rfs::RfsItem *)t->argPtr;
     data::userTitleInfo *utinfo = data::getCurrentUserTitleInfo();
     std::string targetPath = util::generatePathByTID(utinfo->tid) + in->name;
-    t->status->setStatus(ui::getUICString("threadStatusDownloadingFile", 0), in->name.c_str());
-    
-    if(cfg::config["ovrClk"])
-        util::sysBoost();
 
-    if(fs::fileExists(targetPath))
-        fs::delfile(targetPath);
-
-    //Use this for progress bar
-    fs::copyArgs *cpy = fs::copyArgsCreate("", "", "", NULL, NULL, false, false, 0);
-    cpy->prog->setMax(in->size);
-    cpy->prog->update(0);
-    t->argPtr = cpy;
-    t->drawFunc = fs::fileDrawFunc;
-
-    //DL struct
-    curlFuncs::curlDlArgs dlFile;
-    dlFile.path = targetPath;
-    dlFile.size = in->size;
-    dlFile.o = &cpy->offset;
-    
-    fs::rfs->downloadFile(in->id, &dlFile);
-
-    //fclose(dlFile.f);
-
-    fs::copyArgsDestroy(cpy);
-    t->drawFunc = NULL;
-
-    if(cfg::config["ovrClk"])
-        util::sysNormal();
+    //Overwrite was already confirmed. The old backup is replaced when the download finishes
+    fs::transferAdd(fs::TRANSFER_DOWNLOAD, fs::TRANSFER_PRIORITY_DOWNLOAD, targetPath, data::getTitleInfoByTID(utinfo->tid)->title, in->name, in->size, false);
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTransferQueued, 0), in->name.c_str());
 
     ui::fldRefreshMenu();
 
@@ -207,7 +198,7 @@ static void fldFuncDownload(void *a)
     std::string testPath = util::generatePathByTID(utinfo->tid) + in->name;
     if(fs::fileExists(testPath))
     {
-        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdOver"], fldFuncDownload_t, NULL, a, ui::getUICString("confirmDriveOverwrite", 0));
+        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_OVER], fldFuncDownload_t, NULL, a, ui::getUICString(ui::str::confirmDriveOverwrite, 0));
         ui::confirm(conf);
     }
     else
@@ -219,8 +210,20 @@ static void fldFuncDriveDelete_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
     rfs::RfsItem *gdi = (rfs::RfsItem *)t->argPtr;
-    t->status->setStatus(ui::getUICString("threadStatusDeletingFile", 0));
-    fs::rfs->deleteFile(gdi->id);
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
+
+    bool trashed = false;
+    if(cfg::config[cfg::TRASH_BIN] && !gdi->isDir)
+    {
+        data::userTitleInfo *utinfo = data::getCurrentUserTitleInfo();
+        std::string trashDir = fs::remoteGetTrashDir(data::getTitleNameByTID(utinfo->tid));
+        trashed = !trashDir.empty() && fs::rfs->moveFile(gdi->id, gdi->name, trashDir);
+    }
+
+    if(trashed)
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataBackupMovedToTrash, 0), gdi->name.c_str());
+    else
+        fs::rfs->deleteFile(gdi->id);
     ui::fldRefreshMenu();
     t->finished = true;    
 }
@@ -228,7 +231,7 @@ static void fldFuncDriveDelete_t(void *a)
 static void fldFuncDriveDelete(void *a)
 {
     rfs::RfsItem *in = (rfs::RfsItem *)a;
-    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdDel"], fldFuncDriveDelete_t, NULL, a, ui::getUICString("confirmDelete", 0), in->name.c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], fldFuncDriveDelete_t, NULL, a, ui::getUICString(ui::str::confirmDelete, 0), in->name.c_str());
     ui::confirm(conf);
 }
 
@@ -236,7 +239,7 @@ static void fldFuncDriveRestore_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
     rfs::RfsItem *gdi = (rfs::RfsItem *)t->argPtr;
-    t->status->setStatus(ui::getUICString("threadStatusDownloadingFile", 0), gdi->name.c_str());
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDownloadingFile, 0), gdi->name.c_str());
 
     fs::copyArgs *cpy = fs::copyArgsCreate("", "", "", NULL, NULL, false, false, 0);
     cpy->prog->setMax(gdi->size);
@@ -266,13 +269,13 @@ static void fldFuncDriveRestore_t(void *a)
 static void fldFuncDriveRestore(void *a)
 {
     rfs::RfsItem *in = (rfs::RfsItem *)a;
-    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdOver"], fldFuncDriveRestore_t, NULL, a, ui::getUICString("confirmRestore", 0), in->name.c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_OVER], fldFuncDriveRestore_t, NULL, a, ui::getUICString(ui::str::confirmRestore, 0), in->name.c_str());
     ui::confirm(conf);
 }
 
 void ui::fldInit()
 {
-    fldGuideWidth = gfx::getTextWidth(ui::getUICString("helpFolder", 0), 18);
+    fldGuideWidth = gfx::getTextWidth(ui::getUICString(ui::str::helpFolder, 0), 18);
     
     fldMenu = new ui::menu(10, 4, fldGuideWidth + 44, 18, 6);
     fldMenu->setCallback(fldMenuCallback, NULL);
@@ -294,9 +297,18 @@ void ui::fldExit()
 
 void ui::fldUpdate()
 {
+    if(fldListChanged.exchange(false) && ui::fldPanel->isOpen())
+        ui::fldRefreshMenu();
+
     fldMenu->update();
 }
 
+void ui::fldMarkChanged()
+{
+    fldListChanged = true;
+    ui::markDirty();
+}
+
 void ui::fldPopulateMenu()
 {
     mutexLock(&fldLock);
@@ -311,7 +323,7 @@ void ui::fldPopulateMenu()
     fldList->reassign(targetDir);
     fs::loadPathFilters(d->tid);
 
-    fldMenu->addOpt(NULL, ui::getUICString("folderMenuNew", 0));
+    fldMenu->addOpt(NULL, ui::getUICString(ui::str::folderMenuNew, 0));
     fldMenu->optAddButtonEvent(0, HidNpadButton_A, fs::createNewBackup, NULL);
 
     unsigned fldInd = 1;
@@ -358,7 +370,7 @@ void ui::fldRefreshMenu()
     std::string targetDir = util::generatePathByTID(utinfo->tid);
 
     fldList->reassign(targetDir);
-    fldMenu->addOpt(NULL, ui::getUIString("folderMenuNew", 0));
+    fldMenu->addOpt(NULL, ui::getUIString(ui::str::folderMenuNew, 0));
     fldMenu->optAddButtonEvent(0, HidNpadButton_A, fs::createNewBackup, NULL);
 
     unsigned fldInd = 1;
@@ -388,4 +400,5 @@ void ui::fldRefreshMenu()
     }
 
     mutexUnlock(&fldLock);
+    ui::markDirty();
 }
\ No newline at end of file
@@ -250,9 +250,9 @@ static void _copyMenuCopy(void *a)
         dstPath = *devArgs->path + d->getItem(m->getSelected() - 2);
     }
 
-    if(ma == devArgs ||  (ma == sdmcArgs && (type != FsSaveDataType_System || cfg::config["sysSaveWrite"])))
+    if(ma == devArgs ||  (ma == sdmcArgs && (type != FsSaveDataType_System || cfg::config[cfg::SYS_SAVE_WRITE])))
     {
-        ui::confirmArgs *send = ui::confirmArgsCreate(false, _copyMenuCopy_t, NULL, ma, ui::getUICString("confirmCopy", 0), srcPath.c_str(), dstPath.c_str());
+        ui::confirmArgs *send = ui::confirmArgsCreate(false, _copyMenuCopy_t, NULL, ma, ui::getUICString(ui::str::confirmCopy, 0), srcPath.c_str(), dstPath.c_str());
         ui::confirm(send);
     }
 }
@@ -264,7 +264,7 @@ static void _copyMenuDelete_t(void *a)
     ui::menu *m = ma->m;
     fs::dirList *d = ma->d;
 
-    t->status->setStatus(ui::getUICString("threadStatusDeletingFile", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
 
     int sel = m->getSelected();
     if(ma == devArgs)
@@ -324,9 +324,9 @@ static void _copyMenuDelete(void *a)
     else if(sel > 1)
         itmPath = *ma->path + d->getItem(sel - 2);
 
-    if(ma == sdmcArgs || (ma == devArgs && (sel == 0 || sel > 1) && (type != FsSaveDataType_System || cfg::config["sysSaveWrite"])))
+    if(ma == sdmcArgs || (ma == devArgs && (sel == 0 || sel > 1) && (type != FsSaveDataType_System || cfg::config[cfg::SYS_SAVE_WRITE])))
     {
-        ui::confirmArgs *send = ui::confirmArgsCreate(cfg::config["holdDel"], _copyMenuDelete_t, NULL, a, ui::getUICString("confirmDelete", 0), itmPath.c_str());
+        ui::confirmArgs *send = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], _copyMenuDelete_t, NULL, a, ui::getUICString(ui::str::confirmDelete, 0), itmPath.c_str());
         ui::confirm(send);
     }
 }
@@ -340,7 +340,7 @@ static void _copyMenuRename(void *a)
     int sel = m->getSelected();
     if(sel > 1)
     {
-        std::string getNewName = util::getStringInput(SwkbdType_QWERTY, d->getItem(sel - 2), ui::getUIString("swkbdRename", 0), 64, 0, NULL);
+        std::string getNewName = util::getStringInput(SwkbdType_QWERTY, d->getItem(sel - 2), ui::getUIString(ui::str::swkbdRename, 0), 64, 0, NULL);
         if(!getNewName.empty())
         {
             std::string prevPath = *ma->path + d->getItem(sel - 2);
@@ -358,7 +358,7 @@ static void _copyMenuRename(void *a)
 static void _copyMenuMkDir(void *a)
 {
     menuFuncArgs *ma = (menuFuncArgs *)a;
-    std::string getNewFolder = util::getStringInput(SwkbdType_QWERTY, ui::getUIString("fileModeMenuMkDir", 0), ui::getUIString("swkbdMkDir", 0), 64, 0, NULL);
+    std::string getNewFolder = util::getStringInput(SwkbdType_QWERTY, ui::getUIString(ui::str::fileModeMenuMkDir, 0), ui::getUIString(ui::str::swkbdMkDir, 0), 64, 0, NULL);
     if(!getNewFolder.empty())
     {
         std::string createPath = *ma->path + getNewFolder;
@@ -377,9 +377,9 @@ static void _copyMenuGetShowDirProps_t(void *a)
     std::string *p = (std::string *)t->argPtr;
     unsigned dirCount = 0, fileCount = 0;
     uint64_t totalSize = 0;
-    t->status->setStatus(ui::getUICString("threadStatusGetDirProps", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusGetDirProps, 0));
     fs::getDirProps(*p, dirCount, fileCount, totalSize);
-    ui::showMessage(ui::getUICString("fileModeFolderProperties", 0), p->c_str(), dirCount, fileCount, util::getSizeString(totalSize).c_str());
+    ui::showMessage(ui::getUICString(ui::str::fileModeFolderProperties, 0), p->c_str(), dirCount, fileCount, util::getSizeString(totalSize).c_str());
     delete p;
     t->finished = true;
 }
@@ -438,7 +438,7 @@ static void _devMenuAddToPathFilter(void *a)
         data::userTitleInfo *tinfo = data::getCurrentUserTitleInfo();
         std::string filterPath = *ma->path + d->getItem(sel - 2);
         cfg::addPathToFilter(tinfo->tid, filterPath);
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popAddedToPathFilter", 0), filterPath.c_str());
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popAddedToPathFilter, 0), filterPath.c_str());
     }
 }
 
@@ -460,13 +460,13 @@ void ui::fmInit()
     devCopyMenu = new ui::menu(10, 185, 268, 20, 5);
     devCopyMenu->setActive(false);
     devCopyMenu->setCallback(_devCopyMenuCallback, NULL);
-    devCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", 0) + "SDMC");
+    devCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, 0) + "SDMC");
     for(int i = 1; i < 4; i++)
-        devCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", i));
+        devCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, i));
     //Manually do this so I can place the last option higher up
-    devCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", 6));
-    devCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", 4));
-    devCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", 5));
+    devCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, 6));
+    devCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, 4));
+    devCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, 5));
 
     devCopyMenu->optAddButtonEvent(0, HidNpadButton_A, _copyMenuCopy, devArgs);
     devCopyMenu->optAddButtonEvent(1, HidNpadButton_A, _copyMenuDelete, devArgs);
@@ -487,7 +487,7 @@ void ui::fmInit()
     sdCopyMenu->setActive(false);
     sdCopyMenu->setCallback(_sdCopyMenuCallback, NULL);
     for(int i = 0; i < 6; i++)
-        sdCopyMenu->addOpt(NULL, ui::getUIString("fileModeMenu", i));
+        sdCopyMenu->addOpt(NULL, ui::getUIString(ui::str::fileModeMenu, i));
     sdCopyMenu->optAddButtonEvent(0, HidNpadButton_A, _copyMenuCopy, sdmcArgs);
     sdCopyMenu->optAddButtonEvent(1, HidNpadButton_A, _copyMenuDelete, sdmcArgs);
     sdCopyMenu->optAddButtonEvent(2, HidNpadButton_A, _copyMenuRename, sdmcArgs);
@@ -522,7 +522,7 @@ void ui::fmPrep(const FsSaveDataType& _type, const std::string& _dev, const std:
     devPath = _dev;
     sdPath = _baseSDMC;
 
-    sdCopyMenu->editOpt(0, NULL, ui::getUIString("fileModeMenu", 0) + _dev);
+    sdCopyMenu->editOpt(0, NULL, ui::getUIString(ui::str::fileModeMenu, 0) + _dev);
 
     devList->reassign(dev);
     sdList->reassign(sdPath);
@@ -1,6 +1,7 @@
 #include <cstring>
 #include <cstdarg>
 #include <cmath>
+#include <algorithm>
 #include <switch.h>
 
 #include "gfx.h"
@@ -31,8 +32,6 @@ ui::menu::menu(const int& _x, const int& _y, const int& _rW, const int& _fS, con
     mL = _mL;
     rH = _fS + 30;
     spcWidth = gfx::getTextWidth(" ", _fS) * 3;
-
-    optTex = gfx::texMgr->textureCreate(rW - 24, rH - 8);
 }
 
 void ui::menu::editParam(int _param, int newVal)
@@ -49,20 +48,16 @@ void ui::menu::editParam(int _param, int newVal)
 
         case MENU_RECT_WIDTH:
             rW = newVal;
-            SDL_DestroyTexture(optTex);
-            optTex = SDL_CreateTexture(gfx::render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC | SDL_TEXTUREACCESS_TARGET, rW, rH);
-            SDL_SetTextureBlendMode(optTex, SDL_BLENDMODE_BLEND);
             break;
 
         case MENU_RECT_HEIGHT:
             rH = newVal;
-            SDL_DestroyTexture(optTex);
-            optTex = SDL_CreateTexture(gfx::render, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC | SDL_TEXTUREACCESS_TARGET, rW, rH);
-            SDL_SetTextureBlendMode(optTex, SDL_BLENDMODE_BLEND);
             break;
 
         case MENU_FONT_SIZE:
             fSize = newVal;
+            for(ui::menuOpt& o : opt)
+                o.txtWidth = -1;
             break;
 
         case MENU_MAX_SCROLL:
@@ -75,7 +70,6 @@ int ui::menu::addOpt(SDL_Texture *_icn, const std::string& add)
 {
     ui::menuOpt newOpt;
     newOpt.txt = add;
-    newOpt.txtWidth = gfx::getTextWidth(newOpt.txt.c_str(), fSize);
     newOpt.icn = _icn;
     opt.push_back(newOpt);
     return opt.size() - 1;
@@ -87,7 +81,7 @@ void ui::menu::editOpt(int ind, SDL_Texture *_icn, const std::string& ch)
         opt[ind].icn = _icn;
 
     opt[ind].txt = ch;
-    opt[ind].txtWidth = gfx::getTextWidth(ch.c_str(), fSize);
+    opt[ind].txtWidth = -1;
 }
 
 void ui::menu::optAddButtonEvent(unsigned _ind, HidNpadButton _button, funcPtr _func, void *args)
@@ -165,7 +159,13 @@ void ui::menu::update()
     ++hoverCount;
 
     if(!change && hoverCount >= 90)
+    {
+        //Starts scrolling long options
+        if(!hover && isActive && getOptWidth(selected) > rW - 24)
+            ui::markDirty();
+
         hover = true;
+    }
     else if(change)
     {
         hoverCount = 0;
@@ -207,89 +207,71 @@ void ui::menu::draw(SDL_Texture *target, const SDL_Color *textClr, bool drawText
     {
         float add = (float)((float)tY - (float)y) / ui::animScale;
         y += ceil(add);
+        ui::markDirty();
     }
 
-    if(clrAdd)
-    {
-        clrSh += 6;
-        if(clrSh >= 0x72)
-            clrAdd = false;
-    }
-    else
-    {
-        clrSh -= 3;
-        if(clrSh <= 0x00)
-            clrAdd = true;
-    }
-
-    for(int i = 0, tY = y; i < (int)opt.size(); i++, tY += rH)
+    const SDL_Color *selClr = ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark;
+    //Only rows on screen are drawn. Text comes from the layout cache, so a row is one draw clipped to its own space
+    int first = std::max(0, (-y - rH) / rH), last = std::min((int)opt.size() - 1, (tH - y) / rH);
+    for(int i = first; i <= last; i++)
     {
-        if(tY < -rH || tY > tH)
-            continue;
+        int rowY = y + (i * rH), textY = rowY + 4 + ((rH - 8) / 2) - fSize / 2;
+        SDL_Rect clip = {x + 20, rowY + 4, rW - 24, rH - 8};
 
-        gfx::clearTarget(optTex, &ui::transparent);
-
-        //Todo: Clean this up maybe
-        if(i == selected && drawText)
+        if(i == selected && (drawText || opt[i].icn))
         {
             if(isActive)
-                ui::drawBoundBox(target, x, y + (i * rH), rW, rH, clrSh);
+                ui::drawBoundBox(target, x, rowY, rW, rH);
 
-            gfx::drawRect(target, ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark, x + 10, ((y + (rH / 2 - fSize / 2)) + (i * rH)) - 2, 4, fSize + 4);
+            gfx::drawRect(target, selClr, x + 10, ((y + (rH / 2 - fSize / 2)) + (i * rH)) - 2, 4, fSize + 4);
+        }
 
+        gfx::setClip(&clip);
+        if(i == selected && drawText)
+        {
             static int dX = 0;
-            if(hover && opt[i].txtWidth > rW - 24)
+            if(hover && getOptWidth(i) > rW - 24)
             {
-                if((dX -= 2) <= -(opt[i].txtWidth + spcWidth))
+                ui::markDirty();
+                if((dX -= 2) <= -(getOptWidth(i) + spcWidth))
                 {
                     dX = 0;
                     hoverCount = 0;
                     hover = false;
                 }
 
-                gfx::drawTextf(optTex, fSize, dX, ((rH - 8) / 2) - fSize / 2, ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark, opt[i].txt.c_str());
-                gfx::drawTextf(optTex, fSize, dX + opt[i].txtWidth + spcWidth, ((rH - 8) / 2) - fSize / 2, ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark, opt[i].txt.c_str());
+                gfx::drawTextf(target, fSize, x + 20 + dX, textY, selClr, "%s", opt[i].txt.c_str());
+                gfx::drawTextf(target, fSize, x + 20 + dX + getOptWidth(i) + spcWidth, textY, selClr, "%s", opt[i].txt.c_str());
             }
             else
             {
                 dX = 0;
-                gfx::drawTextf(optTex, fSize, 0, ((rH - 8) / 2) - fSize / 2, ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark, opt[i].txt.c_str());
+                gfx::drawTextf(target, fSize, x + 20, textY, selClr, "%s", opt[i].txt.c_str());
             }
-            gfx::texDraw(target, optTex, x + 20, (y + 4 + (i * rH)));
-        }
-        else if(i == selected && !drawText && opt[i].icn)
-        {
-            int w, h;
-            SDL_QueryTexture(opt[i].icn, NULL, NULL, &w, &h);
-            float scale = (float)fSize / (float)h;
-            int dW = scale * w;
-            int dH = scale * h;
-            if(isActive)
-                ui::drawBoundBox(target, x, y + (i * rH), rW, rH, clrSh);
-
-            gfx::drawRect(target, ui::thmID == ColorSetId_Light ? &menuColorLight : &menuColorDark, x + 10, ((y + (rH / 2 - fSize / 2)) + (i * rH)) - 2, 4, fSize + 4);
-            gfx::texDrawStretch(optTex, opt[i].icn, 0, ((rH - 8) / 2) - fSize / 2, dW, dH);
-            gfx::texDraw(target, optTex, x + 20, (y + 4 + (i * rH)));
         }
         else if(drawText)
-        {
-            gfx::clearTarget(optTex, &ui::transparent);
-            gfx::drawTextf(optTex, fSize, 0, ((rH - 8) / 2) - fSize / 2, textClr, opt[i].txt.c_str());
-            gfx::texDraw(target, optTex, x + 20, (y + 4 + (i * rH)));
-        }
-        else if(!drawText && opt[i].icn)
+            gfx::drawTextf(target, fSize, x + 20, textY, textClr, "%s", opt[i].txt.c_str());
+        else if(opt[i].icn)
         {
             int w, h;
             SDL_QueryTexture(opt[i].icn, NULL, NULL, &w, &h);
             float scale = (float)fSize / (float)h;
             int dW = scale * w;
             int dH = scale * h;
-            gfx::texDrawStretch(optTex, opt[i].icn, 0, ((rH - 8) / 2) - fSize / 2, dW, dH);
-            gfx::texDraw(target, optTex, x + 20, (y + 4 + (i * rH)));
+            gfx::texDrawStretch(target, opt[i].icn, x + 20, textY, dW, dH);
         }
+        gfx::setClip(NULL);
     }
 }
 
+int ui::menu::getOptWidth(int ind)
+{
+    if(opt[ind].txtWidth < 0)
+        opt[ind].txtWidth = gfx::getTextWidth(opt[ind].txt.c_str(), fSize);
+
+    return opt[ind].txtWidth;
+}
+
 void ui::menu::reset()
 {
     opt.clear();
@@ -442,18 +424,18 @@ void confirmDrawFunc(void *a)
     ui::confirmArgs *c = (ui::confirmArgs *)t->argPtr;
     if(!t->finished)
     {
-        std::string yesTxt = ui::getUIString("dialogYes", 0);
+        std::string yesTxt = ui::getUIString(ui::str::dialogYes, 0);
         unsigned yesX = 0;
 
         if((ui::padKeysHeld() & HidNpadButton_A) && c->hold)
         {
             c->frameCount++;
             if(c->frameCount <= 40)
-                yesTxt = ui::getUIString("holdingText", 0);
+                yesTxt = ui::getUIString(ui::str::holdingText, 0);
             else if(c->frameCount <= 80)
-                yesTxt = ui::getUIString("holdingText", 1);
+                yesTxt = ui::getUIString(ui::str::holdingText, 1);
             else if(c->frameCount <= 120)
-                yesTxt = ui::getUICString("holdingText", 2);
+                yesTxt = ui::getUICString(ui::str::holdingText, 2);
 
             yesTxt += ui::loadGlyphArray[c->lgFrame];
         }
@@ -468,7 +450,7 @@ void confirmDrawFunc(void *a)
         gfx::drawLine(NULL, &ui::rectSh, 280, 454, 999, 454);
         gfx::drawLine(NULL, &ui::rectSh, 640, 454, 640, 518);
         gfx::drawTextf(NULL, 18, yesX, 478, &ui::txtCont, yesTxt.c_str());
-        gfx::drawTextf(NULL, 18, 782, 478, &ui::txtCont, ui::getUICString("dialogNo", 0));
+        gfx::drawTextf(NULL, 18, 782, 478, &ui::txtCont, ui::getUICString(ui::str::dialogNo, 0));
     }
 }
 
@@ -498,11 +480,11 @@ static void showMessageDrawFunc(void *a)
     std::string *text = (std::string *)t->argPtr;
     if(!t->finished)
     {
-        unsigned okX = 640 - (gfx::getTextWidth(ui::getUICString("dialogOK", 0), 18) / 2);
+        unsigned okX = 640 - (gfx::getTextWidth(ui::getUICString(ui::str::dialogOK, 0), 18) / 2);
         ui::drawTextbox(NULL, 280, 262, 720, 256);
         gfx::drawLine(NULL, &ui::rectSh, 280, 454, 999, 454);
         gfx::drawTextfWrap(NULL, 16, 312, 288, 656, &ui::txtCont, text->c_str());
-        gfx::drawTextf(NULL, 18, okX, 478, &ui::txtCont, ui::getUICString("dialogOK", 0));
+        gfx::drawTextf(NULL, 18, okX, 478, &ui::txtCont, ui::getUICString(ui::str::dialogOK, 0));
     }
 }
 
@@ -534,9 +516,8 @@ void ui::drawTextbox(SDL_Texture *target, int x, int y, int w, int h)
     gfx::texDraw(target, ui::cornerBottomRight, (x + w) - 32, (y + h) - 32);
 }
 
-void ui::drawBoundBox(SDL_Texture *target, int x, int y, int w, int h, uint8_t clrSh)
+void ui::drawBoundBox(SDL_Texture *target, int x, int y, int w, int h)
 {
-    SDL_SetRenderTarget(gfx::render, target);
     SDL_Color rectClr;
 
     if(ui::thmID == ColorSetId_Light)
@@ -545,8 +526,13 @@ void ui::drawBoundBox(SDL_Texture *target, int x, int y, int w, int h, uint8_t c
         rectClr = {0x21, 0x22, 0x21, 0xFF};
 
     gfx::drawRect(target, &rectClr, x + 4, y + 4, w - 8, h - 8);
+    ui::drawBoundBoxOutline(target, x, y, w, h);
+    ui::addBoundBox(target, x, y, w, h);
+}
 
-    rectClr = {0x00, (uint8_t)(0x88 + clrSh), (uint8_t)(0xC5 + (clrSh / 2)), 0xFF};
+void ui::drawBoundBoxOutline(SDL_Texture *target, int x, int y, int w, int h)
+{
+    SDL_Color rectClr = {0x00, (uint8_t)(0x88 + ui::pulseShift), (uint8_t)(0xC5 + (ui::pulseShift / 2)), 0xFF};
 
     SDL_SetTextureColorMod(mnuTopLeft, rectClr.r, rectClr.g, rectClr.b);
     SDL_SetTextureColorMod(mnuTopRight, rectClr.r, rectClr.g, rectClr.b);
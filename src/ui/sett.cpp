@@ -12,13 +12,13 @@ static ui::slideOutPanel *blEditPanel;
 static ui::menu *blEditMenu;
 
 //This is the name of strings used here
-static const char *settMenuStr = "settingsMenu";
+static const ui::str::id settMenuStr = ui::str::settingsMenu;
 
 static unsigned optHelpX = 0;
 
 static inline std::string getBoolText(const bool& b)
 {
-    return b ? ui::getUIString("settingsOn", 0) : ui::getUIString("settingsOff", 0);
+    return b ? ui::getUIString(ui::str::settingsOn, 0) : ui::getUIString(ui::str::settingsOff, 0);
 }
 
 static inline void toggleBool(bool& b)
@@ -51,7 +51,7 @@ static void settMenuCallback(void *a)
 static void settMenuDeleteAllBackups_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("threadStatusDeletingFile", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
 
     fs::dirList *jksvDir = new fs::dirList(fs::getWorkDir());
     for(unsigned i = 0; i < jksvDir->getCount(); i++)
@@ -68,7 +68,7 @@ static void settMenuDeleteAllBackups_t(void *a)
 
 static void settMenuDeleteAllBackups(void *a)
 {
-    ui::confirmArgs *send = ui::confirmArgsCreate(true, settMenuDeleteAllBackups_t, NULL, NULL, ui::getUICString("confirmDeleteBackupsAll", 0));
+    ui::confirmArgs *send = ui::confirmArgsCreate(true, settMenuDeleteAllBackups_t, NULL, NULL, ui::getUICString(ui::str::confirmDeleteBackupsAll, 0));
     ui::confirm(send);
 }
 
@@ -123,7 +123,7 @@ static void toggleOpt(void *a)
         case 0:
             fs::delDir(fs::getWorkDir() + "_TRASH_/");
             mkdir(std::string(fs::getWorkDir() + "_TRASH_").c_str(), 777);
-            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popTrashEmptied", 0));
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popTrashEmptied, 0));
             break;
 
         case 1:
@@ -133,7 +133,7 @@ static void toggleOpt(void *a)
         case 2:
             {
                 std::string oldWD = fs::getWorkDir();
-                std::string getWD = util::getStringInput(SwkbdType_QWERTY, fs::getWorkDir(), ui::getUIString("swkbdSetWorkDir", 0), 64, 0, NULL);
+                std::string getWD = util::getStringInput(SwkbdType_QWERTY, fs::getWorkDir(), ui::getUIString(ui::str::swkbdSetWorkDir, 0), 64, 0, NULL);
                 if(!getWD.empty())
                 {
                     if(getWD[getWD.length() - 1] != '/')
@@ -160,59 +160,59 @@ static void toggleOpt(void *a)
             break;
 
         case 5:
-            toggleBool(cfg::config["incDev"]);
+            toggleBool(cfg::config[cfg::INC_DEV]);
             break;
 
         case 6:
-            toggleBool(cfg::config["autoBack"]);
+            toggleBool(cfg::config[cfg::AUTO_BACK]);
             break;
 
         case 7:
-            toggleBool(cfg::config["autoName"]);
+            toggleBool(cfg::config[cfg::AUTO_NAME]);
             break;
 
         case 8:
-            toggleBool(cfg::config["ovrClk"]);
+            toggleBool(cfg::config[cfg::OVR_CLK]);
             break;
 
         case 9:
-            toggleBool(cfg::config["holdDel"]);
+            toggleBool(cfg::config[cfg::HOLD_DEL]);
             break;
 
         case 10:
-            toggleBool(cfg::config["holdRest"]);
+            toggleBool(cfg::config[cfg::HOLD_REST]);
             break;
 
         case 11:
-            toggleBool(cfg::config["holdOver"]);
+            toggleBool(cfg::config[cfg::HOLD_OVER]);
             break;
 
         case 12:
-            toggleBool(cfg::config["forceMount"]);
+            toggleBool(cfg::config[cfg::FORCE_MOUNT]);
             break;
 
         case 13:
-            toggleBool(cfg::config["accSysSave"]);
+            toggleBool(cfg::config[cfg::ACC_SYS_SAVE]);
             break;
 
         case 14:
-            toggleBool(cfg::config["sysSaveWrite"]);
+            toggleBool(cfg::config[cfg::SYS_SAVE_WRITE]);
             break;
 
         case 15:
-            toggleBool(cfg::config["directFsCmd"]);
+            toggleBool(cfg::config[cfg::DIRECT_FS_CMD]);
             break;
 
         case 16:
-            toggleBool(cfg::config["zip"]);
+            toggleBool(cfg::config[cfg::ZIP]);
             break;
 
         case 17:
-            toggleBool(cfg::config["langOverride"]);
+            toggleBool(cfg::config[cfg::LANG_OVERRIDE]);
             break;
 
         case 18:
-            toggleBool(cfg::config["trashBin"]);
+            toggleBool(cfg::config[cfg::TRASH_BIN]);
             break;
 
         case 19:
@@ -229,33 +229,33 @@ static void toggleOpt(void *a)
             break;
 
         case 21:
-            toggleBool(cfg::config["autoUpload"]);
+            toggleBool(cfg::config[cfg::AUTO_UPLOAD]);
             break;
     }
 }
 
 static void updateMenuText()
 {
-    ui::settMenu->editOpt(5, NULL, ui::getUIString(settMenuStr, 5) + getBoolText(cfg::config["incDev"]));
-    ui::settMenu->editOpt(6, NULL, ui::getUIString(settMenuStr, 6) + getBoolText(cfg::config["autoBack"]));
-    ui::settMenu->editOpt(7, NULL, ui::getUIString(settMenuStr, 7) + getBoolText(cfg::config["autoName"]));
-    ui::settMenu->editOpt(8, NULL, ui::getUIString(settMenuStr, 8) + getBoolText(cfg::config["ovrClk"]));
-    ui::settMenu->editOpt(9, NULL, ui::getUIString(settMenuStr, 9) + getBoolText(cfg::config["holdDel"]));
-    ui::settMenu->editOpt(10, NULL, ui::getUIString(settMenuStr, 10) + getBoolText(cfg::config["holdRest"]));
-    ui::settMenu->editOpt(11, NULL, ui::getUIString(settMenuStr, 11) + getBoolText(cfg::config["holdOver"]));
-    ui::settMenu->editOpt(12, NULL, ui::getUIString(settMenuStr, 12) + getBoolText(cfg::config["forceMount"]));
-    ui::settMenu->editOpt(13, NULL, ui::getUIString(settMenuStr, 13) + getBoolText(cfg::config["accSysSave"]));
-    ui::settMenu->editOpt(14, NULL, ui::getUIString(settMenuStr, 14) + getBoolText(cfg::config["sysSaveWrite"]));
-    ui::settMenu->editOpt(15, NULL, ui::getUIString(settMenuStr, 15) + getBoolText(cfg::config["directFsCmd"]));
-    ui::settMenu->editOpt(16, NULL, ui::getUIString(settMenuStr, 16) + getBoolText(cfg::config["zip"]));
-    ui::settMenu->editOpt(17, NULL, ui::getUIString(settMenuStr, 17) + getBoolText(cfg::config["langOverride"]));
-    ui::settMenu->editOpt(18, NULL, ui::getUIString(settMenuStr, 18) + getBoolText(cfg::config["trashBin"]));
-    ui::settMenu->editOpt(19, NULL, ui::getUIString(settMenuStr, 19) + ui::getUICString("sortType", cfg::sortType));
+    ui::settMenu->editOpt(5, NULL, ui::getUIString(settMenuStr, 5) + getBoolText(cfg::config[cfg::INC_DEV]));
+    ui::settMenu->editOpt(6, NULL, ui::getUIString(settMenuStr, 6) + getBoolText(cfg::config[cfg::AUTO_BACK]));
+    ui::settMenu->editOpt(7, NULL, ui::getUIString(settMenuStr, 7) + getBoolText(cfg::config[cfg::AUTO_NAME]));
+    ui::settMenu->editOpt(8, NULL, ui::getUIString(settMenuStr, 8) + getBoolText(cfg::config[cfg::OVR_CLK]));
+    ui::settMenu->editOpt(9, NULL, ui::getUIString(settMenuStr, 9) + getBoolText(cfg::config[cfg::HOLD_DEL]));
+    ui::settMenu->editOpt(10, NULL, ui::getUIString(settMenuStr, 10) + getBoolText(cfg::config[cfg::HOLD_REST]));
+    ui::settMenu->editOpt(11, NULL, ui::getUIString(settMenuStr, 11) + getBoolText(cfg::config[cfg::HOLD_OVER]));
+    ui::settMenu->editOpt(12, NULL, ui::getUIString(settMenuStr, 12) + getBoolText(cfg::config[cfg::FORCE_MOUNT]));
+    ui::settMenu->editOpt(13, NULL, ui::getUIString(settMenuStr, 13) + getBoolText(cfg::config[cfg::ACC_SYS_SAVE]));
+    ui::settMenu->editOpt(14, NULL, ui::getUIString(settMenuStr, 14) + getBoolText(cfg::config[cfg::SYS_SAVE_WRITE]));
+    ui::settMenu->editOpt(15, NULL, ui::getUIString(settMenuStr, 15) + getBoolText(cfg::config[cfg::DIRECT_FS_CMD]));
+    ui::settMenu->editOpt(16, NULL, ui::getUIString(settMenuStr, 16) + getBoolText(cfg::config[cfg::ZIP]));
+    ui::settMenu->editOpt(17, NULL, ui::getUIString(settMenuStr, 17) + getBoolText(cfg::config[cfg::LANG_OVERRIDE]));
+    ui::settMenu->editOpt(18, NULL, ui::getUIString(settMenuStr, 18) + getBoolText(cfg::config[cfg::TRASH_BIN]));
+    ui::settMenu->editOpt(19, NULL, ui::getUIString(settMenuStr, 19) + ui::getUICString(ui::str::sortType, cfg::sortType));
 
     char tmp[16];
     sprintf(tmp, "%.1f", ui::animScale);
     ui::settMenu->editOpt(20, NULL, ui::getUIString(settMenuStr, 20) + std::string(tmp));
-    ui::settMenu->editOpt(21, NULL, ui::getUIString(settMenuStr, 21) + getBoolText(cfg::config["autoUpload"]));
+    ui::settMenu->editOpt(21, NULL, ui::getUIString(settMenuStr, 21) + getBoolText(cfg::config[cfg::AUTO_UPLOAD]));
 }
 
 void ui::settInit()
@@ -270,11 +270,11 @@ void ui::settInit()
     blEditMenu->setActive(false);
     ui::registerPanel(blEditPanel);
 
-    optHelpX = 1220 - gfx::getTextWidth(ui::getUICString("helpSettings", 0), 18);
+    optHelpX = 1220 - gfx::getTextWidth(ui::getUICString(ui::str::helpSettings, 0), 18);
 
     for(unsigned i = 0; i < 22; i++)
     {
-        ui::settMenu->addOpt(NULL, ui::getUIString("settingsMenu", i));
+        ui::settMenu->addOpt(NULL, ui::getUIString(ui::str::settingsMenu, i));
         ui::settMenu->optAddButtonEvent(i, HidNpadButton_A, toggleOpt, NULL);
     }
 }
@@ -297,5 +297,5 @@ void ui::settDraw(SDL_Texture *target)
     updateMenuText();
     ui::settMenu->draw(target, &ui::txtCont, true);
     if(ui::mstate == OPT_MNU)
-        gfx::drawTextf(NULL, 18, optHelpX, 673, &ui::txtCont, ui::getUICString("helpSettings", 0));
+        gfx::drawTextf(NULL, 18, optHelpX, 673, &ui::txtCont, ui::getUICString(ui::str::helpSettings, 0));
 }
@@ -39,6 +39,7 @@ void ui::slideOutPanel::draw(const SDL_Color *backCol)
 {
     gfx::clearTarget(panel, backCol);
 
+    int oldX = x;
     if(open && sldSide == ui::SLD_LEFT && x < 0)
     {
         float add = (float)x / ui::animScale;
@@ -60,7 +61,10 @@ void ui::slideOutPanel::draw(const SDL_Color *backCol)
         x += ceil(add);
     }
 
-    if((sldSide == ui::SLD_LEFT && x > -w) || (sldSide == ui::SLD_RIGHT && x < 1280))
+    if(x != oldX)
+        ui::markDirty();
+
+    if(isVisible())
     {
         (*drawFunc)(panel);
         gfx::texDraw(NULL, panel, x, y);
@@ -50,6 +50,8 @@ void ui::threadProcMngr::update()
         }
         else if(!t->running && R_FAILED(res))//Should kill the thread that failed.
             t->finished = true;
+        else if(t->running && !t->finished && (ui::padKeysDown() & HidNpadButton_B))
+            t->cancel = true;
         else if(t->finished)
         {
             threadWaitForExit(&t->thrd);
@@ -4,6 +4,7 @@
 #include "ttl.h"
 #include "file.h"
 #include "util.h"
+#include "titlecache.h"
 #include "cfg.h"
 
 static int ttlHelpX = 0;
@@ -11,6 +12,8 @@ static std::vector<ui::titleview *> ttlViews;
 static ui::menu *ttlOpts;
 ui::slideOutPanel *ui::ttlOptsPanel;
 static ui::slideOutPanel *infoPanel;
+//Full size icon for the info panel. Tile icons are too small to stretch up to it. Kept until the panel opens again
+static SDL_Texture *infoIcon = NULL;
 static Mutex ttlViewLock = 0;
 
 void ui::ttlRefresh()
@@ -19,6 +22,21 @@ void ui::ttlRefresh()
     for(int i = 0; i < (int)data::users.size(); i++)
         ttlViews[i]->refresh();
     mutexUnlock(&ttlViewLock);
+    ui::markDirty();
+}
+
+void ui::ttlApplyChanges(const std::vector<data::titleListChange>& _changes)
+{
+    mutexLock(&ttlViewLock);
+    for(const data::titleListChange& c : _changes)
+    {
+        if(c.added)
+            ttlViews[c.user]->insertTile(c.pos, c.tid);
+        else
+            ttlViews[c.user]->eraseTile(c.pos);
+    }
+    mutexUnlock(&ttlViewLock);
+    ui::markDirty();
 }
 
 static void ttlViewCallback(void *a)
@@ -89,7 +107,7 @@ static void ttlOptsShowInfoPanel(void *)
     data::titleInfo     *tinfo  = data::getTitleInfoByTID(utinfo->tid);
 
     char tmp[256];
-    sprintf(tmp, ui::getUICString("infoStatus", 4), tinfo->author.c_str());
+    sprintf(tmp, ui::getUICString(ui::str::infoStatus, 4), tinfo->author.c_str());
 
     size_t titleWidth = gfx::getTextWidth(tinfo->title.c_str(), 18);
     size_t pubWidth = gfx::getTextWidth(tmp, 18);
@@ -101,6 +119,18 @@ static void ttlOptsShowInfoPanel(void *)
     else
         infoPanel->resizePanel(410, 720, 0);
 
+    if(infoIcon)
+    {
+        gfx::texMgr->textureDestroy(infoIcon);
+        infoIcon = NULL;
+    }
+
+    NsApplicationControlData *ctrlData = new NsApplicationControlData;
+    uint64_t ctrlSize = 0;
+    if(R_SUCCEEDED(nsGetApplicationControlData(NsApplicationControlSource_Storage, utinfo->tid, ctrlData, sizeof(NsApplicationControlData), &ctrlSize)) && ctrlSize > sizeof(ctrlData->nacp))
+        infoIcon = gfx::texMgr->textureLoadFromMem(IMG_FMT_JPG, ctrlData->icon, ctrlSize - sizeof(ctrlData->nacp));
+    delete ctrlData;
+
     ttlOpts->setActive(false);
     ui::ttlOptsPanel->closePanel();
     infoPanel->openPanel();
@@ -109,7 +139,7 @@ static void ttlOptsShowInfoPanel(void *)
 static void ttlOptsBlacklistTitle(void *a)
 {
     std::string title = data::getTitleNameByTID(data::getCurrentUserTitleInfo()->tid);
-    ui::confirmArgs *conf = ui::confirmArgsCreate(false, cfg::addTitleToBlacklist, NULL, NULL, ui::getUICString("confirmBlacklist", 0), title.c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(false, cfg::addTitleToBlacklist, NULL, NULL, ui::getUICString(ui::str::confirmBlacklist, 0), title.c_str());
     ui::confirm(conf);
 }
 
@@ -117,7 +147,7 @@ static void ttlOptsDefinePath(void *a)
 {
     uint64_t tid = data::getCurrentUserTitleInfo()->tid;
     std::string safeTitle = data::getTitleInfoByTID(tid)->safeTitle;
-    std::string newSafeTitle = util::getStringInput(SwkbdType_QWERTY, safeTitle, ui::getUICString("swkbdNewSafeTitle", 0), 0x200, 0, NULL);
+    std::string newSafeTitle = util::getStringInput(SwkbdType_QWERTY, safeTitle, ui::getUICString(ui::str::swkbdNewSafeTitle, 0), 0x200, 0, NULL);
     if(!newSafeTitle.empty())
         cfg::pathDefAdd(tid, newSafeTitle);
 }
@@ -139,7 +169,7 @@ static void ttlOptsToFileMode(void *a)
 static void ttlOptsDeleteAllBackups_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("threadStatusDeletingFile", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
     std::string targetPath = util::generatePathByTID(d->tid);
     fs::dirList *backupList = new fs::dirList(targetPath);
@@ -163,7 +193,52 @@ static void ttlOptsDeleteAllBackups(void *a)
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
     std::string currentTitle = data::getTitleNameByTID(d->tid);
 
-    ui::confirmArgs *send = ui::confirmArgsCreate(cfg::config["holdDel"], ttlOptsDeleteAllBackups_t, NULL, NULL, ui::getUICString("confirmDeleteBackupsTitle", 0), currentTitle.c_str());
+    ui::confirmArgs *send = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], ttlOptsDeleteAllBackups_t, NULL, NULL, ui::getUICString(ui::str::confirmDeleteBackupsTitle, 0), currentTitle.c_str());
+    ui::confirm(send);
+}
+
+static void ttlOptsDeleteRemoteBackups_t(void *a)
+{
+    threadInfo *t = (threadInfo *)a;
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingFile, 0));
+    data::userTitleInfo *d = data::getCurrentUserTitleInfo();
+    std::string title = data::getTitleNameByTID(d->tid);
+    if(!fs::rfs->dirExists(title, fs::rfsRootID))
+    {
+        t->finished = true;
+        return;
+    }
+
+    std::vector<rfs::RfsItem> remoteList = fs::rfs->getListWithParent(fs::rfs->getDirID(title, fs::rfsRootID));
+    std::string trashDir = cfg::config[cfg::TRASH_BIN] ? fs::remoteGetTrashDir(title) : "";
+    //Anything that can't go in the trash is deleted with one request where the backend supports it
+    std::vector<std::string> remoteIDs;
+    for(const rfs::RfsItem& item : remoteList)
+    {
+        if(item.isDir)
+            continue;
+
+        if(trashDir.empty() || !fs::rfs->moveFile(item.id, item.name, trashDir))
+            remoteIDs.push_back(item.id);
+    }
+    fs::rfs->deleteFiles(remoteIDs);
+
+    if(ui::fldPanel->isOpen())
+        ui::fldRefreshMenu();
+    t->finished = true;
+}
+
+static void ttlOptsDeleteRemoteBackups(void *a)
+{
+    if(!fs::rfs)
+    {
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popRemoteNotActive, 0));
+        return;
+    }
+
+    data::userTitleInfo *d = data::getCurrentUserTitleInfo();
+    std::string currentTitle = data::getTitleNameByTID(d->tid);
+    ui::confirmArgs *send = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], ttlOptsDeleteRemoteBackups_t, NULL, NULL, ui::getUICString(ui::str::confirmDeleteBackupsRemote, 0), currentTitle.c_str());
     ui::confirm(send);
 }
 
@@ -172,13 +247,13 @@ static void ttlOptsResetSaveData_t(void *a)
     threadInfo *t = (threadInfo *)a;
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
     std::string title = data::getTitleNameByTID(d->tid);
-    t->status->setStatus(ui::getUICString("threadStatusResettingSaveData", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusResettingSaveData, 0));
 
     fs::mountSave(d->saveInfo);
     fs::delDir("sv:/");
     fsdevCommitDevice("sv:/");
     fs::unmountSave();
-    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataResetSuccess", 0), title.c_str());
+    ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataResetSuccess, 0), title.c_str());
     t->finished = true;
 }
 
@@ -188,7 +263,7 @@ static void ttlOptsResetSaveData(void *a)
     if(d->saveInfo.save_data_type != FsSaveDataType_System)
     {
         std::string title = data::getTitleNameByTID(d->tid);
-        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdDel"], ttlOptsResetSaveData_t, NULL, NULL, ui::getUICString("confirmResetSaveData", 0), title.c_str());
+        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], ttlOptsResetSaveData_t, NULL, NULL, ui::getUICString(ui::str::confirmResetSaveData, 0), title.c_str());
         ui::confirm(conf);
     }
 }
@@ -201,10 +276,13 @@ static void ttlOptsDeleteSaveData_t(void *a)
     unsigned userIndex = data::getCurrentUserIndex();
 
     std::string title = data::getTitleNameByTID(d->tid);
-    t->status->setStatus(ui::getUICString("threadStatusDeletingSaveData", 0), title.c_str());
-    if(R_SUCCEEDED(fsDeleteSaveDataFileSystemBySaveDataSpaceId((FsSaveDataSpaceId)d->saveInfo.save_data_space_id, d->saveInfo.save_data_id)))
+    uint64_t saveID = d->saveInfo.save_data_id;
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingSaveData, 0), title.c_str());
+    if(R_SUCCEEDED(fsDeleteSaveDataFileSystemBySaveDataSpaceId((FsSaveDataSpaceId)d->saveInfo.save_data_space_id, saveID)))
     {
-        data::loadUsersTitles(false);
+        std::vector<data::titleListChange> changes;
+        data::removeUserSave(saveID, changes);
+        ui::ttlApplyChanges(changes);
         if(u->titleInfo.size() == 0)
         {
             //Kick back to user
@@ -214,8 +292,7 @@ static void ttlOptsDeleteSaveData_t(void *a)
             ui::usrMenu->setActive(true);
             ui::changeState(USR_SEL);
         }
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("saveDataDeleteSuccess", 0), title.c_str());
-        ttlViews[userIndex]->refresh();
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::saveDataDeleteSuccess, 0), title.c_str());
     }
     t->finished = true;
 }
@@ -226,7 +303,7 @@ static void ttlOptsDeleteSaveData(void *a)
     if(d->saveInfo.save_data_type != FsSaveDataType_System)
     {
         std::string title = data::getTitleNameByTID(d->tid);
-        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config["holdDel"], ttlOptsDeleteSaveData_t, NULL, NULL, ui::getUICString("confirmDeleteSaveData", 0), title.c_str());
+        ui::confirmArgs *conf = ui::confirmArgsCreate(cfg::config[cfg::HOLD_DEL], ttlOptsDeleteSaveData_t, NULL, NULL, ui::getUICString(ui::str::confirmDeleteSaveData, 0), title.c_str());
         ui::confirm(conf);
     }
 }
@@ -236,7 +313,7 @@ static void ttlOptsExtendSaveData(void *a)
     data::userTitleInfo *d = data::getCurrentUserTitleInfo();
     if(d->saveInfo.save_data_type != FsSaveDataType_System)
     {
-        std::string expSizeStr = util::getStringInput(SwkbdType_NumPad, "", ui::getUICString("swkbdExpandSize", 0), 4, 0, NULL);
+        std::string expSizeStr = util::getStringInput(SwkbdType_NumPad, "", ui::getUICString(ui::str::swkbdExpandSize, 0), 4, 0, NULL);
         uint64_t extMB = strtoul(expSizeStr.c_str(), NULL, 10) * 0x100000;
         fs::extendSaveDataThreaded(d, extMB);
     }
@@ -245,26 +322,31 @@ static void ttlOptsExtendSaveData(void *a)
 static void ttlOptsExportSVI(void *a)
 {
     data::userTitleInfo *ut = data::getCurrentUserTitleInfo();
-    data::titleInfo *t = data::getTitleInfoByTID(ut->tid);
     std::string out = fs::getWorkDir() + "svi/";
     fs::mkDir(out.substr(0, out.length() - 1));
     out += util::getIDStr(ut->tid) + ".svi";
+
+    //Only part of the nacp is kept around, so the whole thing comes from ns with the icon
+    NsApplicationControlData *ctrlData = new NsApplicationControlData;
+    uint64_t ctrlSize = 0;
+    if(R_FAILED(nsGetApplicationControlData(NsApplicationControlSource_Storage, ut->tid, ctrlData, sizeof(NsApplicationControlData), &ctrlSize)) || ctrlSize < sizeof(ctrlData->nacp))
+    {
+        fs::logWrite("SVI: no control data for %016lX\n", ut->tid);
+        delete ctrlData;
+        return;
+    }
+
     FILE *svi = fopen(out.c_str(), "wb");
     if(svi)
     {
-        //Grab icon
-        NsApplicationControlData *ctrlData = new NsApplicationControlData;
-        uint64_t ctrlSize = 0;
-        nsGetApplicationControlData(NsApplicationControlSource_Storage, ut->tid, ctrlData, sizeof(NsApplicationControlData), &ctrlSize);
         size_t jpegSize = ctrlSize - sizeof(ctrlData->nacp);
-
         fwrite(&ut->tid, sizeof(uint64_t), 1, svi);
-        fwrite(&t->nacp, sizeof(NacpStruct), 1, svi);
+        fwrite(&ctrlData->nacp, sizeof(NacpStruct), 1, svi);
         fwrite(ctrlData->icon, 1, jpegSize, svi);
         fclose(svi);
-        delete ctrlData;
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("popSVIExported", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::popSVIExported, 0));
     }
+    delete ctrlData;
 }
 
 static void infoPanelDraw(void *a)
@@ -277,49 +359,55 @@ static void infoPanelDraw(void *a)
     rectWidth = width - 20;
 
     iconX = (width / 2) - 128;
-    gfx::texDraw(panel, data::getTitleIconByTID(d->tid), iconX, 24);
+    SDL_Texture *icon = data::getTitleIconByTID(d->tid);
+    if(infoIcon)
+        gfx::texDrawStretch(panel, infoIcon, iconX, 24, 256, 256);
+    else if(icon)//Not installed anymore. The tile icon is drawn as is instead of blown up
+        gfx::texDraw(panel, icon, iconX + 64, 88);
+    else
+        data::titleIconRequest(d->tid);
 
     gfx::drawRect(panel, &ui::rectLt, 10, drawY, rectWidth, 38);
     gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, data::getTitleNameByTID(d->tid).c_str());
     drawY += 40;
 
     gfx::drawRect(panel, &ui::rectSh, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 4), t->author.c_str());
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 4), t->author.c_str());
     drawY += 40;
 
     gfx::drawRect(panel, &ui::rectLt, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 0), d->tid);
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 0), d->tid);
     drawY += 40;
 
     gfx::drawRect(panel, &ui::rectSh, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 1), d->saveInfo.save_data_id);
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 1), d->saveInfo.save_data_id);
     drawY += 40;
 
     uint32_t hours, mins;
     hours = ((d->playStats.playtime / 1e+9) / 60) / 60;
     mins = ((d->playStats.playtime / 1e+9) / 60) - (hours * 60);
     gfx::drawRect(panel, &ui::rectLt, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 2), hours, mins);
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 2), hours, mins);
     drawY += 40;
 
     gfx::drawRect(panel, &ui::rectSh, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 3), d->playStats.total_launches);
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 3), d->playStats.total_launches);
     drawY += 40;
 
     gfx::drawRect(panel, &ui::rectLt, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 5), ui::getUICString("saveDataTypeText", d->saveInfo.save_data_type));
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 5), ui::getUICString(ui::str::saveDataTypeText, d->saveInfo.save_data_type));
     drawY += 40;
 
     uint8_t saveType = d->saveInfo.save_data_type;
     if(saveType == FsSaveDataType_Cache)
     {
         gfx::drawRect(panel, &ui::rectSh, 10, drawY, rectWidth, 38);
-        gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 6), d->saveInfo.save_data_index);
+        gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 6), d->saveInfo.save_data_index);
         drawY += 40;
     }
 
     gfx::drawRect(panel, saveType == FsSaveDataType_Cache ? &ui::rectLt : &ui::rectSh, 10, drawY, rectWidth, 38);
-    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString("infoStatus", 7), data::getCurrentUser()->getUsername().c_str());
+    gfx::drawTextf(panel, 18, 20, drawY + 10, &ui::txtCont, ui::getUICString(ui::str::infoStatus, 7), data::getCurrentUser()->getUsername().c_str());
 }
 
 static void infoPanelCallback(void *a)
@@ -337,7 +425,7 @@ static void infoPanelCallback(void *a)
 
 void ui::ttlInit()
 {
-    ttlHelpX = 1220 - gfx::getTextWidth(ui::getUICString("helpTitle", 0), 18);
+    ttlHelpX = 1220 - gfx::getTextWidth(ui::getUICString(ui::str::helpTitle, 0), 18);
 
     for(data::user& u : data::users)
         ttlViews.emplace_back(new ui::titleview(u, 128, 128, 16, 16, 7, ttlViewCallback));
@@ -354,8 +442,8 @@ void ui::ttlInit()
     infoPanel->setCallback(infoPanelCallback, NULL);
 
     ttlOpts->setActive(false);
-    for(int i = 0; i < 9; i++)
-        ttlOpts->addOpt(NULL, ui::getUIString("titleOptions", i));
+    for(int i = 0; i < 10; i++)
+        ttlOpts->addOpt(NULL, ui::getUIString(ui::str::titleOptions, i));
 
     //Information
     ttlOpts->optAddButtonEvent(0, HidNpadButton_A, ttlOptsShowInfoPanel, NULL);
@@ -375,6 +463,8 @@ void ui::ttlInit()
     ttlOpts->optAddButtonEvent(7, HidNpadButton_A, ttlOptsExtendSaveData, NULL);
     //Export NACP
     ttlOpts->optAddButtonEvent(8, HidNpadButton_A, ttlOptsExportSVI, NULL);
+    //Delete remote backups
+    ttlOpts->optAddButtonEvent(9, HidNpadButton_A, ttlOptsDeleteRemoteBackups, NULL);
 }
 
 void ui::ttlExit()
@@ -410,5 +500,5 @@ void ui::ttlDraw(SDL_Texture *target)
     ttlViews[curUserIndex]->draw(target);
     mutexUnlock(&ttlViewLock);
     if(ui::mstate == TTL_SEL && !fldPanel->isOpen())
-        gfx::drawTextf(NULL, 18, ttlHelpX, 673, &ui::txtCont, ui::getUICString("helpTitle", 0));
+        gfx::drawTextf(NULL, 18, ttlHelpX, 673, &ui::txtCont, ui::getUICString(ui::str::helpTitle, 0));
 }
@@ -1,11 +1,31 @@
+#include <algorithm>
+
 #include "ui.h"
 #include "ui/ttlview.h"
 #include "cfg.h"
+#include "titlecache.h"
+
+void ui::titleTile::assign(unsigned _w, unsigned _h, bool _fav, uint64_t _tid)
+{
+    if(_tid != tid || _w != w || _h != h)
+    {
+        wS = _w;
+        hS = _h;
+    }
+    w = _w;
+    h = _h;
+    fav = _fav;
+    tid = _tid;
+}
 
 //Todo make less hardcoded
 void ui::titleTile::draw(SDL_Texture *target, int x, int y, bool sel)
 {
     unsigned xScale = w * 1.28, yScale = h * 1.28;
+    //Still zooming in or out
+    if((sel && (wS < xScale || hS < yScale)) || (!sel && (wS > w || hS > h)))
+        ui::markDirty();
+
     if(sel)
     {
         if(wS < xScale)
@@ -23,7 +43,16 @@ void ui::titleTile::draw(SDL_Texture *target, int x, int y, bool sel)
 
     int dX = x - ((wS - w) / 2);
     int dY = y - ((hS - h) / 2);
-    gfx::texDrawStretch(target, icon, dX, dY, wS, hS);
+    //Icons are decoded in the background and can be freed when off screen, so this isn't kept
+    SDL_Texture *icon = data::getTitleIconByTID(tid);
+    if(!icon)
+    {
+        //Bumps it up the decode queue while it's on screen
+        data::titleIconRequest(tid);
+        gfx::drawRect(target, &ui::rectLt, dX, dY, wS, hS);
+    }
+    else
+        gfx::texDrawStretch(target, icon, dX, dY, wS, hS);
     if(fav)
         gfx::drawTextf(target, 20, dX + 8, dY + 8, &ui::heartColor, "♥");
 }
@@ -38,25 +67,42 @@ ui::titleview::titleview(const data::user& _u, int _iconW, int _iconH, int _horG
     callback = _callback;
     u = &_u;
 
-    for(const data::userTitleInfo& t : u->titleInfo)
-        tiles.emplace_back(new ui::titleTile(_iconW, _iconH, cfg::isFavorite(t.tid), data::getTitleIconByTID(t.tid)));
+    refresh();
 }
 
-ui::titleview::~titleview()
+void ui::titleview::refresh()
 {
-    for(ui::titleTile *t : tiles)
-        delete t;
+    //Tiles only hold size and zoom. Icons are looked up by title ID when drawn, so nothing is reloaded here
+    tiles.resize(u->titleInfo.size());
+    for(unsigned i = 0; i < tiles.size(); i++)
+    {
+        uint64_t tid = u->titleInfo[i]->tid;
+        tiles[i].assign(iconW, iconH, cfg::isFavorite(tid), tid);
+    }
+
+    if(selected > (int)tiles.size() - 1 && selected > 0)
+        selected = tiles.size() - 1;
 }
 
-void ui::titleview::refresh()
+void ui::titleview::insertTile(unsigned _pos, uint64_t _tid)
 {
-    for(ui::titleTile *t : tiles)
-        delete t;
+    if(_pos > tiles.size())
+        return;
 
-    tiles.clear();
-    for(const data::userTitleInfo& t : u->titleInfo)
-        tiles.emplace_back(new ui::titleTile(iconW, iconH, cfg::isFavorite(t.tid), data::getTitleIconByTID(t.tid)));
+    tiles.insert(tiles.begin() + _pos, ui::titleTile(iconW, iconH, cfg::isFavorite(_tid), _tid));
+    //Stay on the same title
+    if((int)_pos <= selected && tiles.size() > 1)
+        ++selected;
+}
 
+void ui::titleview::eraseTile(unsigned _pos)
+{
+    if(_pos >= tiles.size())
+        return;
+
+    tiles.erase(tiles.begin() + _pos);
+    if((int)_pos < selected)
+        --selected;
     if(selected > (int)tiles.size() - 1 && selected > 0)
         selected = tiles.size() - 1;
 }
@@ -126,53 +172,39 @@ void ui::titleview::draw(SDL_Texture *target)
     {
         float add = ((float)tY - (float)selRectY) / ui::animScale;
         y += ceil(add);
+        ui::markDirty();
     }
     else if(selRectY < 38)
     {
         float add = (38.0f - (float)selRectY) / ui::animScale;
         y += ceil(add);
+        ui::markDirty();
     }
 
-    if(clrAdd)
-    {
-        clrShft += 6;
-        if(clrShft >= 0x72)
-            clrAdd = false;
-    }
-    else
-    {
-        clrShft -= 3;
-        if(clrShft <= 0)
-            clrAdd = true;
-    }
+    //Selected is drawn last so it's over top. Its position is needed for scrolling even if it's off screen
+    int rowH = iconH + vertGap, colW = iconW + horGap;
+    int selX = x + (selected % rowCount) * colW, selY = y + (selected / rowCount) * rowH;
+    selRectX = selX - 24;
+    selRectY = selY - 24;
 
-    int totalTitles = tiles.size(), selX = 32, selY = 64;
-    for(int tY = y, i = 0; i < totalTitles; tY += iconH + vertGap)
+    //Only rows that can be seen. Zoomed tiles reach a little past their row
+    int totalTitles = tiles.size(), rowTotal = (totalTitles + rowCount - 1) / rowCount;
+    int firstRow = std::max(0, (-y - iconH) / rowH), lastRow = std::min(rowTotal - 1, (tH - y) / rowH);
+    for(int row = firstRow; row <= lastRow; row++)
     {
-        int endRow = i + rowCount;
-        for(int tX = x; i < endRow; tX += iconW + horGap, i++)
+        int tY = y + row * rowH;
+        for(int i = row * rowCount, tX = x; i < std::min(totalTitles, (row + 1) * rowCount); i++, tX += colW)
         {
-            if(i >= totalTitles)
-                break;
-
-            if(i == selected)
-            {
-                //save x and y for later so it's draw over top
-                selX = tX;
-                selY = tY;
-                selRectX = tX - 24;
-                selRectY = tY - 24;
-            }
-            else
-                tiles[i]->draw(target, tX, tY, false);
+            if(i != selected)
+                tiles[i].draw(target, tX, tY, false);
         }
     }
 
     if(showSel)
     {
-        ui::drawBoundBox(target, selRectX, selRectY, 176, 176, clrShft);
-        tiles[selected]->draw(target, selX, selY, true);
+        ui::drawBoundBox(target, selRectX, selRectY, 176, 176);
+        tiles[selected].draw(target, selX, selY, true);
     }
     else
-        tiles[selected]->draw(target, selX, selY, false);
+        tiles[selected].draw(target, selX, selY, false);
 }
@@ -1,5 +1,5 @@
 #include <string>
-#include <map>
+#include <unordered_map>
 
 #include "file.h"
 #include "cfg.h"
@@ -7,26 +7,71 @@
 #include "util.h"
 #include "uistr.h"
 
-std::map<std::pair<std::string, int>, std::string> ui::strings;
+std::string ui::strings[ui::strLayout.base[ui::str::UI_STRING_COUNT]];
 
-static void addUIString(const std::string& _name, int ind, const std::string& _str)
+#define UI_STRING_NAME(name, count) #name,
+static const char *strNames[ui::str::UI_STRING_COUNT] = { UI_STRING_LIST(UI_STRING_NAME) };
+#undef UI_STRING_NAME
+
+static inline std::string& uiString(ui::str::id _id, int ind)
+{
+    return ui::strings[ui::strLayout.base[_id] + ind];
+}
+
+static void addUIString(ui::str::id _id, int ind, const std::string& _str)
+{
+    uiString(_id, ind) = _str;
+}
+
+//Only used while loading. Leftover entries in older translations are skipped
+static bool getStringID(const std::string& _name, ui::str::id& _id)
 {
-    ui::strings[std::make_pair(_name, ind)] = _str;
+    static std::unordered_map<std::string, unsigned> nameIDs;
+    if(nameIDs.empty())
+    {
+        for(unsigned i = 0; i < ui::str::UI_STRING_COUNT; i++)
+            nameIDs[strNames[i]] = i;
+    }
+
+    auto find = nameIDs.find(_name);
+    if(find == nameIDs.end())
+        return false;
+
+    _id = (ui::str::id)find->second;
+    return true;
 }
 
-static void loadTranslationFile(const std::string& path)
+//_cache keeps a compiled copy of path for the next launch
+static void loadTranslationFile(const std::string& path, bool _cache)
 {
-    if(fs::fileExists(path))
+    fs::dataBlob lang(path, _cache);
+    if(lang.isOpen())
     {
-        fs::dataFile lang(path);
-        while(lang.readNextLine(true))
+        while(lang.readNextLine())
         {
+            ui::str::id id;
             std::string name = lang.getName();
             int ind = lang.getNextValueInt();
             std::string str = lang.getNextValueStr();
-            addUIString(name, ind, str);
+            if(getStringID(name, id) && ind >= 0 && (unsigned)ind < ui::strLayout.base[id + 1] - ui::strLayout.base[id])
+                addUIString(id, ind, str);
+        }
+    }
+}
+
+static void writeTranslationFile(const std::string& path)
+{
+    FILE *out = fopen(path.c_str(), "w");
+    for(unsigned i = 0; i < ui::str::UI_STRING_COUNT; i++)
+    {
+        for(unsigned j = 0; j < ui::strLayout.base[i + 1] - ui::strLayout.base[i]; j++)
+        {
+            std::string stringOut = uiString((ui::str::id)i, j);
+            util::replaceStr(stringOut, "\n", "\\n");
+            fprintf(out, "%s = %u, \"%s\"\n", strNames[i], j, stringOut.c_str());
         }
     }
+    fclose(out);
 }
 
 static std::string getFilename(int lang)
@@ -105,220 +150,242 @@ static std::string getFilename(int lang)
 
 void ui::initStrings()
 {
-    addUIString("author", 0, "NULL");
-    addUIString("helpUser", 0, "[A] Select   [Y] Dump All Saves   [X] User Options");
-    addUIString("helpTitle", 0, "[A] Select   [L][R] Jump   [Y] Favorite   [X] Title Options  [B] Back");
-    addUIString("helpFolder", 0, "[A] Select  [Y] Restore  [X] Delete   [ZR] Upload  [B] Close");
-    addUIString("helpSettings", 0, "[A] Toggle   [X] Defaults   [B] Back");
+    addUIString(ui::str::author, 0, "NULL");
+    addUIString(ui::str::helpUser, 0, "[A] Select   [Y] Dump All Saves   [X] User Options");
+    addUIString(ui::str::helpTitle, 0, "[A] Select   [L][R] Jump   [Y] Favorite   [X] Title Options  [B] Back");
+    addUIString(ui::str::helpFolder, 0, "[A] Select  [Y] Restore  [X] Delete   [ZR] Upload  [-] Pause  [ZL] Cancel Transfers  [B] Close");
+    addUIString(ui::str::helpSettings, 0, "[A] Toggle   [X] Defaults   [B] Back");
 
     //Y/N On/Off
-    addUIString("dialogYes", 0, "Yes [A]");
-    addUIString("dialogNo", 0, "No [B]");
-    addUIString("dialogOK", 0, "OK [A]");
-    addUIString("settingsOn", 0, ">On>");
-    addUIString("settingsOff", 0, "Off");
-    addUIString("holdingText", 0, "(Hold) ");
-    addUIString("holdingText", 1, "(Keep Holding) ");
-    addUIString("holdingText", 2, "(Almost There!) ");
+    addUIString(ui::str::dialogYes, 0, "Yes [A]");
+    addUIString(ui::str::dialogNo, 0, "No [B]");
+    addUIString(ui::str::dialogOK, 0, "OK [A]");
+    addUIString(ui::str::settingsOn, 0, ">On>");
+    addUIString(ui::str::settingsOff, 0, "Off");
+    addUIString(ui::str::holdingText, 0, "(Hold) ");
+    addUIString(ui::str::holdingText, 1, "(Keep Holding) ");
+    addUIString(ui::str::holdingText, 2, "(Almost There!) ");
 
     //Confirmation Strings
-    addUIString("confirmBlacklist", 0, "Are you sure you want to add #%s# to your blacklist?");
-    addUIString("confirmOverwrite", 0, "Are you sure you want to overwrite #%s#?");
-    addUIString("confirmRestore", 0, "Are you sure you want to restore #%s#?");
-    addUIString("confirmDelete", 0, "Are you sure you want to delete #%s#? *This is permanent*!");
-    addUIString("confirmCopy", 0, "Are you sure you want to copy #%s# to #%s#?");
-    addUIString("confirmDeleteSaveData", 0, "*WARNING*: This *will* erase the save data for #%s# *from your system*. Are you sure you want to do this?");
-    addUIString("confirmResetSaveData", 0, "*WARNING*: This *will* reset the save data for this game as if it was never ran before. Are you sure you want to do this?");
-    addUIString("confirmCreateAllSaveData", 0, "Are you sure you would like to create all save data on this system for #%s#? This can take a while depending on how many titles are found.");
-    addUIString("confirmDeleteBackupsTitle", 0, "Are you sure you would like to delete all save backups for #%s#?");
-    addUIString("confirmDeleteBackupsAll", 0, "Are you sure you would like to delete *all* of your save backups for all of your games?");
-    addUIString("confirmDriveOverwrite", 0, "Downloading this backup from drive will overwrite the one on your SD card. Continue?");
+    addUIString(ui::str::confirmBlacklist, 0, "Are you sure you want to add #%s# to your blacklist?");
+    addUIString(ui::str::confirmOverwrite, 0, "Are you sure you want to overwrite #%s#?");
+    addUIString(ui::str::confirmRestore, 0, "Are you sure you want to restore #%s#?");
+    addUIString(ui::str::confirmDelete, 0, "Are you sure you want to delete #%s#? *This is permanent*!");
+    addUIString(ui::str::confirmCancelTransfers, 0, "Cancel all #%u# transfers? Zips made only for uploading are deleted.");
+    addUIString(ui::str::confirmCopy, 0, "Are you sure you want to copy #%s# to #%s#?");
+    addUIString(ui::str::confirmDeleteSaveData, 0, "*WARNING*: This *will* erase the save data for #%s# *from your system*. Are you sure you want to do this?");
+    addUIString(ui::str::confirmResetSaveData, 0, "*WARNING*: This *will* reset the save data for this game as if it was never ran before. Are you sure you want to do this?");
+    addUIString(ui::str::confirmCreateAllSaveData, 0, "Are you sure you would like to create all save data on this system for #%s#? This can take a while depending on how many titles are found.");
+    addUIString(ui::str::confirmDeleteBackupsTitle, 0, "Are you sure you would like to delete all save backups for #%s#?");
+    addUIString(ui::str::confirmDeleteBackupsAll, 0, "Are you sure you would like to delete *all* of your save backups for all of your games?");
+    addUIString(ui::str::confirmDeleteBackupsRemote, 0, "Are you sure you would like to delete all *remote* save backups for #%s#?");
+    addUIString(ui::str::confirmDriveOverwrite, 0, "Downloading this backup from drive will overwrite the one on your SD card. Continue?");
 
     //Save Data related strings
-    addUIString("saveDataNoneFound", 0, "No saves found for #%s#!");
-    addUIString("saveDataCreatedForUser", 0, "Save data created for %s!");
-    addUIString("saveDataCreationFailed", 0, "Save data creation failed!");
-    addUIString("saveDataResetSuccess", 0, "Save for #%s# reset!");
-    addUIString("saveDataDeleteSuccess", 0, "Save data for #%s# deleted!");
-    addUIString("saveDataExtendSuccess", 0, "Save data for #%s# extended!");
-    addUIString("saveDataExtendFailed", 0, "Failed to extend save data.");
-    addUIString("saveDataDeleteAllUser", 0, "*ARE YOU SURE YOU WANT TO DELETE ALL SAVE DATA FOR %s?*");
-    addUIString("saveDataBackupDeleted", 0, "#%s# has been deleted.");
-    addUIString("saveDataBackupMovedToTrash", 0, "#%s# has been moved to trash.");
-    addUIString("saveTypeMainMenu", 0, "Device");
-    addUIString("saveTypeMainMenu", 1, "BCAT");
-    addUIString("saveTypeMainMenu", 2, "Cache");
-    addUIString("saveTypeMainMenu", 3, "System");
-    addUIString("saveTypeMainMenu", 4, "System BCAT");
-    addUIString("saveTypeMainMenu", 5, "Temporary");
+    addUIString(ui::str::saveDataNoneFound, 0, "No saves found for #%s#!");
+    addUIString(ui::str::saveDataCreatedForUser, 0, "Save data created for %s!");
+    addUIString(ui::str::saveDataCreationFailed, 0, "Save data creation failed!");
+    addUIString(ui::str::saveDataResetSuccess, 0, "Save for #%s# reset!");
+    addUIString(ui::str::saveDataDeleteSuccess, 0, "Save data for #%s# deleted!");
+    addUIString(ui::str::saveDataExtendSuccess, 0, "Save data for #%s# extended!");
+    addUIString(ui::str::saveDataExtendFailed, 0, "Failed to extend save data.");
+    addUIString(ui::str::saveDataDeleteAllUser, 0, "*ARE YOU SURE YOU WANT TO DELETE ALL SAVE DATA FOR %s?*");
+    addUIString(ui::str::saveDataBackupDeleted, 0, "#%s# has been deleted.");
+    addUIString(ui::str::saveDataBackupMovedToTrash, 0, "#%s# has been moved to trash.");
+    addUIString(ui::str::saveTypeMainMenu, 0, "Device");
+    addUIString(ui::str::saveTypeMainMenu, 1, "BCAT");
+    addUIString(ui::str::saveTypeMainMenu, 2, "Cache");
+    addUIString(ui::str::saveTypeMainMenu, 3, "System");
+    addUIString(ui::str::saveTypeMainMenu, 4, "System BCAT");
+    addUIString(ui::str::saveTypeMainMenu, 5, "Temporary");
     //This is redundant. Need to merge and use one or the other...
-    addUIString("saveDataTypeText", 0, "System");
-    addUIString("saveDataTypeText", 1, "Account");
-    addUIString("saveDataTypeText", 2, "BCAT");
-    addUIString("saveDataTypeText", 3, "Device");
-    addUIString("saveDataTypeText", 4, "Temporary");
-    addUIString("saveDataTypeText", 5, "Cache");
-    addUIString("saveDataTypeText", 6, "System BCAT");
+    addUIString(ui::str::saveDataTypeText, 0, "System");
+    addUIString(ui::str::saveDataTypeText, 1, "Account");
+    addUIString(ui::str::saveDataTypeText, 2, "BCAT");
+    addUIString(ui::str::saveDataTypeText, 3, "Device");
+    addUIString(ui::str::saveDataTypeText, 4, "Temporary");
+    addUIString(ui::str::saveDataTypeText, 5, "Cache");
+    addUIString(ui::str::saveDataTypeText, 6, "System BCAT");
 
     //Internet Related
-    addUIString("onlineErrorConnecting", 0, "Error Connecting!");
-    addUIString("onlineNoUpdates", 0, "No Updates Available.");
+    addUIString(ui::str::onlineErrorConnecting, 0, "Error Connecting!");
+    addUIString(ui::str::onlineNoUpdates, 0, "No Updates Available.");
 
     //File mode menu strings
-    addUIString("fileModeMenu", 0, "Copy To ");
-    addUIString("fileModeMenu", 1, "Delete");
-    addUIString("fileModeMenu", 2, "Rename");
-    addUIString("fileModeMenu", 3, "Make Dir");
-    addUIString("fileModeMenu", 4, "Properties");
-    addUIString("fileModeMenu", 5, "Close");
-    addUIString("fileModeMenu", 6, "Add to Path Filters");
-    addUIString("fileModeMenuMkDir", 0, "New");
+    addUIString(ui::str::fileModeMenu, 0, "Copy To ");
+    addUIString(ui::str::fileModeMenu, 1, "Delete");
+    addUIString(ui::str::fileModeMenu, 2, "Rename");
+    addUIString(ui::str::fileModeMenu, 3, "Make Dir");
+    addUIString(ui::str::fileModeMenu, 4, "Properties");
+    addUIString(ui::str::fileModeMenu, 5, "Close");
+    addUIString(ui::str::fileModeMenu, 6, "Add to Path Filters");
+    addUIString(ui::str::fileModeMenuMkDir, 0, "New");
 
     //New folder pop menu strings
-    addUIString("folderMenuNew", 0, "New Backup");
+    addUIString(ui::str::folderMenuNew, 0, "New Backup");
 
     //File mode properties string
-    addUIString("fileModeFileProperties", 0, "Path: %s\nSize: %s");
-    addUIString("fileModeFolderProperties", 0, "Path: %s\nSub Folders: %u\nFile Count: %u\nTotal Size: %s");
+    addUIString(ui::str::fileModeFileProperties, 0, "Path: %s\nSize: %s");
+    addUIString(ui::str::fileModeFolderProperties, 0, "Path: %s\nSub Folders: %u\nFile Count: %u\nTotal Size: %s");
 
     //Settings menu
-    addUIString("settingsMenu", 0, "Empty Trash Bin");
-    addUIString("settingsMenu", 1, "Check for Updates");
-    addUIString("settingsMenu", 2, "Set JKSV Save Output Folder");
-    addUIString("settingsMenu", 3, "Edit Blacklisted Titles");
-    addUIString("settingsMenu", 4, "Delete All Save Backups");
-    addUIString("settingsMenu", 5, "Include Device Saves With Users: ");
-    addUIString("settingsMenu", 6, "Auto Backup On Restore: ");
-    addUIString("settingsMenu", 7, "Auto-Name Backups: ");
-    addUIString("settingsMenu", 8, "Overclock/CPU Boost: ");
-    addUIString("settingsMenu", 9, "Hold To Delete: ");
-    addUIString("settingsMenu", 10, "Hold To Restore: ");
-    addUIString("settingsMenu", 11, "Hold To Overwrite: ");
-    addUIString("settingsMenu", 12, "Force Mount: ");
-    addUIString("settingsMenu", 13, "Account System Saves: ");
-    addUIString("settingsMenu", 14, "Enable Writing to System Saves: ");
-    addUIString("settingsMenu", 15, "Use FS Commands Directly: ");
-    addUIString("settingsMenu", 16, "Export Saves to ZIP: ");
-    addUIString("settingsMenu", 17, "Force English To Be Used: ");
-    addUIString("settingsMenu", 18, "Enable Trash Bin: ");
-    addUIString("settingsMenu", 19, "Title Sorting Type: ");
-    addUIString("settingsMenu", 20, "Animation Scale: ");
-    addUIString("settingsMenu", 21, "Auto-upload to Drive/Webdav: ");
+    addUIString(ui::str::settingsMenu, 0, "Empty Trash Bin");
+    addUIString(ui::str::settingsMenu, 1, "Check for Updates");
+    addUIString(ui::str::settingsMenu, 2, "Set JKSV Save Output Folder");
+    addUIString(ui::str::settingsMenu, 3, "Edit Blacklisted Titles");
+    addUIString(ui::str::settingsMenu, 4, "Delete All Save Backups");
+    addUIString(ui::str::settingsMenu, 5, "Include Device Saves With Users: ");
+    addUIString(ui::str::settingsMenu, 6, "Auto Backup On Restore: ");
+    addUIString(ui::str::settingsMenu, 7, "Auto-Name Backups: ");
+    addUIString(ui::str::settingsMenu, 8, "Overclock/CPU Boost: ");
+    addUIString(ui::str::settingsMenu, 9, "Hold To Delete: ");
+    addUIString(ui::str::settingsMenu, 10, "Hold To Restore: ");
+    addUIString(ui::str::settingsMenu, 11, "Hold To Overwrite: ");
+    addUIString(ui::str::settingsMenu, 12, "Force Mount: ");
+    addUIString(ui::str::settingsMenu, 13, "Account System Saves: ");
+    addUIString(ui::str::settingsMenu, 14, "Enable Writing to System Saves: ");
+    addUIString(ui::str::settingsMenu, 15, "Use FS Commands Directly: ");
+    addUIString(ui::str::settingsMenu, 16, "Export Saves to ZIP: ");
+    addUIString(ui::str::settingsMenu, 17, "Force English To Be Used: ");
+    addUIString(ui::str::settingsMenu, 18, "Enable Trash Bin: ");
+    addUIString(ui::str::settingsMenu, 19, "Title Sorting Type: ");
+    addUIString(ui::str::settingsMenu, 20, "Animation Scale: ");
+    addUIString(ui::str::settingsMenu, 21, "Auto-upload to Drive/Webdav: ");
 
     //Main menu
-    addUIString("mainMenuSettings", 0, "Settings");
-    addUIString("mainMenuExtras", 0, "Extras");
+    addUIString(ui::str::mainMenuSettings, 0, "Settings");
+    addUIString(ui::str::mainMenuExtras, 0, "Extras");
 
     // Translator in main page
-    addUIString("translationMainPage", 0, "Translation: ");
+    addUIString(ui::str::translationMainPage, 0, "Translation: ");
 
     //Loading page
-    addUIString("loadingStartPage", 0, "Loading...");
+    addUIString(ui::str::loadingStartPage, 0, "Loading...");
 
     //Sort Strings for ^
-    addUIString("sortType", 0, "Alphabetical");
-    addUIString("sortType", 1, "Time Played");
-    addUIString("sortType", 2, "Last Played");
+    addUIString(ui::str::sortType, 0, "Alphabetical");
+    addUIString(ui::str::sortType, 1, "Time Played");
+    addUIString(ui::str::sortType, 2, "Last Played");
 
     //Extras
-    addUIString("extrasMenu", 0, "SD to SD Browser");
-    addUIString("extrasMenu", 1, "BIS: ProdInfoF");
-    addUIString("extrasMenu", 2, "BIS: Safe");
-    addUIString("extrasMenu", 3, "BIS: System");
-    addUIString("extrasMenu", 4, "BIS: User");
-    addUIString("extrasMenu", 5, "Remove Pending Update");
-    addUIString("extrasMenu", 6, "Terminate Process");
-    addUIString("extrasMenu", 7, "Mount System Save");
-    addUIString("extrasMenu", 8, "Rescan Titles");
-    addUIString("extrasMenu", 9, "Mount Process RomFS");
-    addUIString("extrasMenu", 10, "Backup JKSV Folder");
-    addUIString("extrasMenu", 11, "*[DEV]* Output en-US");
+    addUIString(ui::str::extrasMenu, 0, "SD to SD Browser");
+    addUIString(ui::str::extrasMenu, 1, "BIS: ProdInfoF");
+    addUIString(ui::str::extrasMenu, 2, "BIS: Safe");
+    addUIString(ui::str::extrasMenu, 3, "BIS: System");
+    addUIString(ui::str::extrasMenu, 4, "BIS: User");
+    addUIString(ui::str::extrasMenu, 5, "Remove Pending Update");
+    addUIString(ui::str::extrasMenu, 6, "Terminate Process");
+    addUIString(ui::str::extrasMenu, 7, "Mount System Save");
+    addUIString(ui::str::extrasMenu, 8, "Rescan Titles");
+    addUIString(ui::str::extrasMenu, 9, "Mount Process RomFS");
+    addUIString(ui::str::extrasMenu, 10, "Backup JKSV Folder");
+    addUIString(ui::str::extrasMenu, 11, "*[DEV]* Output en-US");
+    addUIString(ui::str::extrasMenu, 12, "*[DEV]* Benchmark Remote");
 
     //User Options
-    addUIString("userOptions", 0, "Dump All For ");
-    addUIString("userOptions", 1, "Create Save Data");
-    addUIString("userOptions", 2, "Create All Save Data");
-    addUIString("userOptions", 3, "Delete All User Saves");
+    addUIString(ui::str::userOptions, 0, "Dump All For ");
+    addUIString(ui::str::userOptions, 1, "Create Save Data");
+    addUIString(ui::str::userOptions, 2, "Create All Save Data");
+    addUIString(ui::str::userOptions, 3, "Delete All User Saves");
 
     //Title Options
-    addUIString("titleOptions", 0, "Information");
-    addUIString("titleOptions", 1, "Blacklist");
-    addUIString("titleOptions", 2, "Change Output Folder");
-    addUIString("titleOptions", 3, "Open in File Mode");
-    addUIString("titleOptions", 4, "Delete All Save Backups");
-    addUIString("titleOptions", 5, "Reset Save Data");
-    addUIString("titleOptions", 6, "Delete Save Data");
-    addUIString("titleOptions", 7, "Extend Save Data");
-    addUIString("titleOptions", 8, "Export SVI");
+    addUIString(ui::str::titleOptions, 0, "Information");
+    addUIString(ui::str::titleOptions, 1, "Blacklist");
+    addUIString(ui::str::titleOptions, 2, "Change Output Folder");
+    addUIString(ui::str::titleOptions, 3, "Open in File Mode");
+    addUIString(ui::str::titleOptions, 4, "Delete All Save Backups");
+    addUIString(ui::str::titleOptions, 5, "Reset Save Data");
+    addUIString(ui::str::titleOptions, 6, "Delete Save Data");
+    addUIString(ui::str::titleOptions, 7, "Extend Save Data");
+    addUIString(ui::str::titleOptions, 8, "Export SVI");
+    addUIString(ui::str::titleOptions, 9, "Delete Remote Backups");
 
     //Thread Status Strings
-    addUIString("threadStatusCreatingSaveData", 0, "Creating save data for #%s#...");
-    addUIString("threadStatusCopyingFile", 0, "Copying '#%s#'...");
-    addUIString("threadStatusDeletingFile", 0, "Deleting...");
-    addUIString("threadStatusOpeningFolder", 0, "Opening '#%s#'...");
-    addUIString("threadStatusAddingFileToZip", 0, "Adding '#%s#' to ZIP...");
-    addUIString("threadStatusDecompressingFile", 0, "Decompressing '#%s#'...");
-    addUIString("threadStatusDeletingSaveData", 0, "Deleting Save Data for #%s#...");
-    addUIString("threadStatusExtendingSaveData", 0, "Extending Save Data for #%s#...");
-    addUIString("threadStatusCreatingSaveData", 0, "Creating Save Data for #%s#...");
-    addUIString("threadStatusResettingSaveData", 0, "Resetting save data...");
-    addUIString("threadStatusDeletingUpdate", 0, "Deleting pending update...");
-    addUIString("threadStatusCheckingForUpdate", 0, "Checking for updates...");
-    addUIString("threadStatusDownloadingUpdate", 0, "Downloading update...");
-    addUIString("threadStatusGetDirProps", 0, "Getting Folder Properties...");
-    addUIString("threadStatusPackingJKSV", 0, "Writing JKSV folder contents to ZIP...");
-    addUIString("threadStatusSavingTranslations", 0, "Saving the file master...");
-    addUIString("threadStatusCalculatingSaveSize", 0, "Calculating save data size...");
-    addUIString("threadStatusUploadingFile", 0, "Uploading #%s#...");
-    addUIString("threadStatusDownloadingFile", 0, "Downloading #%s#...");
-    addUIString("threadStatusCompressingSaveForUpload", 0, "Compressing #%s# for upload...");
+    addUIString(ui::str::threadStatusCreatingSaveData, 0, "Creating save data for #%s#...");
+    addUIString(ui::str::threadStatusCopyingFile, 0, "Copying '#%s#'...");
+    addUIString(ui::str::threadStatusDeletingFile, 0, "Deleting...");
+    addUIString(ui::str::threadStatusOpeningFolder, 0, "Opening '#%s#'...");
+    addUIString(ui::str::threadStatusAddingFileToZip, 0, "Adding '#%s#' to ZIP...");
+    addUIString(ui::str::threadStatusDecompressingFile, 0, "Decompressing '#%s#'...");
+    addUIString(ui::str::threadStatusDeletingSaveData, 0, "Deleting Save Data for #%s#...");
+    addUIString(ui::str::threadStatusExtendingSaveData, 0, "Extending Save Data for #%s#...");
+    addUIString(ui::str::threadStatusCreatingSaveData, 0, "Creating Save Data for #%s#...");
+    addUIString(ui::str::threadStatusResettingSaveData, 0, "Resetting save data...");
+    addUIString(ui::str::threadStatusDeletingUpdate, 0, "Deleting pending update...");
+    addUIString(ui::str::threadStatusCheckingForUpdate, 0, "Checking for updates...");
+    addUIString(ui::str::threadStatusDownloadingUpdate, 0, "Downloading update...");
+    addUIString(ui::str::threadStatusGetDirProps, 0, "Getting Folder Properties...");
+    addUIString(ui::str::threadStatusPackingJKSV, 0, "Writing JKSV folder contents to ZIP...");
+    addUIString(ui::str::threadStatusSavingTranslations, 0, "Saving the file master...");
+    addUIString(ui::str::threadStatusCalculatingSaveSize, 0, "Calculating save data size...");
+    addUIString(ui::str::threadStatusUploadingFile, 0, "Uploading #%s#...");
+    addUIString(ui::str::threadStatusDownloadingFile, 0, "Downloading #%s#...");
+    addUIString(ui::str::threadStatusCompressingSaveForUpload, 0, "Compressing #%s# for upload...");
+    addUIString(ui::str::threadStatusBenchmarking, 0, "Benchmarking remote: #%s#...");
+    addUIString(ui::str::threadStatusWaitingForUploads, 0, "Waiting for uploads to catch up... [B] Stop");
 
     //Random leftover pop-ups
-    addUIString("popCPUBoostEnabled", 0, "CPU Boost Enabled for ZIP.");
-    addUIString("popErrorCommittingFile", 0, "Error committing file to save!");
-    addUIString("popZipIsEmpty", 0, "ZIP file is empty!");
-    addUIString("popFolderIsEmpty", 0, "Folder is empty!");
-    addUIString("popSaveIsEmpty", 0, "Save data is empty!");
-    addUIString("popProcessShutdown", 0, "#%s# successfully shutdown.");
-    addUIString("popAddedToPathFilter", 0, "'#%s#' added to path filters.");
-    addUIString("popChangeOutputFolder", 0, "#%s# changed to #%s#");
-    addUIString("popChangeOutputError", 0, "#%s# contains illegal or non-ASCII characters.");
-    addUIString("popTrashEmptied", 0, "Trash emptied");
-    addUIString("popSVIExported", 0, "SVI Exported.");
-    addUIString("popDriveStarted", 0, "Google Drive started successfully.");
-    addUIString("popDriveFailed", 0, "Failed to start Google Drive.");
-    addUIString("popRemoteNotActive", 0, "Remote is not available");
-    addUIString("popWebdavStarted", 0, "Webdav started successfully.");
-    addUIString("popWebdavFailed", 0, "Failed to start Webdav.");
+    addUIString(ui::str::popCPUBoostEnabled, 0, "CPU Boost Enabled for ZIP.");
+    addUIString(ui::str::popErrorCommittingFile, 0, "Error committing file to save!");
+    addUIString(ui::str::popZipIsEmpty, 0, "ZIP file is empty!");
+    addUIString(ui::str::popFolderIsEmpty, 0, "Folder is empty!");
+    addUIString(ui::str::popSaveIsEmpty, 0, "Save data is empty!");
+    addUIString(ui::str::popProcessShutdown, 0, "#%s# successfully shutdown.");
+    addUIString(ui::str::popAddedToPathFilter, 0, "'#%s#' added to path filters.");
+    addUIString(ui::str::popChangeOutputFolder, 0, "#%s# changed to #%s#");
+    addUIString(ui::str::popChangeOutputError, 0, "#%s# contains illegal or non-ASCII characters.");
+    addUIString(ui::str::popTrashEmptied, 0, "Trash emptied");
+    addUIString(ui::str::popSVIExported, 0, "SVI Exported.");
+    addUIString(ui::str::popDriveStarted, 0, "Google Drive started successfully.");
+    addUIString(ui::str::popDriveFailed, 0, "Failed to start Google Drive.");
+    addUIString(ui::str::popRemoteNotActive, 0, "Remote is not available");
+    addUIString(ui::str::popWebdavStarted, 0, "Webdav started successfully.");
+    addUIString(ui::str::popWebdavFailed, 0, "Failed to start Webdav.");
+    addUIString(ui::str::popS3Started, 0, "S3 started successfully.");
+    addUIString(ui::str::popS3Failed, 0, "Failed to start S3.");
+    addUIString(ui::str::popLocalRemoteStarted, 0, "Local remote started successfully.");
+    addUIString(ui::str::popLocalRemoteFailed, 0, "Failed to start local remote.");
+    addUIString(ui::str::popBenchmarkFinished, 0, "Benchmark finished. Results are in the log.");
+    addUIString(ui::str::popBenchmarkFailed, 0, "Benchmark failed to start.");
+    addUIString(ui::str::popTransferQueued, 0, "#%s# queued for transfer.");
+    addUIString(ui::str::popTransferFinished, 0, "#%s# transferred.");
+    addUIString(ui::str::popTransferFailed, 0, "#%s# failed to transfer.");
+    addUIString(ui::str::popTransfersPaused, 0, "Transfers paused.");
+    addUIString(ui::str::popTransfersResumed, 0, "Transfers resumed.");
+    addUIString(ui::str::popTransfersCancelled, 0, "Transfers cancelled.");
+    addUIString(ui::str::transferStatus, 0, "Transfers: %u left, %s");
+    addUIString(ui::str::transferStatusPaused, 0, "Transfers paused: %u left, %s");
 
     //Keyboard hints
-    addUIString("swkbdEnterName", 0, "Enter a new name");
-    addUIString("swkbdSaveIndex", 0, "Enter Cache Index");
-    addUIString("swkbdSetWorkDir", 0, "Enter a new Output Path");
-    addUIString("swkbdProcessID", 0, "Enter Process ID");
-    addUIString("swkbdSysSavID", 0, "Enter System Save ID");
-    addUIString("swkbdRename", 0, "Enter a new name for item");
-    addUIString("swkbdMkDir", 0, "Enter a folder name");
-    addUIString("swkbdNewSafeTitle", 0, "Input New Output Folder");
-    addUIString("swkbdExpandSize", 0, "Enter New Size in MB");
+    addUIString(ui::str::swkbdEnterName, 0, "Enter a new name");
+    addUIString(ui::str::swkbdSaveIndex, 0, "Enter Cache Index");
+    addUIString(ui::str::swkbdSetWorkDir, 0, "Enter a new Output Path");
+    addUIString(ui::str::swkbdProcessID, 0, "Enter Process ID");
+    addUIString(ui::str::swkbdSysSavID, 0, "Enter System Save ID");
+    addUIString(ui::str::swkbdRename, 0, "Enter a new name for item");
+    addUIString(ui::str::swkbdMkDir, 0, "Enter a folder name");
+    addUIString(ui::str::swkbdNewSafeTitle, 0, "Input New Output Folder");
+    addUIString(ui::str::swkbdExpandSize, 0, "Enter New Size in MB");
 
     //Status informations
-    addUIString("infoStatus", 0, "TID: %016lX");
-    addUIString("infoStatus", 1, "SID: %016lX");
-    addUIString("infoStatus", 2, "Play Time: %02d:%02d");
-    addUIString("infoStatus", 3, "Total Launches: %u");
-    addUIString("infoStatus", 4, "Publisher: %s");
-    addUIString("infoStatus", 5, "Save Type: %s");
-    addUIString("infoStatus", 6, "Cache Index: %u");
-    addUIString("infoStatus", 7, "User: %s");
-
-    addUIString("debugStatus", 0, "User Count: ");
-    addUIString("debugStatus", 1, "Current User: ");
-    addUIString("debugStatus", 2, "Current Title: ");
-    addUIString("debugStatus", 3, "Safe Title: ");
-    addUIString("debugStatus", 4, "Sort Type: ");
-
-    addUIString("appletModeWarning", 0, "*WARNING*: You are running JKSV in applet mode. Certain functions may not work.");
+    addUIString(ui::str::infoStatus, 0, "TID: %016lX");
+    addUIString(ui::str::infoStatus, 1, "SID: %016lX");
+    addUIString(ui::str::infoStatus, 2, "Play Time: %02d:%02d");
+    addUIString(ui::str::infoStatus, 3, "Total Launches: %u");
+    addUIString(ui::str::infoStatus, 4, "Publisher: %s");
+    addUIString(ui::str::infoStatus, 5, "Save Type: %s");
+    addUIString(ui::str::infoStatus, 6, "Cache Index: %u");
+    addUIString(ui::str::infoStatus, 7, "User: %s");
+
+    addUIString(ui::str::debugStatus, 0, "User Count: ");
+    addUIString(ui::str::debugStatus, 1, "Current User: ");
+    addUIString(ui::str::debugStatus, 2, "Current Title: ");
+    addUIString(ui::str::debugStatus, 3, "Safe Title: ");
+    addUIString(ui::str::debugStatus, 4, "Sort Type: ");
+    addUIString(ui::str::debugStatus, 5, "Textures: ");
+    addUIString(ui::str::debugStatus, 6, "Textures Evicted: ");
+
+    addUIString(ui::str::appletModeWarning, 0, "*WARNING*: You are running JKSV in applet mode. Certain functions may not work.");
 }
 
 void ui::loadTrans()
@@ -326,27 +393,28 @@ void ui::loadTrans()
     std::string transTestFile = fs::getWorkDir() + "trans.txt";
     std::string translationFile = "romfs:/lang/" + getFilename(data::sysLang);
     bool transFile = fs::fileExists(transTestFile);
-    if(!transFile && (data::sysLang == SetLanguage_ENUS || data::sysLang == SetLanguage_ENGB || cfg::config["langOverride"]))
+    if(!transFile && (data::sysLang == SetLanguage_ENUS || data::sysLang == SetLanguage_ENGB || cfg::config[cfg::LANG_OVERRIDE]))
         ui::initStrings();
     else if(transFile)
-        loadTranslationFile(transTestFile);
+        loadTranslationFile(transTestFile, true);
     else
-        loadTranslationFile(translationFile);
-
-    util::replaceButtonsInString(ui::strings[std::make_pair("helpUser", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("helpTitle", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("helpFolder", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("helpSettings", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("dialogYes", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("dialogNo", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("dialogOK", 0)]);
-    util::replaceButtonsInString(ui::strings[std::make_pair("appletModeWarning", 0)]);
+        loadTranslationFile(translationFile, true);
+
+    util::replaceButtonsInString(uiString(ui::str::helpUser, 0));
+    util::replaceButtonsInString(uiString(ui::str::helpTitle, 0));
+    util::replaceButtonsInString(uiString(ui::str::helpFolder, 0));
+    util::replaceButtonsInString(uiString(ui::str::helpSettings, 0));
+    util::replaceButtonsInString(uiString(ui::str::threadStatusWaitingForUploads, 0));
+    util::replaceButtonsInString(uiString(ui::str::dialogYes, 0));
+    util::replaceButtonsInString(uiString(ui::str::dialogNo, 0));
+    util::replaceButtonsInString(uiString(ui::str::dialogOK, 0));
+    util::replaceButtonsInString(uiString(ui::str::appletModeWarning, 0));
 }
 
 void ui::saveTranslationFiles(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("infoStatus", 9));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusSavingTranslations, 0));
 
     std::string outputFolder = fs::getWorkDir() + "lang", outputPath, romfsPath;
     fs::mkDir(outputFolder);
@@ -354,14 +422,7 @@ void ui::saveTranslationFiles(void *a)
     //Save en-us first
     ui::initStrings();
     outputPath = fs::getWorkDir() + "lang/" + getFilename(SetLanguage_ENUS);
-    FILE *out = fopen(outputPath.c_str(), "w");
-    for(auto& s : ui::strings)
-    {
-        std::string stringOut = s.second;
-            util::replaceStr(stringOut, "\n", "\\n");
-            fprintf(out, "%s = %i, \"%s\"\n", s.first.first.c_str(), s.first.second, stringOut.c_str());
-    }
-    fclose(out);
+    writeTranslationFile(outputPath);
 
     romfsInit();
     for(int i = 0; i < SetLanguage_Total; i++)
@@ -374,16 +435,8 @@ void ui::saveTranslationFiles(void *a)
 
         //Init original US English strings, then load translation over it. Result will be mixed file.
         ui::initStrings();
-        loadTranslationFile(romfsPath);
-
-        out = fopen(outputPath.c_str(), "w");
-        for(auto& s : ui::strings)
-        {
-            std::string stringOut = s.second;
-            util::replaceStr(stringOut, "\n", "\\n");
-            fprintf(out, "%s = %i, \"%s\"\n", s.first.first.c_str(), s.first.second, stringOut.c_str());
-        }
-        fclose(out);
+        loadTranslationFile(romfsPath, false);
+        writeTranslationFile(outputPath);
     }
     loadTrans();
     romfsExit();
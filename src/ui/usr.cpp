@@ -12,7 +12,7 @@
 #include "usr.h"
 #include "ttl.h"
 
-static const char *settText = ui::getUICString("mainMenuSettings", 0), *extText = ui::getUICString("mainMenuExtras", 0);
+static const char *settText = ui::getUICString(ui::str::mainMenuSettings, 0), *extText = ui::getUICString(ui::str::mainMenuExtras, 0);
 
 //Main menu/Users + options, folder
 ui::menu *ui::usrMenu;
@@ -36,22 +36,7 @@ static struct
 {
     bool operator()(const uint64_t& tid1, const uint64_t& tid2)
     {
-        std::string tid1Title = data::getTitleNameByTID(tid1);
-        std::string tid2Title = data::getTitleNameByTID(tid2);
-
-        uint32_t pointA = 0, pointB = 0;
-        for(unsigned i = 0, j = 0; i < tid1Title.length(); )
-        {
-            ssize_t tid1Cnt = decode_utf8(&pointA, (const uint8_t *)&tid1Title.c_str()[i]);
-            ssize_t tid2Cnt = decode_utf8(&pointB, (const uint8_t *)&tid2Title.c_str()[j]);
-
-            pointA = tolower(pointA), pointB = tolower(pointB);
-            if(pointA != pointB)
-                return pointA < pointB;
-
-            i += tid1Cnt, j += tid2Cnt;
-        }
-        return false;
+        return data::titles[tid1].sortKey < data::titles[tid2].sortKey;
     }
 } sortCreateTIDs;
 
@@ -119,9 +104,9 @@ static void saveCreateCallback(void *a)
 static void usrOptSaveCreate(void *a)
 {
     ui::menu *m = (ui::menu *)a;
-    int devPos = m->getOptPos(ui::getUICString("saveTypeMainMenu", 0));
-    int bcatPos = m->getOptPos(ui::getUICString("saveTypeMainMenu", 1));
-    int cachePos = m->getOptPos(ui::getUICString("saveTypeMainMenu", 2));
+    int devPos = m->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 0));
+    int bcatPos = m->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 1));
+    int cachePos = m->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 2));
 
     ui::updateInput();
     int sel = m->getSelected();
@@ -164,13 +149,14 @@ static void usrOptDeleteAllUserSaves_t(void *a)
     threadInfo *t = (threadInfo *)a;
     data::user *u = data::getCurrentUser();
     int curUserIndex = data::getCurrentUserIndex();
-    int devUser = ui::usrMenu->getOptPos(ui::getUICString("saveTypeMainMenu", 0));
+    int devUser = ui::usrMenu->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 0));
 
-    for(data::userTitleInfo& tinf : u->titleInfo)
+    for(std::shared_ptr<data::userTitleInfo>& tinfPtr : u->titleInfo)
     {
+        data::userTitleInfo& tinf = *tinfPtr;
         if(tinf.saveInfo.save_data_type != FsSaveDataType_System && (tinf.saveInfo.save_data_type != FsSaveDataType_Device || curUserIndex == devUser))
         {
-            t->status->setStatus(ui::getUICString("threadStatusDeletingSaveData", 0), data::getTitleNameByTID(tinf.tid).c_str());
+            t->status->setStatus(ui::getUICString(ui::str::threadStatusDeletingSaveData, 0), data::getTitleNameByTID(tinf.tid).c_str());
             fsDeleteSaveDataFileSystemBySaveDataSpaceId(FsSaveDataSpaceId_User, tinf.saveInfo.save_data_id);
         }
     }
@@ -182,7 +168,7 @@ static void usrOptDeleteAllUserSaves_t(void *a)
 static void usrOptDeleteAllUserSaves(void *a)
 {
     data::user *u = data::getCurrentUser();
-    ui::confirmArgs *conf = ui::confirmArgsCreate(true, usrOptDeleteAllUserSaves_t, NULL, NULL, ui::getUICString("saveDataDeleteAllUser", 0), u->getUsername().c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(true, usrOptDeleteAllUserSaves_t, NULL, NULL, ui::getUICString(ui::str::saveDataDeleteAllUser, 0), u->getUsername().c_str());
     ui::confirm(conf);
 }
 
@@ -218,7 +204,7 @@ static void cacheSavePanelDraw(void *a)
 
 static void usrOptDumpAllUserSaves(void *a)
 {
-    ui::newThread(fs::dumpAllUserSaves, NULL, fs::fileDrawFunc);
+    ui::newThread(fs::dumpAllUserSaves, NULL, fs::backupDrawFunc);
 }
 
 static void createSaveData(void *a)
@@ -259,8 +245,8 @@ static void usrOptCreateAllSaves_t(void *a)
 {
     threadInfo *t = (threadInfo *)a;
     data::user *u = data::getCurrentUser();
-    int devPos = ui::usrMenu->getOptPos(ui::getUICString("saveTypeMainMenu", 0));
-    int bcatPos = ui::usrMenu->getOptPos(ui::getUICString("saveTypeMainMenu", 1));
+    int devPos = ui::usrMenu->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 0));
+    int bcatPos = ui::usrMenu->getOptPos(ui::getUICString(ui::str::saveTypeMainMenu, 1));
     int sel = ui::usrMenu->getSelected();
     if(sel < devPos)
     {
@@ -284,7 +270,7 @@ static void usrOptCreateAllSaves_t(void *a)
 static void usrOptCreateAllSaves(void *a)
 {
     data::user *u = data::getCurrentUser();
-    ui::confirmArgs *conf = ui::confirmArgsCreate(true, usrOptCreateAllSaves_t, NULL, NULL, ui::getUICString("confirmCreateAllSaveData", 0), u->getUsername().c_str());
+    ui::confirmArgs *conf = ui::confirmArgsCreate(true, usrOptCreateAllSaves_t, NULL, NULL, ui::getUICString(ui::str::confirmCreateAllSaveData, 0), u->getUsername().c_str());
     ui::confirm(conf);
 }
 
@@ -304,7 +290,7 @@ static void initSaveCreateMenus()
     //Group into vectors to match
     for(auto& t : data::titles)
     {
-        NacpStruct *nacp = &t.second.nacp;
+        data::titleNacp *nacp = &t.second.nacp;
 
         if(nacp->user_account_save_data_size > 0)
             accSids.push_back(t.first);
@@ -400,7 +386,7 @@ void ui::usrInit()
     ui::registerPanel(usrOptPanel);
 
     for(int i = 0; i < 4; i++)
-        usrOptMenu->addOpt(NULL, ui::getUIString("userOptions", i));
+        usrOptMenu->addOpt(NULL, ui::getUIString(ui::str::userOptions, i));
 
     //Dump All User Saves
     usrOptMenu->optAddButtonEvent(0, HidNpadButton_A, usrOptDumpAllUserSaves, NULL);
@@ -426,7 +412,7 @@ void ui::usrInit()
 
     initSaveCreateMenus();
 
-    usrHelpX = 1220 - gfx::getTextWidth(ui::getUICString("helpUser", 0), 18);
+    usrHelpX = 1220 - gfx::getTextWidth(ui::getUICString(ui::str::helpUser, 0), 18);
 }
 
 void ui::usrExit()
@@ -458,16 +444,16 @@ void ui::usrUpdate()
         switch(ui::padKeysDown())
         {
             case HidNpadButton_Y:
-                ui::newThread(fs::dumpAllUsersAllSaves, NULL, fs::fileDrawFunc);
+                ui::newThread(fs::dumpAllUsersAllSaves, NULL, fs::backupDrawFunc);
                 break;
 
             case HidNpadButton_X:
                 {
-                    int cachePos = usrMenu->getOptPos(ui::getUIString("saveTypeMainMenu", 2));
+                    int cachePos = usrMenu->getOptPos(ui::getUIString(ui::str::saveTypeMainMenu, 2));
                     if(usrMenu->getSelected() <= cachePos)
                     {
                         data::user *u = data::getCurrentUser();
-                        usrOptMenu->editOpt(0, NULL, ui::getUIString("userOptions", 0) + u->getUsername());
+                        usrOptMenu->editOpt(0, NULL, ui::getUIString(ui::str::userOptions, 0) + u->getUsername());
                         usrOptMenu->setActive(true);
                         usrMenu->setActive(false);
                         usrOptPanel->openPanel();
@@ -487,5 +473,5 @@ void ui::usrUpdate()
 void ui::usrDraw(SDL_Texture *target)
 {
     if(ui::mstate == USR_SEL)
-        gfx::drawTextf(NULL, 18, usrHelpX, 673, &ui::txtCont, ui::getUICString("helpUser", 0));
+        gfx::drawTextf(NULL, 18, usrHelpX, 673, &ui::txtCont, ui::getUICString(ui::str::helpUser, 0));
 }
@@ -291,7 +291,7 @@ void util::replaceButtonsInString(std::string& rep)
 SDL_Texture *util::createIconGeneric(const char *txt, int fontSize, bool clearBack)
 {
     SDL_Texture *ret = gfx::texMgr->textureCreate(256, 256);
-    SDL_SetRenderTarget(gfx::render, ret);
+    gfx::setTarget(ret);
     if(clearBack)
     {
         SDL_SetRenderDrawColor(gfx::render, ui::rectLt.r, ui::rectLt.g, ui::rectLt.b, ui::rectLt.a);
@@ -303,7 +303,7 @@ SDL_Texture *util::createIconGeneric(const char *txt, int fontSize, bool clearBa
     unsigned int x = 128 - (gfx::getTextWidth(txt, fontSize) / 2);
     unsigned int y = 128 - (fontSize / 2);
     gfx::drawTextf(ret, fontSize, x, y, &ui::txtCont, txt);
-    SDL_SetRenderTarget(gfx::render, NULL);
+    gfx::setTarget(NULL);
     SDL_SetTextureBlendMode(ret, SDL_BLENDMODE_BLEND);
     return ret;
 }
@@ -338,7 +338,7 @@ void util::sysNormal()
     clkrstOpenSession(&gpu, PcvModuleId_GPU, 3);
     clkrstOpenSession(&ram, PcvModuleId_EMC, 3);
 
-    if(cfg::config["ovrClk"])
+    if(cfg::config[cfg::OVR_CLK])
         clkrstSetClockRate(&cpu, util::CPU_SPEED_1224MHz);
     else
         clkrstSetClockRate(&cpu, util::CPU_SPEED_1020MHz);
@@ -355,11 +355,11 @@ void util::sysNormal()
 void util::checkForUpdate(void *a)
 {
     threadInfo *t = (threadInfo *)a;
-    t->status->setStatus(ui::getUICString("threadStatusCheckingForUpdate", 0));
+    t->status->setStatus(ui::getUICString(ui::str::threadStatusCheckingForUpdate, 0));
     std::string gitJson = curlFuncs::getJSONURL(NULL, "https://api.github.com/repos/J-D-K/JKSV/releases/latest");
     if(gitJson.empty())
     {
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("onlineErrorConnecting", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::onlineErrorConnecting, 0));
         t->finished = true;
         return;
     }
@@ -373,22 +373,42 @@ void util::checkForUpdate(void *a)
     //This can throw false positives as is. need to fix sometime
     if(year > BLD_YEAR || month > BLD_MON || month > BLD_DAY)
     {
-        t->status->setStatus(ui::getUICString("threadStatusDownloadingUpdate", 0));
+        t->status->setStatus(ui::getUICString(ui::str::threadStatusDownloadingUpdate, 0));
         //dunno about NSP yet...
-        json_object *assets, *asset0, *dlUrl;
+        json_object *assets, *asset0, *dlUrl, *digest = NULL;
         json_object_object_get_ex(jobj, "assets", &assets);
         asset0 = json_object_array_get_idx(assets, 0);
         json_object_object_get_ex(asset0, "browser_download_url", &dlUrl);
+        json_object_object_get_ex(asset0, "digest", &digest);
 
-        std::vector<uint8_t> jksvBuff;
+        //Streamed to a temp file and hashed on the way so a bad download never replaces the NRO
         std::string url = json_object_get_string(dlUrl);
-        curlFuncs::getBinURL(&jksvBuff, url);
-        FILE *jksvOut = fopen("sdmc:/switch/JKSV.nro", "wb");
-        fwrite(jksvBuff.data(), 1, jksvBuff.size(), jksvOut);
-        fclose(jksvOut);
+        curlFuncs::fileSink jksvOut("sdmc:/switch/JKSV.nro.tmp");
+        curlFuncs::sha256Stage jksvHash(&jksvOut);
+        bool downloaded = jksvOut.isOpen() && curlFuncs::getStreamURL(&jksvHash, url);
+
+        //Formatted "sha256:<hex>" when GitHub provides it
+        std::string digestStr = digest ? json_object_get_string(digest) : "";
+        if(downloaded && digestStr.find("sha256:") == 0 && !jksvHash.hashMatches(digestStr.substr(7)))
+        {
+            fs::logWrite("Update: SHA-256 mismatch for %s\n", url.c_str());
+            downloaded = false;
+        }
+
+        if(downloaded)
+        {
+            remove("sdmc:/switch/JKSV.nro");
+            rename("sdmc:/switch/JKSV.nro.tmp", "sdmc:/switch/JKSV.nro");
+        }
+        else
+        {
+            jksvOut.finish();
+            remove("sdmc:/switch/JKSV.nro.tmp");
+            ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::onlineErrorConnecting, 0));
+        }
     }
     else
-        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString("onlineNoUpdates", 0));
+        ui::showPopMessage(POP_FRAME_DEFAULT, ui::getUICString(ui::str::onlineNoUpdates, 0));
 
     json_object_put(jobj);
     t->finished = true;
@@ -36,7 +36,7 @@ bool rfs::WebDav::resourceExists(const std::string& id) {
     curl_easy_setopt(local_curl, CURLOPT_HTTPHEADER, headers);
     curl_easy_setopt(local_curl, CURLOPT_NOBODY, 1L); // do not include the response body
 
-    CURLcode res = curl_easy_perform(local_curl);
+    CURLcode res = curlFuncs::perform(local_curl);
 
     curl_slist_free_all(headers); // free the custom headers
 
@@ -78,7 +78,7 @@ bool rfs::WebDav::createDir(const std::string& dirName, const std::string& paren
     curl_easy_setopt(local_curl, CURLOPT_URL, fullUrl.c_str());
     curl_easy_setopt(local_curl, CURLOPT_CUSTOMREQUEST, "MKCOL");
 
-    CURLcode res = curl_easy_perform(local_curl);
+    CURLcode res = curlFuncs::perform(local_curl);
 
     if(res != CURLE_OK) {
         fs::logWrite("WebDav: directory creation failed: %s\n", curl_easy_strerror(res));
@@ -110,7 +110,7 @@ void rfs::WebDav::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *
     curl_easy_setopt(local_curl, CURLOPT_UPLOAD, 1);
 
 
-    CURLcode res = curl_easy_perform(local_curl);
+    CURLcode res = curlFuncs::perform(local_curl);
     if(res != CURLE_OK) {
         fs::logWrite("WebDav: file upload failed: %s\n", curl_easy_strerror(res));
     }
@@ -118,28 +118,20 @@ void rfs::WebDav::updateFile(const std::string& _fileID, curlFuncs::curlUpArgs *
     curl_easy_cleanup(local_curl); // Clean up the CURL handle
 }
 void rfs::WebDav::downloadFile(const std::string& _fileID, curlFuncs::curlDlArgs *_download) {
-    //Downloading is threaded because it's too slow otherwise
-    dlWriteThreadStruct dlWrite;
-    dlWrite.cfa = _download;
-
-    Thread writeThread;
-    threadCreate(&writeThread, writeThread_t, &dlWrite, NULL, 0x8000, 0x2B, 2);
-
+    //Writing is threaded because it's too slow otherwise
+    DownloadWriter writer(_download);
+    if(!writer.open())
+        return;
 
     CURL* local_curl = curl_easy_duphandle(curl);
 
     std::string fullUrl = origin + _fileID;
     curl_easy_setopt(local_curl, CURLOPT_URL, fullUrl.c_str());
-    curl_easy_setopt(local_curl, CURLOPT_WRITEFUNCTION, writeDataBufferThreaded);
-    curl_easy_setopt(local_curl, CURLOPT_WRITEDATA, &dlWrite);
-    threadStart(&writeThread);
+    curl_easy_setopt(local_curl, CURLOPT_WRITEFUNCTION, DownloadWriter::writeCallback);
+    curl_easy_setopt(local_curl, CURLOPT_WRITEDATA, &writer);
 
-    CURLcode res = curl_easy_perform(local_curl);
-
-    // Copied from gd.cpp implementation.
-    // TODO: Not sure how a thread helps if this parent waits here.
-    threadWaitForExit(&writeThread);
-    threadClose(&writeThread);
+    CURLcode res = curlFuncs::perform(local_curl);
+    writer.close();
 
     if(res != CURLE_OK) {
         fs::logWrite("WebDav: file download failed: %s\n", curl_easy_strerror(res));
@@ -154,7 +146,7 @@ void rfs::WebDav::deleteFile(const std::string& _fileID) {
     curl_easy_setopt(local_curl, CURLOPT_URL, fullUrl.c_str());
     curl_easy_setopt(local_curl, CURLOPT_CUSTOMREQUEST, "DELETE");
 
-    CURLcode res = curl_easy_perform(local_curl);
+    CURLcode res = curlFuncs::perform(local_curl);
     if(res != CURLE_OK) {
         fs::logWrite("WebDav: file deletion failed: %s\n", curl_easy_strerror(res));
     }
@@ -162,6 +154,50 @@ void rfs::WebDav::deleteFile(const std::string& _fileID) {
     curl_easy_cleanup(local_curl);
 }
 
+// COPY and MOVE only differ by method. Both are handled by the server, nothing is transferred.
+bool rfs::WebDav::copyOrMove(const char* method, const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    CURL* local_curl = curl_easy_duphandle(curl);
+
+    std::string fullUrl = origin + fileID;
+    std::string destination = "Destination: " + origin + appendResourceToParentId(newName, parentId, false);
+
+    struct curl_slist *headers = NULL;
+    headers = curl_slist_append(headers, destination.c_str());
+    headers = curl_slist_append(headers, "Overwrite: T");
+
+    curl_easy_setopt(local_curl, CURLOPT_URL, fullUrl.c_str());
+    curl_easy_setopt(local_curl, CURLOPT_CUSTOMREQUEST, method);
+    curl_easy_setopt(local_curl, CURLOPT_HTTPHEADER, headers);
+
+    CURLcode res = curlFuncs::perform(local_curl);
+
+    curl_slist_free_all(headers);
+
+    bool ret = false;
+    if(res == CURLE_OK) {
+        long response_code;
+        curl_easy_getinfo(local_curl, CURLINFO_RESPONSE_CODE, &response_code);
+        // 201 Created for a new destination, 204 No Content when it was overwritten
+        ret = response_code == 201 || response_code == 204;
+        if(!ret)
+            fs::logWrite("WebDav: %s returned %li\n", method, response_code);
+    } else {
+        fs::logWrite("WebDav: %s failed: %s\n", method, curl_easy_strerror(res));
+    }
+
+    curl_easy_cleanup(local_curl);
+
+    return ret;
+}
+
+bool rfs::WebDav::copyFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    return copyOrMove("COPY", fileID, newName, parentId);
+}
+
+bool rfs::WebDav::moveFile(const std::string& fileID, const std::string& newName, const std::string& parentId) {
+    return copyOrMove("MOVE", fileID, newName, parentId);
+}
+
 bool rfs::WebDav::dirExists(const std::string& dirName, const std::string& parentId) {
     std::string urlPath = getDirID(dirName, parentId);
     return resourceExists(urlPath);
@@ -199,7 +235,7 @@ std::vector<rfs::RfsItem> rfs::WebDav::getListWithParent(const std::string& _par
     curl_easy_setopt(local_curl, CURLOPT_WRITEFUNCTION, curlFuncs::writeDataString);
     curl_easy_setopt(local_curl, CURLOPT_WRITEDATA, &responseString);
 
-    CURLcode res = curl_easy_perform(local_curl);
+    CURLcode res = curlFuncs::perform(local_curl);
 
     if(res == CURLE_OK) {
         long response_code;
@@ -292,7 +328,7 @@ std::vector<rfs::RfsItem> rfs::WebDav::parseXMLResponse(const std::string& xml)
                 if (contentLengthElem) {
                     const char* sizeStr = contentLengthElem->GetText();
                     if (sizeStr) {
-                        item.size = std::stoi(sizeStr);
+                        item.size = strtoull(sizeStr, NULL, 10);
                     }
                 }
             }
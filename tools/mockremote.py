@@ -0,0 +1,727 @@
+#!/usr/bin/env python3
+"""Stand-in WebDAV and Google Drive v3 server for testing and benchmarking JKSV's remote code.
+
+Runs on a PC in the same network as the Switch. Point webdav.json's origin, or token_uri and
+api_origin in the Drive client secret JSON, at it and JKSV talks to it through the normal
+backend and curl, same as it would to a real server. Latency, a bandwidth cap and failures can
+be added to every HTTP request.
+
+Only what rfs::WebDav and drive::gd use is implemented:
+  WebDAV: PROPFIND (Depth 0/1), MKCOL, PUT, GET, HEAD, DELETE, COPY and MOVE. Files are stored
+          as-is under --root.
+  Drive:  /token, /tokeninfo, files list/create/get/update/delete/copy, resumable uploads and
+          /batch/drive/v3. Files are stored by ID under --drive-root with their metadata in
+          files.json next to them.
+
+    python3 tools/mockremote.py --root ./mock --drive-root ./mock-drive --port 8080 --latency-ms 80 --bandwidth-kbps 2048 --fail-percent 2
+"""
+
+import argparse
+import collections
+import email.utils
+import html
+import json
+import os
+import random
+import shutil
+import signal
+import sys
+import threading
+import time
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+CHUNK_SIZE = 0x8000
+
+MIMETYPE_FOLDER = "application/vnd.google-apps.folder"
+DRIVE_PREFIXES = ("/token", "/drive/v3/", "/upload/drive/v3/", "/batch/drive/v3")
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.requests = collections.Counter()
+        self.failed = collections.Counter()
+        self.bytesIn = 0
+        self.bytesOut = 0
+
+    def add(self, method, injectedFail):
+        with self.lock:
+            self.requests[method] += 1
+            if injectedFail:
+                self.failed[method] += 1
+            return sum(self.requests.values())
+
+    def addBytes(self, recv, sent):
+        with self.lock:
+            self.bytesIn += recv
+            self.bytesOut += sent
+
+    def report(self):
+        with self.lock:
+            total = sum(self.requests.values())
+            print("\n%u requests, %u injected failures, %u bytes in, %u bytes out" %
+                  (total, sum(self.failed.values()), self.bytesIn, self.bytesOut))
+            for method, count in sorted(self.requests.items()):
+                print("  %-9s %6u (%u failed)" % (method, count, self.failed[method]))
+
+
+class Throttle:
+    """Holds a single transfer to the bandwidth cap. 0 is unlimited"""
+
+    def __init__(self, bytesPerSec):
+        self.bytesPerSec = bytesPerSec
+        self.start = time.monotonic()
+        self.sent = 0
+
+    def wait(self, size):
+        if self.bytesPerSec <= 0:
+            return
+        self.sent += size
+        ahead = self.sent / self.bytesPerSec - (time.monotonic() - self.start)
+        if ahead > 0:
+            time.sleep(ahead)
+
+
+class DriveStore:
+    """Drive's flat ID -> file table. Metadata and sessions are shared by every handler thread"""
+
+    def __init__(self, root):
+        self.root = root
+        self.lock = threading.Lock()
+        self.metaPath = os.path.join(root, "files.json")
+        self.files = {}
+        if os.path.exists(self.metaPath):
+            with open(self.metaPath, "r", encoding="utf-8") as f:
+                self.files = json.load(f)
+        self.tokens = set()
+        self.uploads = {}
+
+    def newID(self):
+        return "mock" + os.urandom(12).hex()
+
+    def blobPath(self, fileID):
+        return os.path.join(self.root, fileID)
+
+    def save(self):
+        """Caller holds lock"""
+        temp = self.metaPath + ".mockpart"
+        with open(temp, "w", encoding="utf-8") as f:
+            json.dump(self.files, f, indent=1)
+        os.replace(temp, self.metaPath)
+
+    def issueToken(self):
+        with self.lock:
+            token = "mock-access-" + os.urandom(8).hex()
+            self.tokens.add(token)
+            return token
+
+    def tokenValid(self, token):
+        with self.lock:
+            return token in self.tokens
+
+    def resource(self, item):
+        out = {"kind": "drive#file", "id": item["id"], "name": item["name"],
+               "mimeType": item["mimeType"], "parents": item["parents"]}
+        # Drive sends int64s as strings and leaves size off of folders
+        if item["mimeType"] != MIMETYPE_FOLDER:
+            out["size"] = str(item["size"])
+        return out
+
+    def children(self, fileID):
+        """Caller holds lock"""
+        found = []
+        for item in self.files.values():
+            if fileID in item["parents"]:
+                found.append(item["id"])
+                found += self.children(item["id"])
+        return found
+
+    def call(self, method, path, query, body):
+        """Metadata requests. Shared by plain HTTP and batch parts. Returns (status, JSON or None)"""
+        parts = [p for p in path.split("/") if p]
+        # drive v3 files [id] [copy]
+        if parts[:3] != ["drive", "v3", "files"] or len(parts) > 5:
+            return 404, driveError(404, "Not found")
+        fileID = parts[3] if len(parts) > 3 else None
+        action = parts[4] if len(parts) > 4 else None
+
+        try:
+            meta = json.loads(body) if body.strip() else {}
+        except ValueError:
+            return 400, driveError(400, "Invalid JSON")
+
+        with self.lock:
+            if fileID is None and method == "GET":
+                # JKSV asks for everything in one page and filters on its side
+                return 200, {"kind": "drive#fileList", "files": [self.resource(i) for i in self.files.values()]}
+
+            if fileID is None and method == "POST":
+                if meta.get("mimeType") != MIMETYPE_FOLDER:
+                    return 400, driveError(400, "Only folders can be created without an upload")
+                return 200, self.resource(self.add(meta.get("name", "Untitled"), MIMETYPE_FOLDER, meta.get("parents", [])))
+
+            item = self.files.get(fileID)
+            if item is None:
+                return 404, driveError(404, "File not found: %s." % fileID)
+
+            if action == "copy" and method == "POST":
+                if item["mimeType"] == MIMETYPE_FOLDER:
+                    return 403, driveError(403, "Folders can't be copied")
+                copy = self.add(meta.get("name", item["name"]), item["mimeType"], meta.get("parents", item["parents"]))
+                shutil.copyfile(self.blobPath(fileID), self.blobPath(copy["id"]))
+                copy["size"] = item["size"]
+                self.save()
+                return 200, self.resource(copy)
+
+            if action is not None:
+                return 404, driveError(404, "Not found")
+
+            if method == "GET":
+                return 200, self.resource(item)
+
+            if method == "PATCH":
+                if "name" in meta:
+                    item["name"] = meta["name"]
+                remove = [p for p in query.get("removeParents", [""])[0].split(",") if p]
+                add = [p for p in query.get("addParents", [""])[0].split(",") if p]
+                item["parents"] = [p for p in item["parents"] if p not in remove] + [p for p in add if p not in item["parents"]]
+                self.save()
+                return 200, self.resource(item)
+
+            if method == "DELETE":
+                # Like Drive, everything under a folder goes with it
+                for gone in [fileID] + self.children(fileID):
+                    del self.files[gone]
+                    if os.path.exists(self.blobPath(gone)):
+                        os.remove(self.blobPath(gone))
+                self.save()
+                return 204, None
+
+        return 405, driveError(405, "Method not allowed")
+
+    def add(self, name, mimeType, parents):
+        """Caller holds lock"""
+        item = {"id": self.newID(), "name": name, "mimeType": mimeType, "parents": list(parents), "size": 0}
+        self.files[item["id"]] = item
+        if mimeType != MIMETYPE_FOLDER:
+            open(self.blobPath(item["id"]), "wb").close()
+        self.save()
+        return item
+
+    def startUpload(self, fileID, meta):
+        with self.lock:
+            if fileID is not None and fileID not in self.files:
+                return None
+            uploadID = os.urandom(8).hex()
+            self.uploads[uploadID] = {"fileId": fileID, "meta": meta}
+            return uploadID
+
+    def finishUpload(self, uploadID, temp, size):
+        """Moves a received body into place. Returns the file's resource or None"""
+        with self.lock:
+            session = self.uploads.pop(uploadID, None)
+            if session is None:
+                return None
+            fileID = session["fileId"]
+            if fileID is None:
+                meta = session["meta"]
+                item = self.add(meta.get("name", "Untitled"), meta.get("mimeType", "application/octet-stream"), meta.get("parents", []))
+            elif fileID in self.files:
+                item = self.files[fileID]
+            else:
+                return None
+            os.replace(temp, self.blobPath(item["id"]))
+            item["size"] = size
+            self.save()
+            return self.resource(item)
+
+
+def driveError(code, message):
+    return {"error": {"code": code, "message": message, "errors": [{"message": message}]}}
+
+
+class MockHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    server_version = "JKSVMockRemote/1.0"
+
+    # Set in main()
+    root = ""
+    args = None
+    stats = None
+    drive = None
+
+    # ---- Helpers ----
+
+    def log_message(self, fmt, *fmtArgs):
+        if not self.args.quiet:
+            sys.stdout.write("%s - %s\n" % (self.address_string(), fmt % fmtArgs))
+
+    def localPath(self, urlPath):
+        """Maps a request path to a path under root. None if it tries to leave it"""
+        path = urllib.parse.unquote(urllib.parse.urlsplit(urlPath).path)
+        full = os.path.realpath(os.path.join(self.root, path.lstrip("/")))
+        if full != self.root and not full.startswith(self.root + os.sep):
+            return None
+        return full
+
+    def hrefFor(self, full):
+        rel = os.path.relpath(full, self.root).replace(os.sep, "/")
+        href = "/" if rel == "." else "/" + urllib.parse.quote(rel)
+        if os.path.isdir(full) and not href.endswith("/"):
+            href += "/"
+        return href
+
+    def readBody(self):
+        length = int(self.headers.get("Content-Length", 0))
+        throttle = Throttle(self.args.bandwidth_kbps * 1024)
+        left = length
+        while left > 0:
+            chunk = self.rfile.read(min(CHUNK_SIZE, left))
+            if not chunk:
+                break
+            left -= len(chunk)
+            throttle.wait(len(chunk))
+            yield chunk
+        self.stats.addBytes(length - left, 0)
+
+    def drainBody(self):
+        for _ in self.readBody():
+            pass
+
+    def reply(self, code, body=b"", contentType="text/plain", extraHeaders=None):
+        self.send_response(code)
+        self.send_header("Content-Length", str(len(body)))
+        if body:
+            self.send_header("Content-Type", contentType)
+        for name, value in (extraHeaders or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        if body and self.command != "HEAD":
+            self.wfile.write(body)
+            self.stats.addBytes(0, len(body))
+
+    def begin(self):
+        """Applies latency and failures. Returns False if the request was failed on purpose"""
+        injectedFail = random.uniform(0, 100) < self.args.fail_percent
+        count = self.stats.add(self.command, injectedFail)
+        if self.args.latency_ms > 0:
+            time.sleep(self.args.latency_ms / 1000)
+
+        if injectedFail:
+            # Body is still read so the connection stays usable for the next request
+            self.drainBody()
+            self.log_message("request %u: injected failure", count)
+            self.reply(503, b"Injected failure\n", extraHeaders={"Connection": "close"})
+            self.close_connection = True
+            return False
+        return True
+
+    def destination(self):
+        dest = self.headers.get("Destination")
+        if not dest:
+            return None
+        return self.localPath(urllib.parse.urlsplit(dest).path)
+
+
+    # ---- Drive ----
+
+    def isDrive(self):
+        return urllib.parse.urlsplit(self.path).path.startswith(DRIVE_PREFIXES)
+
+    def replyJSON(self, code, obj, extraHeaders=None):
+        body = json.dumps(obj).encode("utf-8") if obj is not None else b""
+        self.reply(code, body, "application/json; charset=UTF-8", extraHeaders)
+
+    def readBodyBytes(self):
+        return b"".join(self.readBody())
+
+    def authorized(self):
+        auth = self.headers.get("Authorization", "")
+        if auth.startswith("Bearer ") and self.drive.tokenValid(auth[7:]):
+            return True
+        self.drainBody()
+        self.replyJSON(401, driveError(401, "Request had invalid authentication credentials."))
+        return False
+
+    def driveRequest(self):
+        if not self.begin():
+            return
+
+        split = urllib.parse.urlsplit(self.path)
+        path, query = split.path, urllib.parse.parse_qs(split.query)
+
+        if path == "/token" and self.command == "POST":
+            # Any client and grant is accepted. Refresh tokens from a real account work too
+            try:
+                req = json.loads(self.readBodyBytes() or b"{}")
+            except ValueError:
+                req = {}
+            resp = {"access_token": self.drive.issueToken(), "expires_in": 3599, "token_type": "Bearer"}
+            if req.get("grant_type") == "authorization_code":
+                resp["refresh_token"] = "mock-refresh"
+            self.replyJSON(200, resp)
+            return
+
+        if path == "/tokeninfo" and self.command == "GET":
+            self.drainBody()
+            if self.drive.tokenValid(query.get("access_token", [""])[0]):
+                self.replyJSON(200, {"expires_in": 3599})
+            else:
+                self.replyJSON(400, {"error": "invalid_token", "error_description": "Invalid Value"})
+            return
+
+        # Like Drive, the session in a resumable upload's Location is all the auth its PUT needs
+        isSessionPut = self.command == "PUT" and "upload_id" in query
+        if not isSessionPut and not self.authorized():
+            return
+
+        if path == "/batch/drive/v3" and self.command == "POST":
+            self.driveBatch()
+        elif path.startswith("/upload/drive/v3/files"):
+            self.driveUpload(path, query)
+        elif self.command == "GET" and query.get("alt", [""])[0] == "media":
+            self.drainBody()
+            fileID = path.rsplit("/", 1)[-1]
+            blob = self.drive.blobPath(fileID)
+            if path.count("/") != 4 or not os.path.isfile(blob):
+                self.replyJSON(404, driveError(404, "File not found: %s." % fileID))
+            else:
+                self.sendFile(blob)
+        else:
+            status, obj = self.drive.call(self.command, path, query, self.readBodyBytes().decode("utf-8"))
+            self.replyJSON(status, obj)
+
+    def driveUpload(self, path, query):
+        parts = [p for p in path.split("/") if p]
+        uploadID = query.get("upload_id", [None])[0]
+
+        if uploadID is None and query.get("uploadType", [""])[0] == "resumable" and \
+                (self.command == "POST" and len(parts) == 4 or self.command == "PATCH" and len(parts) == 5):
+            # Session start. Bytes come in a PUT to Location
+            body = self.readBodyBytes()
+            try:
+                meta = json.loads(body) if body.strip() else {}
+            except ValueError:
+                meta = {}
+            uploadID = self.drive.startUpload(parts[4] if len(parts) == 5 else None, meta)
+            if uploadID is None:
+                self.replyJSON(404, driveError(404, "File not found: %s." % parts[4]))
+                return
+            host = self.headers.get("Host", "%s:%u" % self.server.server_address[:2])
+            location = "http://%s/upload/drive/v3/files?uploadType=resumable&upload_id=%s" % (host, uploadID)
+            self.reply(200, extraHeaders={"Location": location})
+            return
+
+        if uploadID is None or self.command != "PUT":
+            self.drainBody()
+            self.replyJSON(400, driveError(400, "Only resumable uploads are supported"))
+            return
+
+        temp = os.path.join(self.drive.root, uploadID + ".mockpart")
+        expected = int(self.headers.get("Content-Length", 0))
+        received = 0
+        with open(temp, "wb") as out:
+            for chunk in self.readBody():
+                out.write(chunk)
+                received += len(chunk)
+
+        if received != expected:
+            os.remove(temp)
+            self.close_connection = True
+            return
+
+        resource = self.drive.finishUpload(uploadID, temp, received)
+        if resource is None:
+            os.remove(temp)
+            self.replyJSON(404, driveError(404, "Upload session not found"))
+        else:
+            self.replyJSON(200, resource)
+
+    def driveBatch(self):
+        contentType = self.headers.get("Content-Type", "")
+        body = self.readBodyBytes().decode("utf-8")
+        if "boundary=" not in contentType:
+            self.replyJSON(400, driveError(400, "Missing multipart boundary"))
+            return
+
+        delim = "--" + contentType.split("boundary=", 1)[1].split(";")[0].strip('"')
+        parts = []
+        for part in body.split(delim)[1:]:
+            if part.startswith("--"):
+                break
+            parts.append(part)
+
+        # Drive takes at most 100 calls per batch
+        if len(parts) > 100:
+            self.replyJSON(400, driveError(400, "Too many requests in batch"))
+            return
+
+        respBoundary = "batch_" + os.urandom(6).hex()
+        out = []
+        for part in parts:
+            head, _, inner = part.partition("\r\n\r\n")
+            contentID = ""
+            for line in head.split("\r\n"):
+                if line.lower().startswith("content-id:"):
+                    contentID = line.split(":", 1)[1].strip().strip("<>")
+
+            # Inner request: request line, headers, blank line, body
+            innerHead, _, innerBody = inner.partition("\r\n\r\n")
+            requestLine = innerHead.split("\r\n", 1)[0].split(" ")
+            if len(requestLine) < 2:
+                status, obj = 400, driveError(400, "Bad batch part")
+            else:
+                split = urllib.parse.urlsplit(requestLine[1])
+                status, obj = self.drive.call(requestLine[0], split.path, urllib.parse.parse_qs(split.query), innerBody)
+
+            out.append("--%s\r\n" % respBoundary)
+            out.append("Content-Type: application/http\r\n")
+            out.append("Content-ID: <response-%s>\r\n\r\n" % contentID)
+            out.append("HTTP/1.1 %u %s\r\n" % (status, self.responses.get(status, ("",))[0]))
+            if obj is not None:
+                out.append("Content-Type: application/json; charset=UTF-8\r\n\r\n")
+                out.append(json.dumps(obj) + "\r\n")
+            else:
+                out.append("\r\n")
+
+        out.append("--%s--\r\n" % respBoundary)
+        self.reply(200, "".join(out).encode("utf-8"), "multipart/mixed; boundary=" + respBoundary)
+
+    # ---- Methods ----
+
+    def do_PROPFIND(self):
+        if not self.begin():
+            return
+        self.drainBody()
+
+        full = self.localPath(self.path)
+        if full is None or not os.path.exists(full):
+            self.reply(404)
+            return
+
+        entries = [full]
+        if self.headers.get("Depth", "1") != "0" and os.path.isdir(full):
+            entries += [os.path.join(full, name) for name in sorted(os.listdir(full))]
+
+        out = ['<?xml version="1.0" encoding="utf-8"?>', '<D:multistatus xmlns:D="DAV:">']
+        for entry in entries:
+            isDir = os.path.isdir(entry)
+            st = os.stat(entry)
+            name = os.path.basename(entry.rstrip(os.sep)) if entry != self.root else ""
+            out.append("<D:response>")
+            out.append("<D:href>%s</D:href>" % html.escape(self.hrefFor(entry)))
+            out.append("<D:propstat><D:prop>")
+            out.append("<D:displayname>%s</D:displayname>" % html.escape(name))
+            out.append("<D:resourcetype>%s</D:resourcetype>" % ("<D:collection/>" if isDir else ""))
+            if not isDir:
+                out.append("<D:getcontentlength>%u</D:getcontentlength>" % st.st_size)
+            out.append("<D:getlastmodified>%s</D:getlastmodified>" % email.utils.formatdate(st.st_mtime, usegmt=True))
+            out.append("</D:prop><D:status>HTTP/1.1 200 OK</D:status></D:propstat>")
+            out.append("</D:response>")
+        out.append("</D:multistatus>")
+        self.reply(207, "\n".join(out).encode("utf-8"), 'application/xml; charset="utf-8"')
+
+    def do_MKCOL(self):
+        if not self.begin():
+            return
+        self.drainBody()
+
+        full = self.localPath(self.path)
+        if full is None:
+            self.reply(403)
+        elif os.path.exists(full):
+            self.reply(405)
+        elif not os.path.isdir(os.path.dirname(full)):
+            self.reply(409)
+        else:
+            os.mkdir(full)
+            self.reply(201)
+
+    def do_PUT(self):
+        if self.isDrive():
+            self.driveRequest()
+            return
+        if not self.begin():
+            return
+
+        full = self.localPath(self.path)
+        if full is None or os.path.isdir(full) or not os.path.isdir(os.path.dirname(full)):
+            self.drainBody()
+            self.reply(409)
+            return
+
+        # Written next to the target first so a dropped upload never leaves half a file behind
+        existed = os.path.exists(full)
+        temp = full + ".mockpart"
+        expected = int(self.headers.get("Content-Length", 0))
+        received = 0
+        with open(temp, "wb") as out:
+            for chunk in self.readBody():
+                out.write(chunk)
+                received += len(chunk)
+
+        if received != expected:
+            os.remove(temp)
+            self.close_connection = True
+            return
+
+        os.replace(temp, full)
+        self.reply(204 if existed else 201)
+
+    def do_GET(self):
+        if self.isDrive():
+            self.driveRequest()
+            return
+        if not self.begin():
+            return
+        self.drainBody()
+
+        full = self.localPath(self.path)
+        if full is None or not os.path.isfile(full):
+            self.reply(404 if full is None or not os.path.exists(full) else 405)
+            return
+        self.sendFile(full)
+
+    def sendFile(self, full):
+        size = os.path.getsize(full)
+        self.send_response(200)
+        self.send_header("Content-Type", "application/octet-stream")
+        self.send_header("Content-Length", str(size))
+        self.end_headers()
+        if self.command == "HEAD":
+            return
+
+        throttle = Throttle(self.args.bandwidth_kbps * 1024)
+        sent = 0
+        try:
+            with open(full, "rb") as f:
+                while True:
+                    chunk = f.read(CHUNK_SIZE)
+                    if not chunk:
+                        break
+                    self.wfile.write(chunk)
+                    sent += len(chunk)
+                    throttle.wait(len(chunk))
+        except (BrokenPipeError, ConnectionResetError):
+            # Client gave up, e.g. a cancelled download
+            self.close_connection = True
+        self.stats.addBytes(0, sent)
+
+    def do_HEAD(self):
+        self.do_GET()
+
+    def do_DELETE(self):
+        if self.isDrive():
+            self.driveRequest()
+            return
+        if not self.begin():
+            return
+        self.drainBody()
+
+        full = self.localPath(self.path)
+        if full is None or full == self.root:
+            self.reply(403)
+        elif not os.path.exists(full):
+            self.reply(404)
+        else:
+            if os.path.isdir(full):
+                shutil.rmtree(full)
+            else:
+                os.remove(full)
+            self.reply(204)
+
+    def copyOrMove(self, move):
+        if not self.begin():
+            return
+        self.drainBody()
+
+        src = self.localPath(self.path)
+        dst = self.destination()
+        if src is None or dst is None or src == self.root or dst == self.root:
+            self.reply(403)
+            return
+        if not os.path.exists(src):
+            self.reply(404)
+            return
+        if not os.path.isdir(os.path.dirname(dst)):
+            self.reply(409)
+            return
+
+        existed = os.path.exists(dst)
+        if existed:
+            if self.headers.get("Overwrite", "T").upper() == "F":
+                self.reply(412)
+                return
+            if os.path.isdir(dst):
+                shutil.rmtree(dst)
+            else:
+                os.remove(dst)
+
+        if move:
+            os.replace(src, dst)
+        elif os.path.isdir(src):
+            shutil.copytree(src, dst)
+        else:
+            shutil.copy2(src, dst)
+        self.reply(204 if existed else 201)
+
+    def do_POST(self):
+        if self.isDrive():
+            self.driveRequest()
+        else:
+            self.drainBody()
+            self.reply(405)
+
+    def do_PATCH(self):
+        self.do_POST()
+
+    def do_COPY(self):
+        self.copyOrMove(False)
+
+    def do_MOVE(self):
+        self.copyOrMove(True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stand-in WebDAV and Google Drive server for JKSV's remote code")
+    parser.add_argument("--root", default="mockremote", help="folder WebDAV files are stored in. Created if missing")
+    parser.add_argument("--drive-root", default="mockremote-drive", help="folder Drive files are stored in. Created if missing")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency-ms", type=int, default=0, help="added to every request")
+    parser.add_argument("--bandwidth-kbps", type=int, default=0, help="per transfer cap in KB/s. 0 is unlimited")
+    parser.add_argument("--fail-percent", type=float, default=0, help="chance for a request to get a 503")
+    parser.add_argument("--seed", type=int, help="makes failures repeatable")
+    parser.add_argument("--quiet", action="store_true", help="don't log every request")
+    args = parser.parse_args()
+
+    # Request log shows up right away when piped to a file
+    sys.stdout.reconfigure(line_buffering=True)
+    if args.seed is not None:
+        random.seed(args.seed)
+
+    os.makedirs(args.root, exist_ok=True)
+    MockHandler.root = os.path.realpath(args.root)
+    MockHandler.args = args
+    MockHandler.stats = Stats()
+    os.makedirs(args.drive_root, exist_ok=True)
+    MockHandler.drive = DriveStore(os.path.realpath(args.drive_root))
+
+    # Stats are printed on Ctrl+C and on kill
+    signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(0))
+    server = ThreadingHTTPServer((args.host, args.port), MockHandler)
+    print("Serving %s (WebDAV) and %s (Drive) on http://%s:%u (latency %ums, bandwidth %s, failures %g%%)" %
+          (MockHandler.root, MockHandler.drive.root, args.host, args.port, args.latency_ms,
+           "%uKB/s" % args.bandwidth_kbps if args.bandwidth_kbps else "unlimited", args.fail_percent))
+    try:
+        server.serve_forever()
+    except (KeyboardInterrupt, SystemExit):
+        pass
+    finally:
+        server.server_close()
+        MockHandler.stats.report()
+
+
+if __name__ == "__main__":
+    main()